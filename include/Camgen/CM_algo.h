@@ -12,6 +12,9 @@
 #ifndef CAMGEN_CM_ALGO_H_
 #define CAMGEN_CM_ALGO_H_
 
+#include <map>
+#include <fstream>
+#include <typeinfo>
 #include <Camgen/process.h>
 #include <Camgen/license_print.h>
 #include <Camgen/def_args.h>
@@ -50,6 +53,11 @@ namespace Camgen
 
 	    typedef process<model_t,N_in,N_out> process_type;
 
+	    /* Particle and vertex type definitions: */
+
+	    typedef typename get_basic_types<model_t>::particle_type particle_type;
+	    typedef typename get_basic_types<model_t>::vertex_type vertex_type;
+
 	    /* Particle phase space type definition: */
 
 	    typedef typename tree_type::phase_space_type phase_space_type;
@@ -85,7 +93,7 @@ namespace Camgen
 	    /// The amplitudes should not depend on this choice, unless there is
 	    /// a bug in Camgen, or the model violates CPT invariance.  
 
-	    CM_algorithm(std::size_t n=0):sorted_by_flavour(false),sorted_by_pdg_id(false)
+	    CM_algorithm(std::size_t n=0):sorted_by_flavour(false),sorted_by_pdg_id(false),N_shared(0)
 	    {
 		license_print::initialise();
 		if(n>=N_external)
@@ -93,7 +101,7 @@ namespace Camgen
 		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"invalid choice "<<n<<" for final particle in "<<N_in<<" -> "<<N_out<<" process--proceeding with "<<N_external-1<<endlog;
 		}
 		N_final=std::min(n,N_external-1);
-		tree_type::initialise(N_final);
+		currents.initialise(N_final);
 		reset_ordering();
 	    }
 
@@ -102,7 +110,7 @@ namespace Camgen
 	    /// psi1,...,psiN_out", and the second argument is the optional final
 	    /// current (see trivial constructor).
 
-	    CM_algorithm(const std::string& str,std::size_t n=0):sorted_by_flavour(false),sorted_by_pdg_id(false)
+	    CM_algorithm(const std::string& str,std::size_t n=0):sorted_by_flavour(false),sorted_by_pdg_id(false),N_shared(0)
 	    {
 		license_print::initialise();
 		if(n>=N_external)
@@ -110,11 +118,45 @@ namespace Camgen
 		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"invalid choice "<<n<<" for final particle in "<<N_in<<" -> "<<N_out<<" process--proceeding with "<<N_external-1<<endlog;
 		}
 		N_final=std::min(n,N_external-1);
-		tree_type::initialise(N_final);
+		currents.initialise(N_final);
 		reset_ordering();
 		process_type::add_process(processes,str);
 	    }
 
+	    /// Copy constructor.
+	    /// Copies the subprocess list and the constructed vertex trees
+	    /// without rebuilding them, and gives the copy its own off-shell
+	    /// current data. A copy can therefore be evaluated independently of
+	    /// the original, e.g. by another thread.
+
+	    CM_algorithm(const CM_algorithm<model_t,N_in,N_out>& other):currents(other.currents),trees(other.trees),processes(other.processes),sorted_by_flavour(other.sorted_by_flavour),sorted_by_pdg_id(other.sorted_by_pdg_id),ordering(other.ordering),summed_spins(other.summed_spins),summed_cols(other.summed_cols),N_final(other.N_final),N_shared(0)
+	    {
+		rebind(other);
+	    }
+
+	    /// Assignment operator.
+	    /// Copies the subprocess list and the constructed vertex trees, see
+	    /// the copy constructor.
+
+	    CM_algorithm<model_t,N_in,N_out>& operator = (const CM_algorithm<model_t,N_in,N_out>& other)
+	    {
+		if(this!=&other)
+		{
+		    currents=other.currents;
+		    trees=other.trees;
+		    processes=other.processes;
+		    sorted_by_flavour=other.sorted_by_flavour;
+		    sorted_by_pdg_id=other.sorted_by_pdg_id;
+		    ordering=other.ordering;
+		    summed_spins=other.summed_spins;
+		    summed_cols=other.summed_cols;
+		    N_final=other.N_final;
+		    N_shared=0;
+		    rebind(other);
+		}
+		return *this;
+	    }
+
 	    /// Subprocess insertion method.
 	    /// The argument should be of the form "phi1,...,phiN_in >
 	    /// psi1,...,psiN_out". If the insertion was succesful, the function
@@ -143,7 +185,7 @@ namespace Camgen
 
 		for(process_iterator it=processes.begin();it!=processes.end();++it)
 		{
-		    it->add_tree(trees);
+		    it->add_tree(trees,currents);
 		}
 	
 		/* Assign the process and tree iterators: */
@@ -278,7 +320,7 @@ namespace Camgen
 		    
 		    if(process_it!=processes.end())
 		    {
-			tree_it=process_it->insert_tree(trees,tree_it);
+			tree_it=process_it->insert_tree(trees,tree_it,currents);
 			tree_it->build();
 			tree_it->clean();
 			tree_it->set_Fermi_signs();
@@ -304,7 +346,7 @@ namespace Camgen
 		
 		if(process_it != processes.end())
 		{
-		    tree_it=process_it->insert_tree(trees,trees.end());
+		    tree_it=process_it->insert_tree(trees,trees.end(),currents);
 		    tree_it->build();
 		    tree_it->clean();
 		    tree_it->set_Fermi_signs();
@@ -380,7 +422,7 @@ namespace Camgen
 		    
 		    if(process_it!=processes.end())
 		    {
-			tree_it=process_it->insert_tree(trees,tree_it);
+			tree_it=process_it->insert_tree(trees,tree_it,currents);
 			tree_it->build();
 			tree_it->clean();
 			tree_it->set_Fermi_signs();
@@ -402,7 +444,7 @@ namespace Camgen
 		process_it=process<model_t,N_in,N_out>::insert_process_by_pdg_id(processes,process_it,pv);
 		if(process_it != processes.end())
 		{
-		    tree_it=process_it->insert_tree(trees,trees.end());
+		    tree_it=process_it->insert_tree(trees,trees.end(),currents);
 		    tree_it->build();
 		    tree_it->clean();
 		    tree_it->set_Fermi_signs();
@@ -565,7 +607,9 @@ namespace Camgen
 		    tree_it->initialise_currents();
 		    tree_it->assign_momenta();
 		    tree_it->compute_coupling_flags();
+		    currents.pack_amplitudes();
 		}
+		N_shared=0;
 	    }
 
 	    /// Constructs the vertex trees of all subprocesses.
@@ -577,14 +621,81 @@ namespace Camgen
 		    it->build();
 		    it->clean();
 		}
-		for(tree_iterator it=trees.begin();it != trees.end();++it)
+		finalise_trees();
+	    }
+
+	    /// Constructs the vertex trees of all subprocesses using a cache
+	    /// file. If the file exists and was written for the same model
+	    /// content and subprocess list, the trees are read from it,
+	    /// otherwise they are constructed and written to the file.
+
+	    void construct_trees(const std::string& filename)
+	    {
+		if(!load_trees(filename))
 		{
-		    it->set_Fermi_signs();
-		    it->initialise_currents();
-		    it->assign_momenta();
-		    it->compute_coupling_flags();
+		    construct_trees();
+		    save_trees(filename);
 		}
-		tree_it=trees.begin();
+	    }
+
+	    /// Writes the vertex trees of all subprocesses to a binary cache
+	    /// file. The file contains the particle and vertex names of the
+	    /// model and the external currents of all trees, which are checked
+	    /// upon reading. Returns false if the file could not be written.
+
+	    bool save_trees(const std::string& filename) const
+	    {
+		std::ofstream ofs(filename.c_str(),std::ios::out|std::ios::binary);
+		if(!ofs.is_open())
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"tree cache file "<<filename<<" could not be opened for writing"<<endlog;
+		    return false;
+		}
+		write_tree_cache_key(ofs);
+		std::map<const typename tree_type::vertex_type*,unsigned>vertex_indices;
+		for(unsigned i=0;i<model_wrapper<model_t>::vertices();++i)
+		{
+		    vertex_indices[model_wrapper<model_t>::get_vertex(i)]=i;
+		}
+		for(const_tree_iterator it=trees.begin();it!=trees.end();++it)
+		{
+		    it->write_topology(ofs,vertex_indices);
+		}
+		return ofs.good();
+	    }
+
+	    /// Reads the vertex trees of all subprocesses from a binary cache
+	    /// file written by save_trees. Returns false if the file does not
+	    /// exist or does not match the model and subprocess list, in which
+	    /// case the trees are left empty.
+
+	    bool load_trees(const std::string& filename)
+	    {
+		std::ifstream ifs(filename.c_str(),std::ios::in|std::ios::binary);
+		if(!ifs.is_open())
+		{
+		    return false;
+		}
+		if(!read_tree_cache_key(ifs))
+		{
+		    log(log_level::message)<<"tree cache file "<<filename<<" does not match the model or process list"<<endlog;
+		    return false;
+		}
+		for(tree_iterator it=trees.begin();it!=trees.end();++it)
+		{
+		    if(!it->read_topology(ifs))
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"invalid tree data encountered in cache file "<<filename<<endlog;
+			for(tree_iterator it2=trees.begin();it2!=trees.end();++it2)
+			{
+			    it2->clear_topology();
+			}
+			tree_it=trees.begin();
+			return false;
+		    }
+		}
+		finalise_trees();
+		return true;
 	    }
 
 	    /// Removes current process from tree.
@@ -708,6 +819,32 @@ namespace Camgen
 		return (r_value_type)0;
 	    }
 
+	    /// Evaluates the amplitudes of all subprocesses at the current
+	    /// external phase space configurations and writes them to the
+	    /// argument vector, in the order of the subprocess list. Subprocess
+	    /// trees share their off-shell currents, and a current with equal
+	    /// momentum channel, particle type and external wave functions is
+	    /// computed once for all trees in which it occurs.
+
+	    void evaluate_all(std::vector<value_type>& amps)
+	    {
+		if(N_shared!=trees.size() or process_trees.size()!=processes.size())
+		{
+		    share_currents();
+		}
+		typename std::vector<value_type>::iterator tree_amp_it=tree_amplitudes.begin();
+		for(tree_iterator it=trees.begin();it!=trees.end();++it)
+		{
+		    *tree_amp_it=it->evaluate_shared();
+		    ++tree_amp_it;
+		}
+		amps.resize(process_trees.size());
+		for(size_type i=0;i<process_trees.size();++i)
+		{
+		    amps[i]=tree_amplitudes[process_trees[i]];
+		}
+	    }
+
 	    /// Evaluates spin-summed subprocess amplitude and returns the spin-summed squared amplitude.
 
 	    r_value_type evaluate_spin_sum()
@@ -917,7 +1054,7 @@ namespace Camgen
 
 	    void refresh()
 	    {
-		current_tree_type::refresh();
+		currents.refresh();
 		for(tree_iterator it=trees.begin();it!=trees.end();++it)
 		{
 		    it->clear();
@@ -934,6 +1071,10 @@ namespace Camgen
 	    }
 
 	protected:
+
+	    /* Off-shell currents owned by this instance: */
+
+	    current_tree_type currents;
 	    
 	    /* List of subprocess trees: */
 
@@ -987,12 +1128,219 @@ namespace Camgen
 
 	    /* Final particle in current tree: */
 
-	    static std::size_t N_final;
+	    std::size_t N_final;
+
+	    /* Number of trees in the shared-current evaluation schedule: */
+
+	    size_type N_shared;
+
+	    /* Amplitudes of the trees evaluated in shared-current mode, in the
+	     * order of the tree list: */
+
+	    std::vector<value_type>tree_amplitudes;
+
+	    /* Tree list positions of the subprocesses, in the order of the
+	     * subprocess list: */
+
+	    std::vector<size_type>process_trees;
+
+	    /* Version of the tree cache file format: */
+
+	    static const unsigned tree_cache_version=2;
+
+	    /* Computes the Fermi signs, current initialisations, momentum
+	     * policies and coupling flags of the built trees: */
+
+	    void finalise_trees()
+	    {
+		for(tree_iterator it=trees.begin();it != trees.end();++it)
+		{
+		    it->set_Fermi_signs();
+		    it->initialise_currents();
+		    it->assign_momenta();
+		    it->compute_coupling_flags();
+		}
+		currents.pack_amplitudes();
+		tree_it=trees.begin();
+		N_shared=0;
+	    }
+
+	    /* Writes the data identifying the trees in a cache file: */
+
+	    void write_tree_cache_key(std::ostream& os) const
+	    {
+		binary_io::write_header(os,"camgen_process_trees",tree_cache_version);
+		binary_io::write(os,(unsigned)N_in);
+		binary_io::write(os,(unsigned)N_out);
+		binary_io::write(os,(unsigned)N_final);
+		binary_io::write_string(os,typeid(model_t).name());
+		binary_io::write(os,(unsigned)model_wrapper<model_t>::flavours());
+		for(size_type i=0;i<model_wrapper<model_t>::flavours();++i)
+		{
+		    const particle_type* phi=model_wrapper<model_t>::get_particle(i);
+		    binary_io::write_string(os,phi->get_name());
+		    binary_io::write(os,phi->get_pdg_id());
+		    binary_io::write(os,phi->get_mass());
+		    binary_io::write(os,phi->get_width());
+		}
+		binary_io::write(os,(unsigned)model_wrapper<model_t>::vertices());
+		for(size_type i=0;i<model_wrapper<model_t>::vertices();++i)
+		{
+		    const vertex_type* v=model_wrapper<model_t>::get_vertex(i);
+		    binary_io::write_string(os,v->get_name());
+		    binary_io::write_string(os,v->get_Feynman_rule());
+		    binary_io::write(os,(unsigned)v->nr_of_couplings());
+		    for(size_type j=0;j<v->nr_of_couplings();++j)
+		    {
+			binary_io::write(os,v->get_coupling(j));
+		    }
+		}
+		binary_io::write(os,(unsigned)trees.size());
+	    }
+
+	    /* Reads the data identifying the trees in a cache file and returns
+	     * whether they match this instance: */
+
+	    bool read_tree_cache_key(std::istream& is) const
+	    {
+		if(!binary_io::read_header(is,"camgen_process_trees",tree_cache_version))
+		{
+		    return false;
+		}
+		unsigned n;
+		std::string s;
+		if(!binary_io::read(is,n) or n!=N_in)
+		{
+		    return false;
+		}
+		if(!binary_io::read(is,n) or n!=N_out)
+		{
+		    return false;
+		}
+		if(!binary_io::read(is,n) or n!=N_final)
+		{
+		    return false;
+		}
+		if(!binary_io::read_string(is,s) or s!=typeid(model_t).name())
+		{
+		    return false;
+		}
+		if(!binary_io::read(is,n) or n!=model_wrapper<model_t>::flavours())
+		{
+		    return false;
+		}
+		int id;
+		r_value_type x;
+		for(size_type i=0;i<model_wrapper<model_t>::flavours();++i)
+		{
+		    const particle_type* phi=model_wrapper<model_t>::get_particle(i);
+		    if(!binary_io::read_string(is,s) or s!=phi->get_name())
+		    {
+			return false;
+		    }
+		    if(!binary_io::read(is,id) or id!=phi->get_pdg_id())
+		    {
+			return false;
+		    }
+		    if(!binary_io::read(is,x) or x!=phi->get_mass())
+		    {
+			return false;
+		    }
+		    if(!binary_io::read(is,x) or x!=phi->get_width())
+		    {
+			return false;
+		    }
+		}
+		if(!binary_io::read(is,n) or n!=model_wrapper<model_t>::vertices())
+		{
+		    return false;
+		}
+		value_type c;
+		for(size_type i=0;i<model_wrapper<model_t>::vertices();++i)
+		{
+		    const vertex_type* v=model_wrapper<model_t>::get_vertex(i);
+		    if(!binary_io::read_string(is,s) or s!=v->get_name())
+		    {
+			return false;
+		    }
+		    if(!binary_io::read_string(is,s) or s!=v->get_Feynman_rule())
+		    {
+			return false;
+		    }
+		    if(!binary_io::read(is,n) or n!=v->nr_of_couplings())
+		    {
+			return false;
+		    }
+		    for(size_type j=0;j<v->nr_of_couplings();++j)
+		    {
+			if(!binary_io::read(is,c) or c!=v->get_coupling(j))
+			{
+			    return false;
+			}
+		    }
+		}
+		return (binary_io::read(is,n) and n==trees.size());
+	    }
+
+	    /* Determines for all trees which currents are reused from trees
+	     * preceding them in the shared-current evaluation: */
+
+	    void share_currents()
+	    {
+		std::map<const typename tree_type::current_type*,typename tree_type::current_signature>producers;
+		std::map<const tree_type*,size_type>tree_positions;
+		size_type n=0;
+		for(tree_iterator it=trees.begin();it!=trees.end();++it)
+		{
+		    it->share_currents(producers);
+		    tree_positions[&(*it)]=n;
+		    ++n;
+		}
+		tree_amplitudes.assign(trees.size(),value_type(0,0));
+		process_trees.clear();
+		process_trees.reserve(processes.size());
+		for(process_iterator it=processes.begin();it!=processes.end();++it)
+		{
+		    process_trees.push_back(tree_positions[&(*(it->get_tree()))]);
+		}
+		N_shared=trees.size();
+	    }
+
+	    /* Function moving the copied trees to the current data of this
+	     * instance and re-assigning the process and tree iterators: */
+
+	    void rebind(const CM_algorithm<model_t,N_in,N_out>& other)
+	    {
+		std::map<const tree_type*,tree_iterator>tree_map;
+		const_tree_iterator it2=other.trees.begin();
+		for(tree_iterator it=trees.begin();it!=trees.end();++it)
+		{
+		    it->rebind(currents);
+		    tree_map[&(*it2)]=it;
+		    ++it2;
+		}
+		if(trees.empty() or trees.size()!=processes.size())
+		{
+		    tree_it=trees.end();
+		    process_it=processes.end();
+		    return;
+		}
+		for(process_iterator it=processes.begin();it!=processes.end();++it)
+		{
+		    it->set_tree(tree_map[&(*(it->get_tree()))]);
+		}
+		const_tree_iterator t_it=other.tree_it;
+		tree_it=trees.begin();
+		std::advance(tree_it,std::distance(other.trees.begin(),t_it));
+		const_process_iterator p_it=other.process_it;
+		process_it=processes.begin();
+		std::advance(process_it,std::distance(other.processes.begin(),p_it));
+	    }
     };
     template<class model_t,std::size_t N_in,std::size_t N_out>const std::size_t CM_algorithm<model_t,N_in,N_out>::N_incoming;
     template<class model_t,std::size_t N_in,std::size_t N_out>const std::size_t CM_algorithm<model_t,N_in,N_out>::N_outgoing;
     template<class model_t,std::size_t N_in,std::size_t N_out>const std::size_t CM_algorithm<model_t,N_in,N_out>::N_external;
-    template<class model_t,std::size_t N_in,std::size_t N_out>std::size_t CM_algorithm<model_t,N_in,N_out>::N_final=0;
+    template<class model_t,std::size_t N_in,std::size_t N_out>const unsigned CM_algorithm<model_t,N_in,N_out>::tree_cache_version;
 }
 
 #include <Camgen/undef_args.h>
@@ -12,13 +12,34 @@
 #ifndef CAMGEN_LH_EVT_STREAM_H_
 #define CAMGEN_LH_EVT_STREAM_H_
 
-/* * * * * * * * * * * * * * * * * * * * * * * * * *
- * Les-Houches event format output streaming class.*                                                                   *
- *                                                 *
- * * * * * * * * * * * * * * * * * * * * * * * * * */
-
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Les-Houches event format output streaming class. In asynchronous mode,    *
+ * the filled events are copied into a preallocated ring of records and a    *
+ * background thread formats them and writes the file in large blocks. The   *
+ * background thread prints numbers with std::to_chars where available,      *
+ * which is independent of the locale and byte-compatible with the           *
+ * synchronous output. Asynchronous mode requires C++11. File names ending   *
+ * with '.gz' are compressed on the fly (see gz_ostream.h).                  *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <cstdio>
+#include <cstring>
+#include <clocale>
+#include <algorithm>
 #include <fstream>
+#include <locale>
+#include <vector>
+#if __cplusplus >= 201103L
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
 #include <Camgen/evt_stream.h>
+#include <Camgen/gz_ostream.h>
 
 namespace Camgen
 {
@@ -37,7 +58,7 @@ namespace Camgen
 	    typedef typename base_type::value_type value_type;
 	    typedef typename base_type::momentum_type momentum_type;
 
-	    /// Output file name.
+	    /// Output file name. If it ends with '.gz', the file is compressed.
 
 	    const std::string file_name;
 
@@ -59,26 +80,55 @@ namespace Camgen
 
 	    /// Constructor.
 
-	    LH_event_stream(const std::string& file_name_,int weight_switch_,unsigned proc_id_=1):file_name(file_name_),proc_id(proc_id_),weight_switch(weight_switch_),initialised(false)
+	    LH_event_stream(const std::string& file_name_,int weight_switch_,unsigned proc_id_=1):file_name(file_name_),proc_id(proc_id_),weight_switch(weight_switch_),initialised(false),writer_running(false),writer_stop(false),head(0),tail(0)
 	    {
 		open_file();
 	    }
 
 	    /// Constructor with description.
 
-	    LH_event_stream(const std::string& file_name_,int weight_switch_,const std::string& descr_,unsigned proc_id_=1):file_name(file_name_),proc_id(proc_id_),weight_switch(weight_switch_),description(descr_),initialised(false)
+	    LH_event_stream(const std::string& file_name_,int weight_switch_,const std::string& descr_,unsigned proc_id_=1):file_name(file_name_),proc_id(proc_id_),weight_switch(weight_switch_),description(descr_),initialised(false),writer_running(false),writer_stop(false),head(0),tail(0)
 	    {
 		open_file();
 	    }
 
 	    /// Destructor.
 
-	    ~LH_event_stream(){}
+	    ~LH_event_stream()
+	    {
+		stop_writer();
+	    }
+
+	    /// Enables asynchronous writing with the argument number of event
+	    /// slots, or disables it if zero. Takes effect only before the first
+	    /// event is filled, and returns false without C++11 support.
+
+	    bool set_asynchronous(size_type n_slots=1024)
+	    {
+#if __cplusplus >= 201103L
+		if(initialised)
+		{
+		    return false;
+		}
+		ring.assign(n_slots,LH_record());
+		return true;
+#else
+		return false;
+#endif
+	    }
+
+	    /// Returns whether events are written by a background thread.
+
+	    bool asynchronous() const
+	    {
+		return !ring.empty();
+	    }
 
 	    /// Writes and closes the datafile.
 
 	    bool write()
 	    {
+		stop_writer();
 		if(ofs.is_open())
 		{
 		    ofs.close();
@@ -108,7 +158,20 @@ namespace Camgen
                 {
                     write_init(evt);
                     initialised=true;
+#if __cplusplus >= 201103L
+		    if(!ring.empty())
+		    {
+			start_writer();
+		    }
+#endif
                 }
+#if __cplusplus >= 201103L
+		if(writer_running)
+		{
+		    push_event(evt);
+		    return true;
+		}
+#endif
 		ofs<<"<event>"<<std::endl;
 		value_type w=(weight_switch==3)?1:evt.w();
 		ofs<<(N_in+N_out)<<"\t1\t"<<w<<"\t"<<evt.mu_F()<<"\t"<<model_t::alpha<<"\t"<<model_t::alpha_s<<std::endl;
@@ -154,10 +217,10 @@ namespace Camgen
 
 	    bool open_file()
 	    {
-		std::string fname=this->file_name+".LHE";
-		ofs.open(fname.c_str());
-		if(ofs.is_open())
+		std::string fname=gz_ofstream::file_name(this->file_name,".LHE");
+		if(ofs.open(fname))
 		{
+		    ofs.imbue(std::locale::classic());
 		    ofs.precision(10);
 		    ofs.setf(std::ios::scientific,std::ios::floatfield);
 		    return true;
@@ -195,13 +258,272 @@ namespace Camgen
 
 	private:
 
+	    /* Event data copied for the background writer: */
+
+	    struct LH_record
+	    {
+		value_type w,mu_F,alpha,alpha_s;
+		int id[N_in+N_out],c[N_in+N_out],cbar[N_in+N_out];
+		value_type p[N_in+N_out][5];
+	    };
+
 	    /* Output file stream: */
 
-	    std::ofstream ofs;
+	    gz_ofstream ofs;
 
             /* Initialization flag: */
 
             bool initialised;
+
+	    /* Record ring, filled by the generating thread at head and emptied
+	     * by the writer thread at tail: */
+
+	    std::vector<LH_record> ring;
+#if __cplusplus >= 201103L
+	    std::thread writer;
+	    std::mutex ring_mutex;
+	    std::condition_variable not_empty,not_full;
+#endif
+	    bool writer_running,writer_stop;
+	    size_type head,tail;
+
+	    /* Size of the blocks passed to the file stream: */
+
+	    static const size_type block_size=1<<16;
+
+#if __cplusplus >= 201103L
+
+	    /* Copies the event into the next free slot, waiting for the writer
+	     * if the ring is full: */
+
+	    void push_event(const event_type& evt)
+	    {
+		std::unique_lock<std::mutex> lock(ring_mutex);
+		while(head-tail==ring.size())
+		{
+		    not_full.wait(lock);
+		}
+		lock.unlock();
+		LH_record& rec=ring[head%ring.size()];
+		rec.w=(weight_switch==3)?1:evt.w();
+		rec.mu_F=evt.mu_F();
+		rec.alpha=model_t::alpha;
+		rec.alpha_s=model_t::alpha_s;
+		for(size_type i=0;i<N_in;++i)
+		{
+		    rec.id[i]=evt.id_in(i);
+		    rec.c[i]=evt.c_in(i);
+		    rec.cbar[i]=evt.cbar_in(i);
+		    for(size_type mu=0;mu<4;++mu)
+		    {
+			rec.p[i][mu]=evt.p_in(i,(mu+1)%4);
+		    }
+		    rec.p[i][4]=evt.M_in(i);
+		}
+		for(size_type i=0;i<N_out;++i)
+		{
+		    rec.id[N_in+i]=evt.id_out(i);
+		    rec.c[N_in+i]=evt.c_out(i);
+		    rec.cbar[N_in+i]=evt.cbar_out(i);
+		    for(size_type mu=0;mu<4;++mu)
+		    {
+			rec.p[N_in+i][mu]=evt.p_out(i,(mu+1)%4);
+		    }
+		    rec.p[N_in+i][4]=evt.M_out(i);
+		}
+		lock.lock();
+		++head;
+		lock.unlock();
+		not_empty.notify_one();
+	    }
+
+	    /* Launches the writer thread: */
+
+	    void start_writer()
+	    {
+		ofs.flush();
+		head=0;
+		tail=0;
+		writer_stop=false;
+		writer=std::thread(&LH_event_stream::write_loop,this);
+		writer_running=true;
+	    }
+
+	    /* Drains the ring and joins the writer thread: */
+
+	    void stop_writer()
+	    {
+		if(!writer_running)
+		{
+		    return;
+		}
+		{
+		    std::lock_guard<std::mutex> lock(ring_mutex);
+		    writer_stop=true;
+		}
+		not_empty.notify_one();
+		writer.join();
+		writer_running=false;
+	    }
+
+	    /* Writer thread body, formatting all pending records per pass and
+	     * writing the buffer once it exceeds the block size: */
+
+	    void write_loop()
+	    {
+		std::string buffer;
+		buffer.reserve(2*block_size);
+		while(true)
+		{
+		    std::unique_lock<std::mutex> lock(ring_mutex);
+		    while(head==tail and !writer_stop)
+		    {
+			not_empty.wait(lock);
+		    }
+		    size_type first=tail,last=head;
+		    bool done=(first==last);
+		    lock.unlock();
+		    if(done)
+		    {
+			break;
+		    }
+		    for(size_type n=first;n!=last;++n)
+		    {
+			format_record(buffer,ring[n%ring.size()]);
+		    }
+		    lock.lock();
+		    tail=last;
+		    lock.unlock();
+		    not_full.notify_one();
+		    if(buffer.size()>=block_size)
+		    {
+			ofs.write(buffer.data(),buffer.size());
+			buffer.clear();
+		    }
+		}
+		ofs.write(buffer.data(),buffer.size());
+		ofs.flush();
+	    }
+#else
+
+	    /* Without C++11 there is no writer thread: */
+
+	    void stop_writer(){}
+#endif
+
+	    /* Appends the event block of the record, reproducing the layout of
+	     * the synchronous output: */
+
+	    static void format_record(std::string& buffer,const LH_record& rec)
+	    {
+		buffer.append("<event>\n");
+		append_int(buffer,N_in+N_out,0);
+		buffer.append("\t1\t");
+		append_float(buffer,rec.w,0);
+		buffer.push_back('\t');
+		append_float(buffer,rec.mu_F,0);
+		buffer.push_back('\t');
+		append_float(buffer,rec.alpha,0);
+		buffer.push_back('\t');
+		append_float(buffer,rec.alpha_s,0);
+		buffer.push_back('\n');
+		for(size_type i=0;i<N_in+N_out;++i)
+		{
+		    bool incoming=(i<N_in);
+		    append_int(buffer,rec.id[i],4);
+		    append_int(buffer,incoming?-1:1,6);
+		    append_int(buffer,incoming?0:1,6);
+		    append_int(buffer,incoming?0:2,6);
+		    append_int(buffer,rec.c[i],6);
+		    append_int(buffer,rec.cbar[i],6);
+		    for(size_type mu=0;mu<5;++mu)
+		    {
+			append_float(buffer,rec.p[i][mu],20);
+		    }
+		    buffer.append("    0.    9.\n");
+		}
+		buffer.append("</event>\n");
+	    }
+
+	    /* Appends the right-aligned decimal representation of the
+	     * integer: */
+
+	    static void append_int(std::string& buffer,long n,size_type width)
+	    {
+		char digits[24];
+		char* q=digits+sizeof(digits);
+		unsigned long m=(n<0)?(0UL-(unsigned long)n):((unsigned long)n);
+		do
+		{
+		    *(--q)='0'+(char)(m%10);
+		    m/=10;
+		}
+		while(m!=0);
+		if(n<0)
+		{
+		    *(--q)='-';
+		}
+		size_type len=digits+sizeof(digits)-q;
+		if(len<width)
+		{
+		    buffer.append(width-len,' ');
+		}
+		buffer.append(q,len);
+	    }
+
+	    /* Appends the right-aligned representation of the floating-point
+	     * number with the precision and notation of the synchronous output,
+	     * formatted in place at the end of the buffer: */
+
+	    static void append_float(std::string& buffer,value_type x,size_type width)
+	    {
+		size_type pos=buffer.size();
+		buffer.resize(pos+max_float_size);
+		size_type len=print_float(&buffer[pos],x);
+		if(len<width)
+		{
+		    std::memmove(&buffer[pos+width-len],&buffer[pos],len);
+		    std::memset(&buffer[pos],' ',width-len);
+		    len=width;
+		}
+		buffer.resize(pos+len);
+	    }
+
+	    /* Maximal number of characters of a formatted number: */
+
+	    static const size_type max_float_size=64;
+
+	    /* Prints the number in scientific notation with 10 decimals, as
+	     * the C-locale stream does, and returns the number of characters.
+	     * The fallback for compilers without floating-point to_chars
+	     * replaces the radix character of the C locale by a point: */
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	    template<class T>static size_type print_float(char* first,const T& x)
+	    {
+		return std::to_chars(first,first+max_float_size,x,std::chars_format::scientific,10).ptr-first;
+	    }
+#else
+	    static size_type print_float(char* first,const long double& x)
+	    {
+		int len=std::snprintf(first,max_float_size,"%.10Le",x);
+		return fix_radix(first,(len<0)?0:std::min((size_type)len,max_float_size-1));
+	    }
+	    template<class T>static size_type print_float(char* first,const T& x)
+	    {
+		int len=std::snprintf(first,max_float_size,"%.10e",(double)x);
+		return fix_radix(first,(len<0)?0:std::min((size_type)len,max_float_size-1));
+	    }
+	    static size_type fix_radix(char* first,size_type len)
+	    {
+		const char* radix=std::localeconv()->decimal_point;
+		if(radix[0]!='.' and radix[0]!=0 and radix[1]==0)
+		{
+		    std::replace(first,first+len,radix[0],'.');
+		}
+		return len;
+	    }
+#endif
     };
 }
 
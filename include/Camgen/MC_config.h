@@ -40,7 +40,8 @@ namespace Camgen
 	    unused,
 	    uniform,
 	    summation,
-	    flow_sampling
+	    flow_sampling,
+	    colour_ordered
 	};
     };
     
@@ -258,6 +259,16 @@ namespace Camgen
 
     void set_pre_init_events(std::size_t);
 
+    /// Sets the number of threads adapting the subprocess generators
+    /// concurrently at (pre-)initialisation. Each thread evaluates its own
+    /// copy of the amplitude, but the model couplings are static data, so
+    /// event-dependent renormalisation scales should be avoided. Only
+    /// random number engines with substreams (see rn_substream) are used
+    /// concurrently; with other engines the initialisation stays
+    /// sequential. Returns false at failure (zero argument).
+
+    bool set_init_threads(std::size_t);
+
     /// Returns the helicity generator type.
 
     helicity_generators::type helicity_generator_type();
@@ -436,6 +447,10 @@ namespace Camgen
 
     std::size_t pre_init_events();
 
+    /// Returns the number of subprocess initialisation threads.
+
+    std::size_t init_threads();
+
     /// Returns the s-pair generation mode.
 
     s_pair_generation_modes::type s_pair_generation_mode();
@@ -510,6 +525,7 @@ namespace Camgen
 	    static bool set_NR_iterations(std::size_t);
 	    static void set_pdf_alpha_s(bool);
 	    static void set_pre_init_events(std::size_t);
+	    static bool set_init_threads(std::size_t);
 	    static void set_s_pair_generation_mode(s_pair_generation_modes::type);
 
 	    /* Public static readout functions: */
@@ -557,6 +573,7 @@ namespace Camgen
 	    static std::size_t NR_iterations();
 	    static bool use_pdf_alpha_s();
 	    static std::size_t pre_init_events();
+	    static std::size_t init_threads();
 	    static s_pair_generation_modes::type s_pair_generation_mode();
 
 	    /* Basic cut inserters: */
@@ -614,6 +631,7 @@ namespace Camgen
 	    static std::size_t NR_iters;
 	    static bool pdf_alpha_s;
 	    static std::size_t init_evts;
+	    static std::size_t init_thrds;
 	    static s_pair_generation_modes::type s_pair_genmode;
 	    
 	    static std::map<std::string,double> nu_s_phi;
@@ -68,7 +68,9 @@ namespace Camgen
             /*-------------------*/
 
             /// Raises the number of calls by 1 and the weight sums by the
-            /// current weight, without calling the generation method.
+            /// current weight, without calling the generation method. Reads
+            /// the event stored in the instance, so worker threads should
+            /// add their weights with accumulate() instead.
 
             virtual void refresh_cross_section(bool with_integrand=true)
             {
@@ -91,6 +93,62 @@ namespace Camgen
                 up_to_date=false;
             }
 
+            /// Raises the number of calls by 1 and the weight sums by the
+            /// argument weighted integrand. If called by a worker thread (see
+            /// shadow_acc.h), the sums in the worker's shadow are raised
+            /// instead, and enter the cross section when the owning thread
+            /// calls adapt() or merge_shadows().
+
+            void accumulate(const value_type& w)
+            {
+                if(!is_finite_number(w))
+                {
+                    return;
+                }
+                weight_sums* s=shadows.local();
+                if(s==NULL)
+                {
+                    ++n_calls;
+                    update_by_weight(w);
+                    up_to_date=false;
+                    return;
+                }
+                s->add(w);
+            }
+
+            /// Sets the number of worker threads accumulating weight sums.
+            /// Pending shadow sums are merged first.
+
+            virtual void set_update_workers(size_type n)
+            {
+                merge_shadows();
+                shadows.resize(n);
+            }
+
+            /// Adds the weight sums of the workers to the ones of the
+            /// instance, in worker order. The weight histogram only receives
+            /// the weights accumulated in place.
+
+            virtual void merge_shadows()
+            {
+                for(size_type i=0;i<shadows.size();++i)
+                {
+                    weight_sums& s=shadows[i];
+                    if(s.n==0)
+                    {
+                        continue;
+                    }
+                    n_calls+=s.n;
+                    max_w=std::max(max_w,s.max_w);
+                    wsum+=s.wsum;
+                    w2sum+=s.w2sum;
+                    w3sum+=s.w3sum;
+                    w4sum+=s.w4sum;
+                    s=weight_sums();
+                    up_to_date=false;
+                }
+            }
+
             /// Resets the the state of the MC generator. Resets adaptive
             /// channels weights and grids as well.
 
@@ -102,6 +160,7 @@ namespace Camgen
                 w3sum=(value_type)0;
                 w4sum=(value_type)0;
                 n_calls=0;
+                shadows.resize(shadows.size());
                 integral.value=(value_type)0;
                 integral.error=std::numeric_limits<value_type>::infinity();
                 integral.error_error=std::numeric_limits<value_type>::infinity();
@@ -119,6 +178,7 @@ namespace Camgen
                 w3sum=(value_type)0;
                 w4sum=(value_type)0;
                 n_calls=0;
+                shadows.resize(shadows.size());
                 integral.value=(value_type)0;
                 integral.error=std::numeric_limits<value_type>::infinity();
                 integral.error_error=std::numeric_limits<value_type>::infinity();
@@ -215,6 +275,38 @@ namespace Camgen
                 this->integrand()=(value_type)1;
             }
 
+            /// Writes the call count, maximal weights and weight sums to the
+            /// binary output stream.
+
+            virtual void save_state(std::ostream& os) const
+            {
+                binary_io::write(os,n_calls);
+                binary_io::write(os,max_w);
+                binary_io::write(os,max_w_eps);
+                binary_io::write(os,eps);
+                binary_io::write(os,wsum);
+                binary_io::write(os,w2sum);
+                binary_io::write(os,w3sum);
+                binary_io::write(os,w4sum);
+            }
+
+            /// Reads the call count, maximal weights and weight sums from the
+            /// binary input stream.
+
+            virtual bool load_state(std::istream& is)
+            {
+                if(!(binary_io::read(is,n_calls) and binary_io::read(is,max_w) and binary_io::read(is,max_w_eps) and binary_io::read(is,eps)))
+                {
+                    return false;
+                }
+                if(!(binary_io::read(is,wsum) and binary_io::read(is,w2sum) and binary_io::read(is,w3sum) and binary_io::read(is,w4sum)))
+                {
+                    return false;
+                }
+                up_to_date=false;
+                return true;
+            }
+
             /* Public readout methods: */
             /*-------------------------*/
 
@@ -360,6 +452,29 @@ namespace Camgen
 
             value_type eps;
 
+            /* Worker shadow of the call count and weight sums: */
+
+            struct weight_sums
+            {
+                size_type n;
+                value_type max_w,wsum,w2sum,w3sum,w4sum;
+
+                weight_sums():n(0),max_w(0),wsum(0),w2sum(0),w3sum(0),w4sum(0){}
+
+                void add(const value_type& w)
+                {
+                    ++n;
+                    max_w=std::max(w,max_w);
+                    wsum+=w;
+                    value_type w2=w*w;
+                    w2sum+=w2;
+                    w3sum+=(w2*w);
+                    w4sum+=(w2*w2);
+                }
+            };
+
+            shadow_accumulator<weight_sums> shadows;
+
             /* Utility helper: */
 
             void update_by_weight(const value_type& w)
@@ -12,7 +12,13 @@
 #ifndef CAMGEN_MC_INT_BASE_H_
 #define CAMGEN_MC_INT_BASE_H_
 
+#include <string>
+#include <fstream>
 #include <Camgen/num_utils.h>
+#include <Camgen/debug.h>
+#include <Camgen/logstream.h>
+#include <Camgen/bin_io.h>
+#include <Camgen/shadow_acc.h>
 #include <Camgen/MC_integral.h>
 
 namespace Camgen
@@ -50,6 +56,89 @@ namespace Camgen
 
 	    virtual void reset(){}
 
+	    /// Sets the number of worker threads accumulating updates into
+	    /// private shadows (see shadow_acc.h). Does nothing by default.
+
+	    virtual void set_update_workers(std::size_t n){}
+
+	    /// Merges the worker shadows into the internal parameters, in worker
+	    /// order. Should not be called while the workers are updating. Does
+	    /// nothing by default.
+
+	    virtual void merge_shadows(){}
+
+	    /// Writes the adaptive state (grids, multichannel weights and weight
+	    /// sums) to the binary output stream. Does nothing by default.
+
+	    virtual void save_state(std::ostream& os) const{}
+
+	    /// Reads the adaptive state written by save_state from the binary
+	    /// input stream. The instance should have been constructed with the
+	    /// same configuration as the saved one. Returns false if the data
+	    /// does not match the instance.
+
+	    virtual bool load_state(std::istream& is)
+	    {
+		return true;
+	    }
+
+	    /// Writes a versioned binary file header followed by the adaptive
+	    /// state to the output stream.
+
+	    bool save(std::ostream& os) const
+	    {
+		binary_io::write_header(os,"Camgen generator state",state_version);
+		binary_io::write(os,(unsigned)sizeof(value_type));
+		save_state(os);
+		return os.good();
+	    }
+
+	    /// Writes the adaptive state to the argument binary file.
+
+	    bool save(const std::string& filename) const
+	    {
+		std::ofstream ofs(filename.c_str(),std::ios::out|std::ios::binary);
+		if(!ofs.is_open())
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"generator state file "<<filename<<" could not be opened for writing"<<endlog;
+		    return false;
+		}
+		return save(ofs);
+	    }
+
+	    /// Reads an adaptive state written by save from the input stream.
+	    /// Returns false if the header, the numerical precision or the
+	    /// state data do not match; the instance should then be reset.
+
+	    bool load(std::istream& is)
+	    {
+		unsigned n;
+		if(!binary_io::read_header(is,"Camgen generator state",state_version) or !binary_io::read(is,n) or n!=sizeof(value_type))
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"generator state header does not match format version "<<state_version<<endlog;
+		    return false;
+		}
+		if(!load_state(is))
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"generator state does not match the generator configuration"<<endlog;
+		    return false;
+		}
+		return true;
+	    }
+
+	    /// Reads the adaptive state from the argument binary file.
+
+	    bool load(const std::string& filename)
+	    {
+		std::ifstream ifs(filename.c_str(),std::ios::in|std::ios::binary);
+		if(!ifs.is_open())
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"generator state file "<<filename<<" could not be opened"<<endlog;
+		    return false;
+		}
+		return load(ifs);
+	    }
+
 	    /// Substitutes the integrand with the argument and performs update().
 
 	    void update(const value_type& f_)
@@ -82,12 +171,18 @@ namespace Camgen
 		return is_finite_number(f);
 	    }
 
+	    /// Version of the generator state format.
+
+	    static const unsigned state_version=2;
+
 	private:
 
 	    /* Integrand: */
 
 	    value_type f;
     };
+
+    template<class value_t>const unsigned MC_integrator_base<value_t>::state_version;
 }
 
 #endif /*CAMGEN_MC_INT_BASE_H_*/
@@ -389,7 +389,7 @@ else											\
 
 	    /* Memory storage tensor for the trace part of the vertex: */
 
-	    static tensor_type white_part;
+	    static CAMGEN_THREAD_LOCAL tensor_type white_part;
 
 	    /* Storage array of the (sub-)tensor sizes: */
 
@@ -400,7 +400,7 @@ else											\
 	    static std::vector<size_type> utilvec;
     };
     template<std::size_t N,std::size_t I,std::size_t J,std::size_t K,class Feynrule_t>std::vector<typename evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::size_type> evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::utilvec;
-    template<std::size_t N,std::size_t I,std::size_t J,std::size_t K,class Feynrule_t>typename evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::tensor_type evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::white_part(evaluate<Feynrule_t>::get_index_ranges(I,evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::utilvec));
+    template<std::size_t N,std::size_t I,std::size_t J,std::size_t K,class Feynrule_t>CAMGEN_THREAD_LOCAL typename evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::tensor_type evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::white_part(evaluate<Feynrule_t>::get_index_ranges(I,evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::utilvec));
     template<std::size_t N,std::size_t I,std::size_t J,std::size_t K,class Feynrule_t>const typename evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::size_type evaluate<compose_vertices<colour_tensor::CF_T<N,I,J,K>,Feynrule_t> >::sizes[3][4]={{Feynrule_t::sizes[0],Feynrule_t::sizes[1],Feynrule_t::sizes[2],Feynrule_t::sizes[3]},{N*Feynrule_t::sizes[0],N*Feynrule_t::sizes[1],N*Feynrule_t::sizes[2],N*Feynrule_t::sizes[3]},{N*N*Feynrule_t::sizes[0],N*N*Feynrule_t::sizes[1],N*N*Feynrule_t::sizes[2],N*N*Feynrule_t::sizes[3]}};
 
     /* Specialisation of the cfd_evaluate class template for vertices composed with
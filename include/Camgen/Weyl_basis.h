@@ -10,6 +10,7 @@
 
 #include <Camgen/Minkowski.h>
 #include <Camgen/Dirac_alg.h>
+#include <Camgen/simd_spinor.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Declaration and definition of the Weyl basis of Dirac gamma matrices. Aside   *
@@ -367,6 +368,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::VA_first(C_0,C_0,spinor_components(A_1),spinor_components(A_2),spinor_components(A_0));
+		    return;
+		}
+#endif
 		
 		value_type Qp=A_1[0]*A_2[2] + A_1[3]*A_2[1];
 
@@ -393,6 +402,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::VA_second(C_0,C_0,spinor_components(A_0),spinor_components(A_2),spinor_components(A_1));
+		    return;
+		}
+#endif
 		
 		value_type Qp(A_0[1].real()-A_0[2].imag(),A_0[1].imag()+A_0[2].real());
 
@@ -443,6 +460,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::VA_third(C_0,C_0,spinor_components(A_0),spinor_components(A_1),spinor_components(A_2));
+		    return;
+		}
+#endif
 		
 		value_type Qp(A_0[1].real()-A_0[2].imag(),A_0[1].imag()+A_0[2].real());
 
@@ -1638,6 +1663,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::VA_first(C_0+C_1,C_0-C_1,spinor_components(A_1),spinor_components(A_2),spinor_components(A_0));
+		    return;
+		}
+#endif
 		
 		value_type L=C_0+C_1;
 
@@ -1661,6 +1694,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::VA_second(C_0+C_1,C_0-C_1,spinor_components(A_0),spinor_components(A_2),spinor_components(A_1));
+		    return;
+		}
+#endif
 		
 		value_type L=C_0+C_1;
 
@@ -1688,6 +1729,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::VA_third(C_0+C_1,C_0-C_1,spinor_components(A_0),spinor_components(A_1),spinor_components(A_2));
+		    return;
+		}
+#endif
 		
 		value_type L=C_0+C_1;
 
@@ -1869,6 +1918,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::L_first(C_0,spinor_components(A_1),spinor_components(A_2),spinor_components(A_0));
+		    return;
+		}
+#endif
 		
 		A_0[0] += C_0*(A_1[0]*A_2[2] + A_1[1]*A_2[3]);
 
@@ -2016,6 +2073,14 @@ namespace Camgen
 		CAMGEN_ERROR_IF((A_0.range()<4),"tensor iterator 0 out of range");
 		CAMGEN_ERROR_IF((A_1.range()<4),"tensor iterator 1 out of range");
 		CAMGEN_ERROR_IF((A_2.range()<4),"tensor iterator 2 out of range");
+
+#ifdef CAMGEN_SIMD_AVX
+		if(spinor_simd<value_type>::vectorised)
+		{
+		    spinor_simd<value_type>::R_first(C_0,spinor_components(A_1),spinor_components(A_2),spinor_components(A_0));
+		    return;
+		}
+#endif
 		
 		A_0[0] += C_0*(A_1[3]*A_2[1] + A_1[2]*A_2[0]);
 
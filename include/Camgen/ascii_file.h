@@ -14,13 +14,15 @@
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * ASCII datafile output event tree class implementation. Creates a datafile *
- * where each row contains event information.                                *
+ * where each row contains event information. File names ending with '.gz'   *
+ * are compressed on the fly (see gz_ostream.h).                             *
  *                                                                           *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <fstream>
 #include <map>
 #include <Camgen/evt_output.h>
+#include <Camgen/gz_ostream.h>
 
 namespace Camgen
 {
@@ -68,9 +70,8 @@ namespace Camgen
 
 	    bool open_file()
 	    {
-		std::string fname=this->file_name+".dat";
-		ofs.open(fname.c_str());
-		if(ofs.is_open())
+		std::string fname=gz_ofstream::file_name(this->file_name,".dat");
+		if(ofs.open(fname))
 		{
 		    return true;
 		}
@@ -210,7 +211,7 @@ namespace Camgen
 
 	private:
 
-	    std::ofstream ofs;
+	    gz_ofstream ofs;
 
 	    int line;
 
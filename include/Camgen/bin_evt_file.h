@@ -0,0 +1,327 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file bin_evt_file.h
+    \brief Binary event file output and record layout.
+ */
+
+#ifndef CAMGEN_BIN_EVT_FILE_H_
+#define CAMGEN_BIN_EVT_FILE_H_
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Binary event file output class. Writes a header with the format version, *
+ * the record layout and the units, followed by one fixed-size record per    *
+ * event. Upon closing, the number of events and the final cross section are *
+ * written into the header and the process table is appended to the file.    *
+ * The records start at a 64-byte aligned offset, so the file can be mapped  *
+ * into memory and read without copying (see bin_evt_reader.h).              *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <Camgen/bin_io.h>
+#include <Camgen/evt_output.h>
+
+namespace Camgen
+{
+    /// Fixed-size binary event record. Particles are ordered as incoming
+    /// followed by outgoing ones.
+
+    template<class model_t,std::size_t N_in,std::size_t N_out>struct binary_event_record
+    {
+	/* Type definitions: */
+
+	typedef typename model_t::value_type value_type;
+	typedef vector<value_type,model_t::dimension> momentum_type;
+	typedef std::size_t size_type;
+
+	/// Particle momenta.
+
+	value_type p[N_in+N_out][model_t::dimension];
+
+	/// Event weight.
+
+	value_type w;
+
+	/// Factorisation scale.
+
+	value_type mu_F;
+
+	/// Subprocess id.
+
+	int proc_id;
+
+	/// Particle PDG ids.
+
+	int id[N_in+N_out];
+
+	/// Colour and anticolour line indices.
+
+	int c[N_in+N_out],cbar[N_in+N_out];
+
+	/// Returns the i-th particle momentum, where i<0 denotes incoming
+	/// and i>0 outgoing particles (no bound-checking).
+
+	momentum_type momentum(int i) const
+	{
+	    const value_type* q=p[(i<0)?(-i-1):(N_in+i-1)];
+	    momentum_type result;
+	    for(size_type mu=0;mu<model_t::dimension;++mu)
+	    {
+		result[mu]=q[mu];
+	    }
+	    return result;
+	}
+
+	/// Returns the i-th particle PDG id, where i<0 denotes incoming
+	/// and i>0 outgoing particles (no bound-checking).
+
+	int pdg_id(int i) const
+	{
+	    return id[(i<0)?(-i-1):(N_in+i-1)];
+	}
+    };
+
+    /// Binary event file format utilities.
+
+    class binary_event_format
+    {
+	public:
+
+	    /// File header tag.
+
+	    static const char* tag()
+	    {
+		return "Camgen binary events";
+	    }
+
+	    /// Units tag of momenta and cross sections.
+
+	    static const char* units()
+	    {
+		return "GeV,pb";
+	    }
+
+	    /// Format version.
+
+	    static unsigned version()
+	    {
+		return 1;
+	    }
+
+	    /// Returns the offset of the record block following a header of n
+	    /// bytes, aligned to 64 bytes.
+
+	    static std::size_t data_offset(std::size_t n)
+	    {
+		return ((n+63)/64)*64;
+	    }
+    };
+
+    /// Binary event file output class. Ignores the output configuration
+    /// branches and writes the full event record.
+
+    template<class model_t,std::size_t N_in,std::size_t N_out>class binary_event_file: public event_output<model_t,N_in,N_out>
+    {
+	typedef event_output<model_t,N_in,N_out> base_type;
+
+	public:
+
+	    /* Type definitions: */
+
+	    typedef typename base_type::event_type event_type;
+	    typedef typename base_type::size_type size_type;
+	    typedef typename base_type::value_type value_type;
+	    typedef typename base_type::momentum_type momentum_type;
+	    typedef binary_event_record<model_t,N_in,N_out> record_type;
+
+	    /// Constructor with file name argument.
+
+	    binary_event_file(const std::string& file_name_):base_type(file_name_),n_events(0),patch_pos(0){}
+
+	    /// Constructor with file name and description arguments.
+
+	    binary_event_file(const std::string& file_name_,const std::string description_):base_type(file_name_,description_),n_events(0),patch_pos(0){}
+
+	    /// Destructor.
+
+	    ~binary_event_file()
+	    {
+		close_file();
+	    }
+
+	    /// Creation method implementation.
+
+	    event_output<model_t,N_in,N_out>* create(const std::string& file_name_) const
+	    {
+		return new binary_event_file<model_t,N_in,N_out>(file_name_,this->description);
+	    }
+
+	    /// Opens the datafile and writes the header.
+
+	    bool open_file()
+	    {
+		std::string fname=this->file_name+".evt";
+		ofs.open(fname.c_str(),std::ios::out|std::ios::binary|std::ios::trunc);
+		if(!ofs.is_open())
+		{
+		    return false;
+		}
+		n_events=0;
+		procs.clear();
+		xsec=MC_integral<value_type>(0);
+		binary_io::write_header(ofs,binary_event_format::tag(),binary_event_format::version());
+		binary_io::write(ofs,(unsigned)sizeof(value_type));
+		binary_io::write(ofs,(unsigned)N_in);
+		binary_io::write(ofs,(unsigned)N_out);
+		binary_io::write(ofs,(unsigned)model_t::dimension);
+		binary_io::write(ofs,(unsigned)sizeof(record_type));
+		binary_io::write_string(ofs,binary_event_format::units());
+		binary_io::write_string(ofs,this->description);
+		patch_pos=ofs.tellp();
+		write_totals(0);
+		size_type n=ofs.tellp();
+		for(size_type i=n;i<binary_event_format::data_offset(n);++i)
+		{
+		    ofs.put(0);
+		}
+		return ofs.good();
+	    }
+
+	    /// Appends the process table, completes the header and closes the
+	    /// datafile.
+
+	    bool close_file()
+	    {
+		if(!ofs.is_open())
+		{
+		    return true;
+		}
+		size_type trailer=ofs.tellp();
+		binary_io::write(ofs,(size_type)procs.size());
+		for(typename std::map<int,process_entry>::const_iterator it=procs.begin();it!=procs.end();++it)
+		{
+		    binary_io::write(ofs,it->first);
+		    binary_io::write(ofs,it->second);
+		}
+		ofs.seekp(patch_pos);
+		write_totals(trailer);
+		ofs.close();
+		return !(ofs.is_open());
+	    }
+
+	    /// Writes the event record to the output file.
+
+	    bool write_event(const event_type& evt)
+	    {
+		if(!ofs.is_open())
+		{
+		    return false;
+		}
+		std::memset(&record,0,sizeof(record_type));
+		for(size_type i=0;i<N_in;++i)
+		{
+		    fill_particle(i,evt.p_in(i),evt.id_in(i),evt.c_in(i),evt.cbar_in(i));
+		}
+		for(size_type i=0;i<N_out;++i)
+		{
+		    fill_particle(N_in+i,evt.p_out(i),evt.id_out(i),evt.c_out(i),evt.cbar_out(i));
+		}
+		record.w=evt.w();
+		record.mu_F=evt.mu_F();
+		record.proc_id=evt.process_id();
+		process_entry& proc=procs[record.proc_id];
+		for(size_type i=0;i<N_in+N_out;++i)
+		{
+		    proc.id[i]=record.id[i];
+		}
+		MC_integral<value_type>proc_xsec=evt.process_xsec();
+		proc.xsec=proc_xsec.value;
+		proc.xsec_error=proc_xsec.error;
+		xsec=evt.xsec();
+		ofs.write(reinterpret_cast<const char*>(&record),sizeof(record_type));
+		++n_events;
+		return ofs.good();
+	    }
+
+	    /// Returns the number of events written.
+
+	    size_type events() const
+	    {
+		return n_events;
+	    }
+
+	    /// Process table entry.
+
+	    struct process_entry
+	    {
+		/// Particle PDG ids.
+
+		int id[N_in+N_out];
+
+		/// Subprocess cross section and error.
+
+		value_type xsec,xsec_error;
+	    };
+
+	private:
+
+	    /* Output file stream: */
+
+	    std::ofstream ofs;
+
+	    /* Record buffer: */
+
+	    record_type record;
+
+	    /* Number of events written: */
+
+	    size_type n_events;
+
+	    /* Position of the event count, cross section and process table
+	     * offset in the header: */
+
+	    size_type patch_pos;
+
+	    /* Last total cross section streamed: */
+
+	    MC_integral<value_type> xsec;
+
+	    /* Process table: */
+
+	    std::map<int,process_entry> procs;
+
+	    /* Writes the event count, total cross section and process table
+	     * offset: */
+
+	    void write_totals(size_type trailer)
+	    {
+		binary_io::write(ofs,n_events);
+		binary_io::write(ofs,xsec.value);
+		binary_io::write(ofs,xsec.error);
+		binary_io::write(ofs,trailer);
+	    }
+
+	    /* Copies the particle data into the record: */
+
+	    void fill_particle(size_type i,const momentum_type& q,int id,int c,int cbar)
+	    {
+		for(size_type mu=0;mu<model_t::dimension;++mu)
+		{
+		    record.p[i][mu]=q[mu];
+		}
+		record.id[i]=id;
+		record.c[i]=c;
+		record.cbar[i]=cbar;
+	    }
+    };
+}
+
+#endif /*CAMGEN_BIN_EVT_FILE_H_*/
+
@@ -0,0 +1,258 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file bin_evt_reader.h
+    \brief Memory-mapped reader of binary event files.
+ */
+
+#ifndef CAMGEN_BIN_EVT_READER_H_
+#define CAMGEN_BIN_EVT_READER_H_
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Reader of the binary event files written by binary_event_file. The header *
+ * and the process table are read with a file stream, whereas the records    *
+ * are mapped into memory and accessed in place. Files that were not closed  *
+ * properly hold no process table, and the number of records is then taken   *
+ * from the file size. Requires a POSIX system.                              *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <Camgen/bin_evt_file.h>
+
+namespace Camgen
+{
+    /// Memory-mapped binary event file reader.
+
+    template<class model_t,std::size_t N_in,std::size_t N_out>class binary_event_reader
+    {
+	public:
+
+	    /* Type definitions: */
+
+	    typedef typename model_t::value_type value_type;
+	    typedef std::size_t size_type;
+	    typedef binary_event_record<model_t,N_in,N_out> record_type;
+	    typedef typename binary_event_file<model_t,N_in,N_out>::process_entry process_entry;
+	    typedef const record_type* const_iterator;
+
+	    /// Constructor, opening the argument file (including extension).
+
+	    binary_event_reader(const std::string& file_name_):file_name(file_name_),fd(-1),map_ptr(NULL),map_size(0),records(NULL),n_events(0)
+	    {
+		open();
+	    }
+
+	    /// Destructor.
+
+	    ~binary_event_reader()
+	    {
+		close();
+	    }
+
+	    /// File name.
+
+	    const std::string file_name;
+
+	    /// Returns whether the file was mapped successfully.
+
+	    bool is_open() const
+	    {
+		return (map_ptr!=NULL);
+	    }
+
+	    /// Returns the number of event records.
+
+	    size_type size() const
+	    {
+		return n_events;
+	    }
+
+	    /// Returns the i-th record (no bound-checking).
+
+	    const record_type& operator [] (size_type i) const
+	    {
+		return records[i];
+	    }
+
+	    /// Returns an iterator to the first record.
+
+	    const_iterator begin() const
+	    {
+		return records;
+	    }
+
+	    /// Returns an iterator past the last record.
+
+	    const_iterator end() const
+	    {
+		return records+n_events;
+	    }
+
+	    /// Returns the total cross section written when closing the file.
+
+	    const MC_integral<value_type>& cross_section() const
+	    {
+		return xsec;
+	    }
+
+	    /// Returns the units tag of the file.
+
+	    const std::string& units() const
+	    {
+		return unit_tag;
+	    }
+
+	    /// Returns the file description.
+
+	    const std::string& description() const
+	    {
+		return descr;
+	    }
+
+	    /// Returns the number of subprocesses in the process table.
+
+	    size_type processes() const
+	    {
+		return procs.size();
+	    }
+
+	    /// Returns the process table entry of the argument subprocess id, or
+	    /// NULL if it does not occur in the file.
+
+	    const process_entry* process(int id) const
+	    {
+		typename std::map<int,process_entry>::const_iterator it=procs.find(id);
+		return (it==procs.end())?NULL:&(it->second);
+	    }
+
+	private:
+
+	    /* File descriptor: */
+
+	    int fd;
+
+	    /* Mapped region: */
+
+	    void* map_ptr;
+	    size_type map_size;
+
+	    /* First record and number of records: */
+
+	    const record_type* records;
+	    size_type n_events;
+
+	    /* Header and process table data: */
+
+	    MC_integral<value_type> xsec;
+	    std::string unit_tag,descr;
+	    std::map<int,process_entry> procs;
+
+	    /* Reads the header and process table and maps the file: */
+
+	    bool open()
+	    {
+		std::ifstream ifs(file_name.c_str(),std::ios::in|std::ios::binary);
+		if(!ifs.is_open())
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"binary event file "<<file_name<<" could not be opened"<<endlog;
+		    return false;
+		}
+		unsigned nval,nin,nout,dim,nrec;
+		size_type trailer;
+		bool q=binary_io::read_header(ifs,binary_event_format::tag(),binary_event_format::version());
+		q=q and binary_io::read(ifs,nval) and binary_io::read(ifs,nin) and binary_io::read(ifs,nout) and binary_io::read(ifs,dim) and binary_io::read(ifs,nrec);
+		if(!q or nval!=sizeof(value_type) or nin!=N_in or nout!=N_out or dim!=model_t::dimension or nrec!=sizeof(record_type))
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"binary event file "<<file_name<<" does not match format version "<<binary_event_format::version()<<" and record layout"<<endlog;
+		    return false;
+		}
+		q=binary_io::read_string(ifs,unit_tag) and binary_io::read_string(ifs,descr);
+		q=q and binary_io::read(ifs,n_events) and binary_io::read(ifs,xsec.value) and binary_io::read(ifs,xsec.error) and binary_io::read(ifs,trailer);
+		if(!q)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"binary event file "<<file_name<<" has a corrupt header"<<endlog;
+		    return false;
+		}
+		size_type offset=binary_event_format::data_offset(ifs.tellg());
+		ifs.seekg(0,std::ios::end);
+		size_type fsize=ifs.tellg();
+		if(trailer==0)
+		{
+		    n_events=(fsize<offset)?0:((fsize-offset)/sizeof(record_type));
+		}
+		else
+		{
+		    size_type n;
+		    ifs.seekg(trailer);
+		    q=binary_io::read(ifs,n);
+		    for(size_type i=0;i<n and q;++i)
+		    {
+			int id;
+			process_entry entry;
+			q=binary_io::read(ifs,id) and binary_io::read(ifs,entry);
+			procs[id]=entry;
+		    }
+		    if(!q or offset+n_events*sizeof(record_type)>trailer)
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"binary event file "<<file_name<<" has a corrupt process table"<<endlog;
+			return false;
+		    }
+		}
+		ifs.close();
+		if(n_events==0)
+		{
+		    return true;
+		}
+		fd=::open(file_name.c_str(),O_RDONLY);
+		if(fd<0)
+		{
+		    return false;
+		}
+		map_size=offset+n_events*sizeof(record_type);
+		map_ptr=::mmap(NULL,map_size,PROT_READ,MAP_SHARED,fd,0);
+		if(map_ptr==MAP_FAILED)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"binary event file "<<file_name<<" could not be mapped into memory"<<endlog;
+		    map_ptr=NULL;
+		    n_events=0;
+		    return false;
+		}
+		::madvise(map_ptr,map_size,MADV_SEQUENTIAL);
+		records=reinterpret_cast<const record_type*>(static_cast<const char*>(map_ptr)+offset);
+		return true;
+	    }
+
+	    /* Unmaps and closes the file: */
+
+	    void close()
+	    {
+		if(map_ptr!=NULL)
+		{
+		    ::munmap(map_ptr,map_size);
+		    map_ptr=NULL;
+		}
+		if(fd>=0)
+		{
+		    ::close(fd);
+		    fd=-1;
+		}
+		records=NULL;
+	    }
+
+	    /* Copying is not supported: */
+
+	    binary_event_reader(const binary_event_reader<model_t,N_in,N_out>&);
+	    binary_event_reader<model_t,N_in,N_out>& operator = (const binary_event_reader<model_t,N_in,N_out>&);
+    };
+}
+
+#endif /*CAMGEN_BIN_EVT_READER_H_*/
+
@@ -0,0 +1,116 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file bin_io.h
+    \brief binary stream utilities
+ */
+
+#ifndef CAMGEN_BIN_IO_H_
+#define CAMGEN_BIN_IO_H_
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace Camgen
+{
+    /// Class holding utility functions for unformatted binary input and
+    /// output of plain data. The data is written in the native byte order of
+    /// the machine, so binary files are not portable across platforms.
+
+    class binary_io
+    {
+	public:
+
+	    /// Writes the argument to the output stream.
+
+	    template<class T>static void write(std::ostream& os,const T& x)
+	    {
+		os.write(reinterpret_cast<const char*>(&x),sizeof(T));
+	    }
+
+	    /// Reads the argument from the input stream and returns whether
+	    /// the reading succeeded.
+
+	    template<class T>static bool read(std::istream& is,T& x)
+	    {
+		is.read(reinterpret_cast<char*>(&x),sizeof(T));
+		return !is.fail();
+	    }
+
+	    /// Writes the string length followed by its characters to the
+	    /// output stream.
+
+	    static void write_string(std::ostream& os,const std::string& s)
+	    {
+		unsigned n=s.size();
+		write(os,n);
+		os.write(s.data(),n);
+	    }
+
+	    /// Reads a string written by write_string from the input stream
+	    /// and returns whether the reading succeeded.
+
+	    static bool read_string(std::istream& is,std::string& s)
+	    {
+		unsigned n;
+		if(!read(is,n) or n>max_string_size)
+		{
+		    return false;
+		}
+		std::vector<char>buffer(n);
+		if(n>0)
+		{
+		    is.read(&buffer[0],n);
+		}
+		s.assign(buffer.begin(),buffer.end());
+		return !is.fail();
+	    }
+
+	    /// Writes a file header consisting of the argument tag, the format
+	    /// version and a byte order marker.
+
+	    static void write_header(std::ostream& os,const std::string& tag,unsigned version)
+	    {
+		write_string(os,tag);
+		write(os,version);
+		write(os,byte_order_mark());
+	    }
+
+	    /// Reads a file header and returns whether it matches the argument
+	    /// tag, format version and the byte order of the machine.
+
+	    static bool read_header(std::istream& is,const std::string& tag,unsigned version)
+	    {
+		std::string s;
+		unsigned v,m;
+		if(!read_string(is,s) or s!=tag)
+		{
+		    return false;
+		}
+		if(!read(is,v) or v!=version)
+		{
+		    return false;
+		}
+		return (read(is,m) and m==byte_order_mark());
+	    }
+
+	    /// Maximal length of strings accepted by read_string.
+
+	    static const unsigned max_string_size=1<<16;
+
+	private:
+
+	    static unsigned byte_order_mark()
+	    {
+		return 0x01020304;
+	    }
+    };
+}
+
+#endif /*CAMGEN_BIN_IO_H_*/
+
@@ -12,6 +12,9 @@
 #include <algorithm>
 #include <Camgen/debug.h>
 #include <Camgen/bit_string.h>
+#if __cplusplus >= 201103L
+#include <mutex>
+#endif
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Declaration and definition of the bitstring partition class. The class      *
@@ -20,7 +23,9 @@
  * Subsequently it lists all (ordered) partitions of the bitstrings B_i, i<=r, *
  * where B_i denotes the string with the first i bits set and the rest zero.   *
  * After initialisation, any bit string can be quickly partitioned by          *
- * convoluting with the appropriate partitions.                                *
+ * convoluting with the appropriate partitions. Concurrently constructed       *
+ * process trees should call prepare(), which serialises the table extension;  *
+ * levels already generated are never rewritten, so reading them is safe.      *
  *                                                                             *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -128,9 +133,9 @@ namespace Camgen
 				    break;
 				}
 			    }
-			    if(i<lvl)
+			    if(i<lvl and i>=max_lvl)
 			    {
-				/* Fill the diagonal entries by the maximal
+				/* Fill the new diagonal entries by the maximal
 				 * partition: */
 
 				partition_table[i][i].resize(1);
@@ -149,15 +154,16 @@ namespace Camgen
 		}
 	    }
 
-	    /* Static function sorting all partitions: */
+	    /* Static function sorting all partitions. Levels sorted by an
+	     * earlier call are left untouched: */
 
 	    static void sort()
 	    {
-		if(!sorted)
+		if(!sorted or sorted_lvl<max_lvl)
 		{
 		    for(size_type i=0;i<N;++i)
 		    {
-			for(size_type j=0;j<max_lvl;++j)
+			for(size_type j=sorted_lvl;j<max_lvl;++j)
 			{
 			    for(size_type k=0;k<partition_table[i][j].size();++k)
 			    {
@@ -166,10 +172,23 @@ namespace Camgen
 			    std::sort(partition_table[i][j].begin(),partition_table[i][j].end());
 			}
 		    }
+		    sorted_lvl=max_lvl;
 		    sorted=true;
 		}
 	    }
 
+	    /* Thread-safe initialisation and sorting up to the argument level: */
+
+	    static void prepare(size_type lvl=N)
+	    {
+#if __cplusplus >= 201103L
+		static std::mutex table_mutex;
+		std::lock_guard<std::mutex>lock(table_mutex);
+#endif
+		initialise(lvl);
+		sort();
+	    }
+
 	    /* Print the number of partitions in all lower-triangle table
 	     * entries: */
 
@@ -278,12 +297,17 @@ namespace Camgen
 	    
 	    static size_type max_lvl;
 
+	    /* Maximal sorted level: */
+
+	    static size_type sorted_lvl;
+
 	    /* Boolean denoting whether the partitions are sorted: */
 
 	    static bool sorted;
     };
     template<std::size_t N>typename bit_string_partition<N>::partition bit_string_partition<N>::partition_table[N][N];
     template<std::size_t N>typename bit_string_partition<N>::size_type bit_string_partition<N>::max_lvl=0;
+    template<std::size_t N>typename bit_string_partition<N>::size_type bit_string_partition<N>::sorted_lvl=0;
     template<std::size_t N>bool bit_string_partition<N>::sorted=false;
 }
 
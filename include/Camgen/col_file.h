@@ -0,0 +1,440 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file col_file.h
+    \brief Columnar binary event output.
+ */
+
+#ifndef CAMGEN_COL_FILE_H_
+#define CAMGEN_COL_FILE_H_
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Columnar event output class. Every registered branch is stored as its own *
+ * binary column, momentum branches as one column per component. Events are  *
+ * buffered in row groups, and each completed group is written column after  *
+ * column as contiguous blocks. Upon closing, a footer holding the column    *
+ * names and types and the offsets of all column blocks is appended, so that *
+ * readers can load selected columns only (see col_reader.h).                *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <Camgen/bin_io.h>
+#include <Camgen/evt_output.h>
+
+namespace Camgen
+{
+    /// Column data types.
+
+    struct column_types
+    {
+	enum type
+	{
+	    real,
+	    integer,
+	    boolean
+	};
+    };
+
+    /// Columnar file format utilities.
+
+    class column_format
+    {
+	public:
+
+	    /// File header tag.
+
+	    static const char* tag()
+	    {
+		return "Camgen column events";
+	    }
+
+	    /// Format version.
+
+	    static unsigned version()
+	    {
+		return 1;
+	    }
+    };
+
+    /// Columnar binary event output class.
+
+    template<class model_t,std::size_t N_in,std::size_t N_out>class column_file: public event_output<model_t,N_in,N_out>
+    {
+	typedef event_output<model_t,N_in,N_out> base_type;
+
+	public:
+
+	    /* Type definitions: */
+
+	    typedef model_t model_type;
+	    typedef typename base_type::size_type size_type;
+	    typedef typename base_type::value_type value_type;
+	    typedef typename base_type::momentum_type momentum_type;
+
+	    typedef typename std::map<std::string,const momentum_type*>::iterator vector_iterator;
+	    typedef typename std::map<std::string,const value_type*>::iterator value_iterator;
+	    typedef typename std::map<std::string,const int*>::iterator integer_iterator;
+	    typedef typename std::map<std::string,const bool*>::iterator boolean_iterator;
+
+	    /// Constructor with file name argument.
+
+	    column_file(const std::string& file_name_):base_type(file_name_),group_size(4096),rows(0),group_rows(0){}
+
+	    /// Constructor with file name and description arguments.
+
+	    column_file(const std::string& file_name_,const std::string description_):base_type(file_name_,description_),group_size(4096),rows(0),group_rows(0){}
+
+	    /// Destructor.
+
+	    ~column_file()
+	    {
+		close_file();
+	    }
+
+	    /// Creation method implementation.
+
+	    event_output<model_t,N_in,N_out>* create(const std::string& file_name_) const
+	    {
+		column_file<model_t,N_in,N_out>* result=new column_file<model_t,N_in,N_out>(file_name_,this->description);
+		result->set_row_group_size(group_size);
+		return result;
+	    }
+
+	    /// Sets the number of events per row group. Only allowed before the
+	    /// first event is written.
+
+	    bool set_row_group_size(size_type n)
+	    {
+		if(rows!=0 or n==0)
+		{
+		    return false;
+		}
+		group_size=n;
+		return true;
+	    }
+
+	    /// Returns the number of events per row group.
+
+	    size_type row_group_size() const
+	    {
+		return group_size;
+	    }
+
+	    /// Opens the datafile and writes the header.
+
+	    bool open_file()
+	    {
+		std::string fname=this->file_name+".col";
+		ofs.open(fname.c_str(),std::ios::out|std::ios::binary|std::ios::trunc);
+		if(!ofs.is_open())
+		{
+		    return false;
+		}
+		rows=0;
+		group_rows=0;
+		columns.clear();
+		groups.clear();
+		binary_io::write_header(ofs,column_format::tag(),column_format::version());
+		binary_io::write(ofs,(unsigned)sizeof(value_type));
+		binary_io::write_string(ofs,this->description);
+		return ofs.good();
+	    }
+
+	    /// Writes the last row group and the footer and closes the datafile.
+
+	    bool close_file()
+	    {
+		if(!ofs.is_open())
+		{
+		    return true;
+		}
+		write_group();
+		size_type footer=ofs.tellp();
+		binary_io::write(ofs,(size_type)columns.size());
+		for(size_type i=0;i<columns.size();++i)
+		{
+		    binary_io::write_string(ofs,columns[i].name);
+		    binary_io::write(ofs,(unsigned)columns[i].type);
+		}
+		binary_io::write(ofs,(size_type)groups.size());
+		for(size_type g=0;g<groups.size();++g)
+		{
+		    binary_io::write(ofs,groups[g].rows);
+		    for(size_type i=0;i<columns.size();++i)
+		    {
+			binary_io::write(ofs,groups[g].offsets[i]);
+		    }
+		}
+		binary_io::write(ofs,footer);
+		ofs.close();
+		return !(ofs.is_open());
+	    }
+
+	    /// Adds a branch holding a Lorentz vector, stored as one column per
+	    /// component.
+
+	    bool branch(const momentum_type* p,const std::string& varname)
+	    {
+		if(rows!=0)
+		{
+		    return false;
+		}
+		vectors[varname]=p;
+		values.erase(varname);
+		integers.erase(varname);
+		booleans.erase(varname);
+		return true;
+	    }
+
+	    /// Adds a branch holding a floating-point number.
+
+	    bool branch(const value_type* x,const std::string& varname)
+	    {
+		if(rows!=0)
+		{
+		    return false;
+		}
+		vectors.erase(varname);
+		values[varname]=x;
+		integers.erase(varname);
+		booleans.erase(varname);
+		return true;
+	    }
+
+	    /// Adds a branch holding an integer.
+
+	    bool branch(const int* n,const std::string& varname)
+	    {
+		if(rows!=0)
+		{
+		    return false;
+		}
+		vectors.erase(varname);
+		values.erase(varname);
+		integers[varname]=n;
+		booleans.erase(varname);
+		return true;
+	    }
+
+	    /// Adds a branch holding a boolean, stored as one byte.
+
+	    bool branch(const bool* b,const std::string& varname)
+	    {
+		if(rows!=0)
+		{
+		    return false;
+		}
+		vectors.erase(varname);
+		values.erase(varname);
+		integers.erase(varname);
+		booleans[varname]=b;
+		return true;
+	    }
+
+	    /// Appends the branch values to the current row group, and writes
+	    /// the group once it is full.
+
+	    bool write_event()
+	    {
+		if(!ofs.is_open())
+		{
+		    return false;
+		}
+		if(rows==0)
+		{
+		    make_columns();
+		}
+		for(size_type i=0;i<columns.size();++i)
+		{
+		    column& col=columns[i];
+		    switch(col.type)
+		    {
+			case column_types::real:
+			    col.reals.push_back((col.p==NULL)?(*col.x):((*col.p)[col.mu]));
+			    break;
+			case column_types::integer:
+			    col.integers.push_back(*col.n);
+			    break;
+			case column_types::boolean:
+			    col.booleans.push_back((unsigned char)(*col.b));
+			    break;
+		    }
+		}
+		++rows;
+		++group_rows;
+		if(group_rows==group_size)
+		{
+		    write_group();
+		}
+		return ofs.good();
+	    }
+
+	    /// Returns the number of events written.
+
+	    size_type events() const
+	    {
+		return rows;
+	    }
+
+	private:
+
+	    /* Column data, with the branch address and the buffered values of
+	     * the current row group: */
+
+	    struct column
+	    {
+		std::string name;
+		column_types::type type;
+		const momentum_type* p;
+		size_type mu;
+		const value_type* x;
+		const int* n;
+		const bool* b;
+		std::vector<value_type> reals;
+		std::vector<int> integers;
+		std::vector<unsigned char> booleans;
+	    };
+
+	    /* Row group data: */
+
+	    struct row_group
+	    {
+		size_type rows;
+		std::vector<size_type> offsets;
+	    };
+
+	    /* Output file stream: */
+
+	    std::ofstream ofs;
+
+	    /* Number of events per row group: */
+
+	    size_type group_size;
+
+	    /* Number of events written and buffered in the current group: */
+
+	    size_type rows,group_rows;
+
+	    /* Registered branches: */
+
+	    std::map<std::string,const momentum_type*> vectors;
+	    std::map<std::string,const value_type*> values;
+	    std::map<std::string,const int*> integers;
+	    std::map<std::string,const bool*> booleans;
+
+	    /* Columns and written row groups: */
+
+	    std::vector<column> columns;
+	    std::vector<row_group> groups;
+
+	    /* Creates the columns from the registered branches: */
+
+	    void make_columns()
+	    {
+		columns.clear();
+		column col;
+		col.p=NULL;
+		col.mu=0;
+		col.x=NULL;
+		col.n=NULL;
+		col.b=NULL;
+		col.type=column_types::real;
+		for(vector_iterator it=vectors.begin();it!=vectors.end();++it)
+		{
+		    for(size_type mu=0;mu<model_type::dimension;++mu)
+		    {
+			std::stringstream ss;
+			ss<<it->first<<'['<<mu<<']';
+			col.name=ss.str();
+			col.p=it->second;
+			col.mu=mu;
+			columns.push_back(col);
+		    }
+		}
+		col.p=NULL;
+		for(value_iterator it=values.begin();it!=values.end();++it)
+		{
+		    col.name=it->first;
+		    col.x=it->second;
+		    columns.push_back(col);
+		}
+		col.x=NULL;
+		col.type=column_types::integer;
+		for(integer_iterator it=integers.begin();it!=integers.end();++it)
+		{
+		    col.name=it->first;
+		    col.n=it->second;
+		    columns.push_back(col);
+		}
+		col.n=NULL;
+		col.type=column_types::boolean;
+		for(boolean_iterator it=booleans.begin();it!=booleans.end();++it)
+		{
+		    col.name=it->first;
+		    col.b=it->second;
+		    columns.push_back(col);
+		}
+		for(size_type i=0;i<columns.size();++i)
+		{
+		    columns[i].reals.reserve((columns[i].type==column_types::real)?group_size:0);
+		    columns[i].integers.reserve((columns[i].type==column_types::integer)?group_size:0);
+		    columns[i].booleans.reserve((columns[i].type==column_types::boolean)?group_size:0);
+		}
+	    }
+
+	    /* Writes the buffered row group column by column: */
+
+	    void write_group()
+	    {
+		if(group_rows==0)
+		{
+		    return;
+		}
+		row_group group;
+		group.rows=group_rows;
+		group.offsets.resize(columns.size());
+		for(size_type i=0;i<columns.size();++i)
+		{
+		    column& col=columns[i];
+		    group.offsets[i]=ofs.tellp();
+		    switch(col.type)
+		    {
+			case column_types::real:
+			    write_block(col.reals);
+			    break;
+			case column_types::integer:
+			    write_block(col.integers);
+			    break;
+			case column_types::boolean:
+			    write_block(col.booleans);
+			    break;
+		    }
+		}
+		groups.push_back(group);
+		group_rows=0;
+	    }
+
+	    /* Writes the buffered values as a contiguous block and clears the
+	     * buffer: */
+
+	    template<class T>void write_block(std::vector<T>& data)
+	    {
+		if(!data.empty())
+		{
+		    ofs.write(reinterpret_cast<const char*>(&data[0]),data.size()*sizeof(T));
+		}
+		data.clear();
+	    }
+    };
+}
+
+#endif /*CAMGEN_COL_FILE_H_*/
+
@@ -140,6 +140,15 @@ namespace Camgen
 		return false;
 	    }
 
+	    /// Returns whether the process/event generator classes should
+	    /// evaluate the colour sum by the colour-ordered recursion.
+	    /// Returns false by default.
+
+	    virtual bool colour_ordered() const
+	    {
+		return false;
+	    }
+
 	    /// Returns the initial state colours averaging factor.
 
 	    value_type averaging_factor() const
@@ -400,6 +409,15 @@ namespace Camgen
 		return false;
 	    }
 
+	    /// Returns whether the process/event generator classes should
+	    /// evaluate the colour sum by the colour-ordered recursion.
+	    /// Returns false by default.
+
+	    virtual bool colour_ordered() const
+	    {
+		return false;
+	    }
+
 	    /// Returns the initial state colours averaging factor.
 
 	    value_type averaging_factor() const
@@ -650,6 +668,73 @@ namespace Camgen
 	    }
     };
     template<class value_t,std::size_t N_in,std::size_t N_out>const std::size_t colour_summer<value_t,N_in,N_out,true>::N_tot;
+
+    /// Colour-ordered summing dummy class. Signals a full colour sum of the
+    /// amplitude in process/event generator instances, evaluated by the
+    /// colour-ordered recursion for pure-gluon processes and by the explicit
+    /// colour sum otherwise.
+
+    template<class value_t,std::size_t N_in,std::size_t N_out,bool cont_cols>class colour_ordered_summer: public colour_summer<value_t,N_in,N_out,cont_cols>
+    {
+	public:
+
+	    /* Type definitions: */
+	    /*-------------------*/
+
+	    typedef colour_summer<value_t,N_in,N_out,cont_cols> base_type;
+
+	    /* Public static methods: */
+	    /*------------------------*/
+
+	    /* Factory method: */
+
+	    template<class model_t>static colour_ordered_summer<value_t,N_in,N_out,cont_cols>* create_instance(typename CM_algorithm<model_t,N_in,N_out>::tree_iterator it)
+	    {
+		base_type* summer=base_type::template create_instance<model_t>(it);
+		colour_ordered_summer<value_t,N_in,N_out,cont_cols>* result=new colour_ordered_summer<value_t,N_in,N_out,cont_cols>(*summer);
+		delete summer;
+		return result;
+	    }
+
+	    /* Public constructors: */
+	    /*----------------------*/
+
+	    /* Constructor from a colour summer: */
+
+	    colour_ordered_summer(const base_type& other):base_type(other){}
+
+	    /* Public const methods: */
+	    /*-----------------------*/
+
+	    /* Cloning method: */
+
+	    colour_ordered_summer<value_t,N_in,N_out,cont_cols>* clone() const
+	    {
+		return new colour_ordered_summer<value_t,N_in,N_out,cont_cols>(*this);
+	    }
+
+	    /* Colour summation flags set: */
+
+	    bool sum_colour(int i) const
+	    {
+		return true;
+	    }
+
+	    /* Colour-ordered evaluation flag set: */
+
+	    bool colour_ordered() const
+	    {
+		return true;
+	    }
+
+	    /* Serialization: */
+	    /*----------------*/
+
+	    std::string type() const
+	    {
+		return "colour-ordered sum";
+	    }
+    };
 }
 
 #endif /*CAMGEN_COL_GEN_H_*/
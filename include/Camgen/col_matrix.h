@@ -0,0 +1,941 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file col_matrix.h
+    \brief colour-ordered basis and colour matrix for multi-gluon amplitudes.
+ */
+
+#ifndef CAMGEN_COL_MATRIX_H_
+#define CAMGEN_COL_MATRIX_H_
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <complex>
+#include <fstream>
+#include <map>
+#include <bitset>
+#include <Camgen/CM_algo.h>
+#include <Camgen/vvv.h>
+#include <Camgen/vvvv.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Declaration and definition of the colour_matrix and colour_matrix_algorithm   *
+ * class templates. For n external gluons, the colour-flow amplitude decomposes *
+ * into the (n-1)! colour-ordered partial amplitudes A_s multiplying the chains *
+ * of Kronecker deltas d(i_s1,j_s2)...d(i_sn,j_s1). Summing the squared          *
+ * amplitude over colours yields sum_st conj(A_s) C_st A_t, where the colour     *
+ * matrix entry C_st equals N_c raised to the number of closed index loops. By  *
+ * the Kleiss-Kuijf relations, all partial amplitudes are signed sums of the    *
+ * (n-2)! amplitudes with the first gluon first and the last gluon last, so the *
+ * matrix is folded into this basis as well. The colour_matrix class computes   *
+ * both matrices once, and may store them to and read them from a cache file.   *
+ * The colour_matrix_algorithm class computes the basis amplitudes of a         *
+ * pure-gluon process by a Berends-Giele recursion over ordered gluon subsets   *
+ * with the triple- and four-gluon vertices of the QCD models, sharing the      *
+ * off-shell currents between the basis orderings, and contracts them with the  *
+ * matrix. It does not depend on the colour treatment of the model, and serves  *
+ * as the colour_ordered colour generator mode of the process generators.       *
+ *                                                                              *
+ * Limitations: only pure-gluon processes in four dimensions are handled, the   *
+ * cost per helicity configuration still grows with the (n-2)! basis size, and  *
+ * the number of gluons is capped by colour_matrix_algorithm::max_gluons.       *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+namespace Camgen
+{
+    /// Colour matrix class template for the colour-ordered basis of n gluons.
+    /// The template parameter denotes the (real) value type of the matrix
+    /// entries.
+
+    template<class value_t>class colour_matrix
+    {
+	public:
+
+	    /* Type definitions: */
+
+	    typedef value_t value_type;
+	    typedef std::size_t size_type;
+
+	    /* Cache file format version: */
+
+	    static const int file_version=2;
+
+	    /// Constructor with the number of gluons and the number of colours.
+
+	    colour_matrix(size_type n_,const value_type& N_c_):n(n_),N_c(N_c_)
+	    {
+		construct();
+	    }
+
+	    /// Constructor with the number of gluons, the number of colours and
+	    /// a cache file name. If the file contains the matrix for the same
+	    /// gluon and colour numbers, it is read, otherwise the matrix is
+	    /// computed and written to the file.
+
+	    colour_matrix(size_type n_,const value_type& N_c_,const std::string& filename):n(n_),N_c(N_c_)
+	    {
+		if(!load(filename))
+		{
+		    construct();
+		    save(filename);
+		}
+	    }
+
+	    /// Returns the number of gluons.
+
+	    size_type gluons() const
+	    {
+		return n;
+	    }
+
+	    /// Returns the number of colours.
+
+	    const value_type& colours() const
+	    {
+		return N_c;
+	    }
+
+	    /// Returns the number of colour orderings, i.e. the dimension of the
+	    /// matrix.
+
+	    size_type size() const
+	    {
+		return orderings.size();
+	    }
+
+	    /// Returns the i-th colour ordering of the gluon labels. The first
+	    /// gluon is fixed in all orderings.
+
+	    const std::vector<size_type>& ordering(size_type i) const
+	    {
+		return orderings[i];
+	    }
+
+	    /// Returns the (i,j)-th colour matrix entry.
+
+	    const value_type& operator () (size_type i,size_type j) const
+	    {
+		return entries[i*orderings.size()+j];
+	    }
+
+	    /// Returns the number of Kleiss-Kuijf basis orderings, which have
+	    /// the last gluon in the last position.
+
+	    size_type basis_size() const
+	    {
+		return basis.size();
+	    }
+
+	    /// Returns the i-th Kleiss-Kuijf basis ordering.
+
+	    const std::vector<size_type>& basis_ordering(size_type i) const
+	    {
+		return orderings[basis[i]];
+	    }
+
+	    /// Returns the (i,j)-th entry of the colour matrix in the
+	    /// Kleiss-Kuijf basis.
+
+	    const value_type& basis_entry(size_type i,size_type j) const
+	    {
+		return basis_entries[i*basis.size()+j];
+	    }
+
+	    /// Contracts the argument vector of partial amplitudes with the
+	    /// colour matrix, returning the colour-summed squared amplitude.
+
+	    template<class complex_t>value_type contract(const std::vector<complex_t>& A) const
+	    {
+		size_type m=orderings.size();
+		value_type result=0;
+		typename std::vector<value_type>::const_iterator it=entries.begin();
+		for(size_type i=0;i<m;++i)
+		{
+		    complex_t z(0,0);
+		    for(size_type j=0;j<m;++j)
+		    {
+			z+=(*it)*A[j];
+			++it;
+		    }
+		    result+=(std::conj(A[i])*z).real();
+		}
+		return result;
+	    }
+
+	    /// Contracts the argument vector of Kleiss-Kuijf basis amplitudes
+	    /// with the colour matrix in this basis, returning the colour-summed
+	    /// squared amplitude.
+
+	    template<class complex_t>value_type contract_basis(const std::vector<complex_t>& A) const
+	    {
+		size_type m=basis.size();
+		value_type result=0;
+		typename std::vector<value_type>::const_iterator it=basis_entries.begin();
+		for(size_type i=0;i<m;++i)
+		{
+		    complex_t z(0,0);
+		    for(size_type j=0;j<m;++j)
+		    {
+			z+=(*it)*A[j];
+			++it;
+		    }
+		    result+=(std::conj(A[i])*z).real();
+		}
+		return result;
+	    }
+
+	    /// Writes the colour matrix to the argument stream.
+
+	    std::ostream& write(std::ostream& os) const
+	    {
+		os<<"colour_matrix "<<file_version<<" "<<n<<" "<<N_c<<" "<<orderings.size()<<" "<<basis.size()<<std::endl;
+		for(size_type i=0;i<orderings.size();++i)
+		{
+		    for(size_type k=0;k<n;++k)
+		    {
+			os<<orderings[i][k]<<" ";
+		    }
+		    os<<std::endl;
+		}
+		for(size_type i=0;i<orderings.size();++i)
+		{
+		    for(size_type j=0;j<orderings.size();++j)
+		    {
+			os<<entries[i*orderings.size()+j]<<" ";
+		    }
+		    os<<std::endl;
+		}
+		for(size_type i=0;i<basis.size();++i)
+		{
+		    os<<basis[i]<<" ";
+		}
+		os<<std::endl;
+		for(size_type i=0;i<basis.size();++i)
+		{
+		    for(size_type j=0;j<basis.size();++j)
+		    {
+			os<<basis_entries[i*basis.size()+j]<<" ";
+		    }
+		    os<<std::endl;
+		}
+		return os;
+	    }
+
+	    /// Reads the colour matrix from the argument stream. Sets the
+	    /// failbit if the header does not match the gluon and colour numbers.
+
+	    std::istream& read(std::istream& is)
+	    {
+		std::string tag;
+		int version;
+		size_type n_,m,b;
+		value_type N_c_;
+		is>>tag>>version>>n_>>N_c_>>m>>b;
+		if(!is or tag!="colour_matrix" or version!=file_version or n_!=n or N_c_!=N_c)
+		{
+		    is.setstate(std::ios::failbit);
+		    return is;
+		}
+		std::vector< std::vector<size_type> >ords(m,std::vector<size_type>(n));
+		for(size_type i=0;i<m;++i)
+		{
+		    for(size_type k=0;k<n;++k)
+		    {
+			is>>ords[i][k];
+		    }
+		}
+		std::vector<value_type>ents(m*m);
+		for(size_type i=0;i<m*m;++i)
+		{
+		    is>>ents[i];
+		}
+		std::vector<size_type>bas(b);
+		for(size_type i=0;i<b;++i)
+		{
+		    is>>bas[i];
+		    if(bas[i]>=m)
+		    {
+			is.setstate(std::ios::failbit);
+			return is;
+		    }
+		}
+		std::vector<value_type>bents(b*b);
+		for(size_type i=0;i<b*b;++i)
+		{
+		    is>>bents[i];
+		}
+		if(is)
+		{
+		    orderings.swap(ords);
+		    entries.swap(ents);
+		    basis.swap(bas);
+		    basis_entries.swap(bents);
+		}
+		return is;
+	    }
+
+	    /// Writes the colour matrix to the file with the argument name.
+
+	    bool save(const std::string& filename) const
+	    {
+		std::ofstream ofs(filename.c_str());
+		if(!ofs.is_open())
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"could not open colour matrix cache file "<<filename<<" for writing"<<endlog;
+		    return false;
+		}
+		ofs.precision(17);
+		write(ofs);
+		return true;
+	    }
+
+	    /// Reads the colour matrix from the file with the argument name.
+	    /// Returns false if the file is absent or does not hold the matrix
+	    /// for the same gluon and colour numbers.
+
+	    bool load(const std::string& filename)
+	    {
+		std::ifstream ifs(filename.c_str());
+		if(!ifs.is_open())
+		{
+		    return false;
+		}
+		return (bool)read(ifs);
+	    }
+
+	private:
+
+	    /* Number of gluons: */
+
+	    size_type n;
+
+	    /* Number of colours: */
+
+	    value_type N_c;
+
+	    /* Colour orderings: */
+
+	    std::vector< std::vector<size_type> >orderings;
+
+	    /* Matrix entries, row-major: */
+
+	    std::vector<value_type>entries;
+
+	    /* Indices of the Kleiss-Kuijf basis orderings: */
+
+	    std::vector<size_type>basis;
+
+	    /* Matrix entries in the Kleiss-Kuijf basis, row-major: */
+
+	    std::vector<value_type>basis_entries;
+
+	    /* Enumerates the orderings and computes the matrix entries: */
+
+	    void construct()
+	    {
+		orderings.clear();
+		if(n==0)
+		{
+		    return;
+		}
+		std::vector<size_type>ord(n);
+		for(size_type k=0;k<n;++k)
+		{
+		    ord[k]=k;
+		}
+		do
+		{
+		    orderings.push_back(ord);
+		}
+		while(std::next_permutation(ord.begin()+1,ord.end()));
+
+		size_type m=orderings.size();
+		entries.resize(m*m);
+		for(size_type i=0;i<m;++i)
+		{
+		    for(size_type j=i;j<m;++j)
+		    {
+			value_type c=1;
+			for(size_type l=loops(orderings[i],orderings[j]);l>0;--l)
+			{
+			    c*=N_c;
+			}
+			entries[i*m+j]=c;
+			entries[j*m+i]=c;
+		    }
+		}
+		construct_basis();
+	    }
+
+	    /* Expresses all orderings in the Kleiss-Kuijf basis,
+	     * A(0,a,n-1,b) = (-1)^|b| sum_{s in a shuffled with reversed b} A(0,s,n-1),
+	     * and folds the colour matrix into the basis: */
+
+	    void construct_basis()
+	    {
+		size_type m=orderings.size();
+		basis.clear();
+		std::map<std::vector<size_type>,size_type>basis_index;
+		for(size_type i=0;i<m;++i)
+		{
+		    if(n<3 or orderings[i][n-1]==n-1)
+		    {
+			basis_index[orderings[i]]=basis.size();
+			basis.push_back(i);
+		    }
+		}
+		size_type b=basis.size();
+
+		/* Signed basis decompositions of the orderings: */
+
+		std::vector< std::vector< std::pair<size_type,int> > >decomps(m);
+		for(size_type i=0;i<m;++i)
+		{
+		    const std::vector<size_type>& ord=orderings[i];
+		    if(n<3 or ord[n-1]==n-1)
+		    {
+			decomps[i].push_back(std::pair<size_type,int>(basis_index[ord],1));
+			continue;
+		    }
+		    size_type pos=std::find(ord.begin(),ord.end(),n-1)-ord.begin();
+		    std::vector<size_type>alpha(ord.begin()+1,ord.begin()+pos);
+		    std::vector<size_type>beta(ord.rbegin(),ord.rend()-pos-1);
+		    int sign=(beta.size()%2==0)?1:-1;
+
+		    /* Enumerates the shuffles by the positions taken by alpha: */
+
+		    size_type k=alpha.size()+beta.size();
+		    std::vector<bool>from_alpha(k,false);
+		    std::fill(from_alpha.begin(),from_alpha.begin()+alpha.size(),true);
+		    do
+		    {
+			std::vector<size_type>shuffle(n);
+			shuffle[0]=0;
+			shuffle[n-1]=n-1;
+			size_type ia=0,ib=0;
+			for(size_type l=0;l<k;++l)
+			{
+			    shuffle[l+1]=from_alpha[l]?alpha[ia++]:beta[ib++];
+			}
+			decomps[i].push_back(std::pair<size_type,int>(basis_index[shuffle],sign));
+		    }
+		    while(std::prev_permutation(from_alpha.begin(),from_alpha.end()));
+		}
+
+		/* Folds the matrix, C'=K^T.C.K with K the decomposition matrix: */
+
+		std::vector<value_type>CK(m*b,(value_type)0);
+		for(size_type i=0;i<m;++i)
+		{
+		    for(size_type j=0;j<m;++j)
+		    {
+			const value_type& c=entries[i*m+j];
+			for(size_type l=0;l<decomps[j].size();++l)
+			{
+			    CK[i*b+decomps[j][l].first]+=decomps[j][l].second*c;
+			}
+		    }
+		}
+		basis_entries.assign(b*b,(value_type)0);
+		for(size_type i=0;i<m;++i)
+		{
+		    for(size_type l=0;l<decomps[i].size();++l)
+		    {
+			size_type a=decomps[i][l].first;
+			int sign=decomps[i][l].second;
+			for(size_type c=0;c<b;++c)
+			{
+			    basis_entries[a*b+c]+=sign*CK[i*b+c];
+			}
+		    }
+		}
+	    }
+
+	    /* Counts the closed index loops in the product of the delta chain
+	     * of the first ordering with the conjugate chain of the second,
+	     * i.e. the number of cycles of the permutation mapping the gluon
+	     * preceding h in the first ordering to its successor in the
+	     * second: */
+
+	    size_type loops(const std::vector<size_type>& s,const std::vector<size_type>& t) const
+	    {
+		std::vector<size_type>prev(n),next(n);
+		for(size_type k=0;k<n;++k)
+		{
+		    prev[s[k]]=s[(k+n-1)%n];
+		    next[t[k]]=t[(k+1)%n];
+		}
+		std::vector<bool>visited(n,false);
+		size_type result=0;
+		for(size_type h=0;h<n;++h)
+		{
+		    if(!visited[h])
+		    {
+			++result;
+			for(size_type g=h;!visited[g];g=next[prev[g]])
+			{
+			    visited[g]=true;
+			}
+		    }
+		}
+		return result;
+	    }
+    };
+    template<class value_t>const int colour_matrix<value_t>::file_version;
+
+    /// Colour-ordered amplitude evaluation class template for pure-gluon
+    /// processes. Takes as template arguments the model type, which should
+    /// contain the triple-gluon vertex of the QCD models, and the numbers of
+    /// incoming and outgoing particles, which should all be gluons. The
+    /// Kleiss-Kuijf basis amplitudes are obtained from one Berends-Giele
+    /// recursion over the ordered gluon subsets, in which the off-shell
+    /// currents are shared between the basis orderings. The number of gluons
+    /// is limited to max_gluons.
+
+    template<class model_t,std::size_t N_in,std::size_t N_out>class colour_matrix_algorithm
+    {
+	public:
+
+	    /* Type definitions: */
+
+	    typedef typename model_t::value_type r_value_type;
+	    typedef std::complex<r_value_type> value_type;
+	    typedef std::size_t size_type;
+	    typedef tensor<value_type> tensor_type;
+	    typedef typename tensor_type::iterator iterator;
+	    typedef vector<r_value_type,model_t::dimension> momentum_type;
+
+	    /* Amplitude algorithm type definitions: */
+
+	    typedef CM_algorithm<model_t,N_in,N_out> algorithm_type;
+	    typedef typename algorithm_type::tree_iterator tree_iterator;
+	    typedef typename algorithm_type::phase_space_type phase_space_type;
+
+	    /* Colour matrix type definition: */
+
+	    typedef colour_matrix<r_value_type> matrix_type;
+
+	    /* Number of external particles: */
+
+	    static const std::size_t N_external=N_in+N_out;
+
+	    /// Maximal number of gluons for which the colour matrix is
+	    /// constructed (default 7).
+
+	    static std::size_t max_gluons;
+
+	    /// Constructor with the constructed amplitude algorithm, the number
+	    /// of colours in the colour matrix and an optional cache file name.
+	    /// The current subprocess of the algorithm is evaluated.
+
+	    colour_matrix_algorithm(algorithm_type& algo_,const r_value_type& N_c=3,const std::string& filename=std::string()):algo(&algo_),matrix(NULL),cubic_coupling(NULL),gluon(NULL)
+	    {
+		construct(N_c,filename);
+	    }
+
+	    /// Constructor with the process tree iterator, the number of
+	    /// colours in the colour matrix and an optional cache file name.
+
+	    colour_matrix_algorithm(tree_iterator tree_,const r_value_type& N_c=3,const std::string& filename=std::string()):algo(NULL),tree(tree_),matrix(NULL),cubic_coupling(NULL),gluon(NULL)
+	    {
+		construct(N_c,filename);
+	    }
+
+	    /// Destructor.
+
+	    ~colour_matrix_algorithm()
+	    {
+		delete matrix;
+	    }
+
+	    /// Returns whether the subprocess admits the colour-ordered
+	    /// evaluation.
+
+	    bool valid() const
+	    {
+		return (matrix!=NULL);
+	    }
+
+	    /// Returns the colour matrix.
+
+	    const matrix_type* get_colour_matrix() const
+	    {
+		return matrix;
+	    }
+
+	    /// Returns the Kleiss-Kuijf basis amplitudes of the last evaluated
+	    /// helicity configuration, normalised as the colour-flow partial
+	    /// amplitudes.
+
+	    const std::vector<value_type>& get_partial_amplitudes() const
+	    {
+		return partial_amplitudes;
+	    }
+
+	    /// Computes the colour-ordered basis amplitudes for the current
+	    /// momenta and helicities and returns the colour-summed squared
+	    /// amplitude, normalised as CM_algorithm::evaluate_colour_sum().
+
+	    r_value_type evaluate()
+	    {
+		return evaluate(std::bitset<N_in+N_out>());
+	    }
+
+	    /// Returns the colour-summed squared amplitude, summed over the
+	    /// helicities of the gluons flagged in the argument.
+
+	    r_value_type evaluate(const std::bitset<N_in+N_out>& summed_spins)
+	    {
+		if(matrix==NULL)
+		{
+		    return (r_value_type)0;
+		}
+		for(size_type k=0;k<N_external;++k)
+		{
+		    phase_space_type* ps=get_phase_space(k);
+		    ps->copy_momentum(leg_momenta[k]);
+		    std::vector<tensor_type>& states=wave_functions[k];
+		    states.resize(1);
+		    if(!summed_spins[k])
+		    {
+			ps->phase_space_type::helicity_base_type::fill_wave_function(states[0].reset().begin());
+			continue;
+		    }
+		    ps->phase_space_type::helicity_base_type::init_sum_wave_function(states[0].begin());
+		    while(true)
+		    {
+			states.push_back(states.back());
+			ps->phase_space_type::helicity_base_type::sum_wave_function(states.back().begin());
+			if(ps->minimal_helicity())
+			{
+			    states.pop_back();
+			    break;
+			}
+		    }
+		}
+		quartic_coupling=value_type(0,-1)*(*cubic_coupling)*(*cubic_coupling);
+		std::vector<size_type>h(N_external,0);
+		r_value_type result=0;
+		do
+		{
+		    evaluate_partial_amplitudes(h);
+		    result+=matrix->contract_basis(partial_amplitudes);
+		}
+		while(next_helicities(h));
+		return norm_factor*result;
+	    }
+
+	private:
+
+	    /* Spacetime type definition: */
+
+	    typedef typename get_spacetime_type<model_t>::type spacetime_type;
+
+	    /* Ordered subset of the first N_external-1 gluons, with the
+	     * decompositions into two and three consecutive subsets: */
+
+	    struct word
+	    {
+		size_type leg;
+		bool propagated;
+		std::vector<size_type>cubic,quartic;
+	    };
+
+	    /* Amplitude algorithm, or zero if constructed from a tree: */
+
+	    algorithm_type* algo;
+
+	    /* Process tree iterator: */
+
+	    tree_iterator tree;
+
+	    /* Colour matrix: */
+
+	    matrix_type* matrix;
+
+	    /* Partial amplitudes: */
+
+	    std::vector<value_type>partial_amplitudes;
+
+	    /* Normalisation factor of the colour-flow gluon states: */
+
+	    r_value_type norm_factor;
+
+	    /* Phase relating the colour-ordered currents to the colour-flow
+	     * partial amplitudes: */
+
+	    value_type phase;
+
+	    /* Triple-gluon coupling address and four-gluon coupling: */
+
+	    const value_type* cubic_coupling;
+	    value_type quartic_coupling;
+
+	    /* Gluon particle type: */
+
+	    const particle<model_t>* gluon;
+
+	    /* Words in order of evaluation, and the word index of each basis
+	     * ordering: */
+
+	    std::vector<word>words;
+	    std::vector<size_type>basis_words;
+
+	    /* Off-shell currents and momenta of the words: */
+
+	    std::vector<tensor_type>currents;
+	    std::vector<momentum_type>momenta;
+
+	    /* External momenta and wave functions of the summed helicity
+	     * states: */
+
+	    std::vector<momentum_type>leg_momenta;
+	    std::vector< std::vector<tensor_type> >wave_functions;
+
+	    /* Returns the phase space of the k-th gluon: */
+
+	    phase_space_type* get_phase_space(size_type k)
+	    {
+		return (algo==NULL)?(tree->get_phase_space(k)):(algo->get_phase_space(k));
+	    }
+
+	    /* Checks the subprocess, constructs the colour matrix and
+	     * compiles the recursion: */
+
+	    void construct(const r_value_type& N_c,const std::string& filename)
+	    {
+		if(N_external>max_gluons)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"colour-ordered evaluation of "<<N_external<<" gluons exceeds the maximum of "<<max_gluons<<" gluons--no matrix constructed"<<endlog;
+		    return;
+		}
+		if(N_external<3 or get_phase_space(0)==NULL)
+		{
+		    return;
+		}
+		const particle<model_t>* phi=get_phase_space(0)->particle_type;
+		for(size_type k=1;k<N_external;++k)
+		{
+		    const phase_space_type* ps=get_phase_space(k);
+		    if(ps==NULL or ps->particle_type!=phi)
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"colour-ordered evaluation requires gluons only--no matrix constructed"<<endlog;
+			return;
+		    }
+		}
+		for(size_type n=0;n<model_wrapper<model_t>::vertices();++n)
+		{
+		    const typename model_wrapper<model_t>::vertex_type* V=model_wrapper<model_t>::get_vertex(n);
+		    if(V->get_rank()!=3 or V->get_leg(0)!=phi or V->get_leg(1)!=phi or V->get_leg(2)!=phi or V->nr_of_couplings()!=1)
+		    {
+			continue;
+		    }
+		    std::string rule=V->get_Feynman_rule();
+		    const std::string& vvv_rule=vvv<model_t>::formula;
+		    if(rule.size()>=vvv_rule.size() and rule.compare(rule.size()-vvv_rule.size(),vvv_rule.size(),vvv_rule)==0)
+		    {
+			cubic_coupling=V->get_couplings()[0];
+			break;
+		    }
+		}
+		if(cubic_coupling==NULL)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"colour-ordered evaluation requires the triple-gluon vertex--no matrix constructed"<<endlog;
+		    return;
+		}
+		gluon=phi;
+
+		/* Normalisation of the colour-flow partial amplitudes,
+		 * 2i^(n-2) times the Berends-Giele amplitude: */
+
+		norm_factor=1;
+		phase=value_type(2,0);
+		for(size_type k=0;k<N_external;++k)
+		{
+		    norm_factor*=(r_value_type)0.5;
+		    if(k>=2)
+		    {
+			phase*=value_type(0,1);
+		    }
+		}
+		matrix=filename.empty()?new matrix_type(N_external,N_c):new matrix_type(N_external,N_c,filename);
+		partial_amplitudes.assign(matrix->basis_size(),value_type(0,0));
+
+		/* Compiles the recursion over the words of the basis
+		 * orderings with the last gluon removed: */
+
+		std::map<std::vector<size_type>,size_type>index;
+		basis_words.resize(matrix->basis_size());
+		for(size_type b=0;b<matrix->basis_size();++b)
+		{
+		    const std::vector<size_type>& ord=matrix->basis_ordering(b);
+		    basis_words[b]=insert_word(std::vector<size_type>(ord.begin(),ord.end()-1),index);
+		}
+		tensor_type J(std::vector<size_type>(1,model_t::dimension));
+		currents.assign(words.size(),J);
+		momenta.resize(words.size());
+		leg_momenta.resize(N_external);
+		wave_functions.assign(N_external,std::vector<tensor_type>(1,J));
+	    }
+
+	    /* Inserts the argument word and its subwords, returning its index:
+	     * */
+
+	    size_type insert_word(const std::vector<size_type>& w,std::map<std::vector<size_type>,size_type>& index)
+	    {
+		typename std::map<std::vector<size_type>,size_type>::const_iterator it=index.find(w);
+		if(it!=index.end())
+		{
+		    return it->second;
+		}
+		size_type l=w.size();
+		word W;
+		W.leg=(l==1)?w[0]:N_external;
+		W.propagated=(l>1 and l<N_external-1);
+		for(size_type i=1;i<l;++i)
+		{
+		    W.cubic.push_back(insert_word(std::vector<size_type>(w.begin(),w.begin()+i),index));
+		    W.cubic.push_back(insert_word(std::vector<size_type>(w.begin()+i,w.end()),index));
+		    for(size_type j=i+1;j<l;++j)
+		    {
+			W.quartic.push_back(insert_word(std::vector<size_type>(w.begin(),w.begin()+i),index));
+			W.quartic.push_back(insert_word(std::vector<size_type>(w.begin()+i,w.begin()+j),index));
+			W.quartic.push_back(insert_word(std::vector<size_type>(w.begin()+j,w.end()),index));
+		    }
+		}
+		index[w]=words.size();
+		words.push_back(W);
+		return words.size()-1;
+	    }
+
+	    /* Evaluates the basis amplitudes for the argument helicity
+	     * configuration: */
+
+	    void evaluate_partial_amplitudes(const std::vector<size_type>& h)
+	    {
+		const value_type one(1,0);
+		const value_type* c3=cubic_coupling;
+		const value_type* c4=&quartic_coupling;
+		iterator iters[4];
+		const momentum_type* p[4];
+		for(size_type w=0;w<words.size();++w)
+		{
+		    const word& W=words[w];
+		    if(W.leg<N_external)
+		    {
+			currents[w]=wave_functions[W.leg][h[W.leg]];
+			momenta[w]=leg_momenta[W.leg];
+			continue;
+		    }
+		    momenta[w]=momenta[W.cubic[0]];
+		    momenta[w]+=momenta[W.cubic[1]];
+		    iters[0]=currents[w].reset().begin();
+		    p[0]=&momenta[w];
+		    for(size_type i=0;i<W.cubic.size();i+=2)
+		    {
+			for(size_type j=0;j<2;++j)
+			{
+			    iters[j+1]=currents[W.cubic[i+j]].begin();
+			    p[j+1]=&momenta[W.cubic[i+j]];
+			}
+			Camgen::evaluate< vvv<model_t> >::first(one,&c3,iters,p);
+		    }
+		    for(size_type i=0;i<W.quartic.size();i+=3)
+		    {
+			for(size_type j=0;j<3;++j)
+			{
+			    iters[j+1]=currents[W.quartic[i+j]].begin();
+			    p[j+1]=&momenta[W.quartic[i+j]];
+			}
+			Camgen::evaluate< vvvv<model_t> >::first(one,&c4,iters,p);
+		    }
+		    if(W.propagated)
+		    {
+			gluon->refresh_propagator(&momenta[w]);
+			gluon->propagate(currents[w].begin());
+		    }
+		}
+		iterator eps=wave_functions[N_external-1][h[N_external-1]].begin();
+		for(size_type b=0;b<basis_words.size();++b)
+		{
+		    partial_amplitudes[b]=phase*spacetime_type::dot(currents[basis_words[b]].begin(),eps);
+		}
+	    }
+
+	    /* Advances the argument helicity configuration, returns false
+	     * when all configurations have been visited: */
+
+	    bool next_helicities(std::vector<size_type>& h) const
+	    {
+		for(size_type k=0;k<N_external;++k)
+		{
+		    if(++h[k]<wave_functions[k].size())
+		    {
+			return true;
+		    }
+		    h[k]=0;
+		}
+		return false;
+	    }
+    };
+    template<class model_t,std::size_t N_in,std::size_t N_out>const std::size_t colour_matrix_algorithm<model_t,N_in,N_out>::N_external;
+    template<class model_t,std::size_t N_in,std::size_t N_out>std::size_t colour_matrix_algorithm<model_t,N_in,N_out>::max_gluons=7;
+
+    /// Colour-ordered algorithm factory for coloured models, constructing
+    /// the colour matrix with the number of colours of the model.
+
+    template<class model_t,std::size_t N_in,std::size_t N_out,bool q=model_t::coloured>class colour_matrix_algorithm_factory
+    {
+	public:
+
+	    typedef colour_matrix_algorithm<model_t,N_in,N_out> algorithm_type;
+
+	    /// Returns a new colour-ordered algorithm for the argument tree if
+	    /// the subprocess admits it, and zero otherwise.
+
+	    static algorithm_type* create_algorithm(typename CM_algorithm<model_t,N_in,N_out>::tree_iterator it)
+	    {
+		algorithm_type* result=new algorithm_type(it,(typename model_t::value_type)model_t::N_c);
+		if(!result->valid())
+		{
+		    delete result;
+		    return NULL;
+		}
+		return result;
+	    }
+    };
+
+    /// Colour-ordered algorithm factory specialisation for uncoloured models:
+    /// always returns zero pointers.
+
+    template<class model_t,std::size_t N_in,std::size_t N_out>class colour_matrix_algorithm_factory<model_t,N_in,N_out,false>
+    {
+	public:
+
+	    /* Placeholder algorithm type, never constructed: */
+
+	    class algorithm_type
+	    {
+		public:
+
+		    typename model_t::value_type evaluate(const std::bitset<N_in+N_out>& summed_spins)
+		    {
+			return 0;
+		    }
+	    };
+
+	    static algorithm_type* create_algorithm(typename CM_algorithm<model_t,N_in,N_out>::tree_iterator it)
+	    {
+		return NULL;
+	    }
+    };
+}
+
+#endif /*CAMGEN_COL_MATRIX_H_*/
+
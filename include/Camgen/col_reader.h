@@ -0,0 +1,294 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file col_reader.h
+    \brief Reader of columnar binary event files.
+ */
+
+#ifndef CAMGEN_COL_READER_H_
+#define CAMGEN_COL_READER_H_
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Reader of the columnar event files written by column_file. Opening a file *
+ * only reads the header and the footer index; column data is read on        *
+ * request, per column and optionally per row group, so that unused columns  *
+ * are never touched.                                                        *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <Camgen/col_file.h>
+
+namespace Camgen
+{
+    /// Columnar event file reader, with the floating-point type of the
+    /// written events as template argument.
+
+    template<class value_t>class column_reader
+    {
+	public:
+
+	    /* Type definitions: */
+
+	    typedef value_t value_type;
+	    typedef std::size_t size_type;
+
+	    /// Constructor, opening the argument file (including extension).
+
+	    column_reader(const std::string& file_name_):file_name(file_name_),n_rows(0)
+	    {
+		open();
+	    }
+
+	    /// File name.
+
+	    const std::string file_name;
+
+	    /// Returns whether the file was opened and its index read
+	    /// successfully.
+
+	    bool is_open() const
+	    {
+		return ifs.is_open();
+	    }
+
+	    /// Returns the file description.
+
+	    const std::string& description() const
+	    {
+		return descr;
+	    }
+
+	    /// Returns the number of events.
+
+	    size_type rows() const
+	    {
+		return n_rows;
+	    }
+
+	    /// Returns the number of columns.
+
+	    size_type columns() const
+	    {
+		return names.size();
+	    }
+
+	    /// Returns the name of the i-th column.
+
+	    const std::string& column_name(size_type i) const
+	    {
+		return names[i];
+	    }
+
+	    /// Returns the type of the i-th column.
+
+	    column_types::type column_type(size_type i) const
+	    {
+		return types[i];
+	    }
+
+	    /// Returns the index of the argument column, or -1 if it does not
+	    /// exist.
+
+	    int column_index(const std::string& name) const
+	    {
+		for(size_type i=0;i<names.size();++i)
+		{
+		    if(names[i]==name)
+		    {
+			return i;
+		    }
+		}
+		return -1;
+	    }
+
+	    /// Returns the number of row groups.
+
+	    size_type row_groups() const
+	    {
+		return group_rows.size();
+	    }
+
+	    /// Returns the number of events in the g-th row group.
+
+	    size_type row_group_size(size_type g) const
+	    {
+		return group_rows[g];
+	    }
+
+	    /// Reads the floating-point column with the argument name.
+
+	    bool read(const std::string& name,std::vector<value_type>& data)
+	    {
+		return read_column(name,column_types::real,0,row_groups(),data);
+	    }
+
+	    /// Reads the g-th row group of the floating-point column with the
+	    /// argument name.
+
+	    bool read(const std::string& name,size_type g,std::vector<value_type>& data)
+	    {
+		return read_column(name,column_types::real,g,g+1,data);
+	    }
+
+	    /// Reads the integer column with the argument name.
+
+	    bool read(const std::string& name,std::vector<int>& data)
+	    {
+		return read_column(name,column_types::integer,0,row_groups(),data);
+	    }
+
+	    /// Reads the g-th row group of the integer column with the argument
+	    /// name.
+
+	    bool read(const std::string& name,size_type g,std::vector<int>& data)
+	    {
+		return read_column(name,column_types::integer,g,g+1,data);
+	    }
+
+	    /// Reads the boolean column with the argument name, as one byte per
+	    /// event.
+
+	    bool read(const std::string& name,std::vector<unsigned char>& data)
+	    {
+		return read_column(name,column_types::boolean,0,row_groups(),data);
+	    }
+
+	    /// Reads the g-th row group of the boolean column with the argument
+	    /// name, as one byte per event.
+
+	    bool read(const std::string& name,size_type g,std::vector<unsigned char>& data)
+	    {
+		return read_column(name,column_types::boolean,g,g+1,data);
+	    }
+
+	private:
+
+	    /* Input file stream: */
+
+	    std::ifstream ifs;
+
+	    /* File description: */
+
+	    std::string descr;
+
+	    /* Column names and types: */
+
+	    std::vector<std::string> names;
+	    std::vector<column_types::type> types;
+
+	    /* Row group sizes and column block offsets: */
+
+	    std::vector<size_type> group_rows;
+	    std::vector< std::vector<size_type> > offsets;
+
+	    /* Total number of events: */
+
+	    size_type n_rows;
+
+	    /* Reads the header and the footer index: */
+
+	    bool open()
+	    {
+		ifs.open(file_name.c_str(),std::ios::in|std::ios::binary);
+		if(!ifs.is_open())
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"column file "<<file_name<<" could not be opened"<<endlog;
+		    return false;
+		}
+		unsigned nval;
+		bool q=binary_io::read_header(ifs,column_format::tag(),column_format::version());
+		q=q and binary_io::read(ifs,nval) and binary_io::read_string(ifs,descr);
+		if(!q or nval!=sizeof(value_type))
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"column file "<<file_name<<" does not match format version "<<column_format::version()<<" and value type"<<endlog;
+		    ifs.close();
+		    return false;
+		}
+		size_type footer,n_cols,n_groups;
+		ifs.seekg(-(std::streamoff)sizeof(size_type),std::ios::end);
+		q=binary_io::read(ifs,footer);
+		if(q)
+		{
+		    ifs.seekg(footer);
+		    q=binary_io::read(ifs,n_cols);
+		}
+		for(size_type i=0;q and i<n_cols;++i)
+		{
+		    std::string name;
+		    unsigned type;
+		    q=binary_io::read_string(ifs,name) and binary_io::read(ifs,type);
+		    names.push_back(name);
+		    types.push_back((column_types::type)type);
+		}
+		q=q and binary_io::read(ifs,n_groups);
+		for(size_type g=0;q and g<n_groups;++g)
+		{
+		    size_type n;
+		    std::vector<size_type> offs(n_cols);
+		    q=binary_io::read(ifs,n);
+		    for(size_type i=0;q and i<n_cols;++i)
+		    {
+			q=binary_io::read(ifs,offs[i]);
+		    }
+		    group_rows.push_back(n);
+		    offsets.push_back(offs);
+		    n_rows+=n;
+		}
+		if(!q)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"column file "<<file_name<<" has a corrupt or missing footer"<<endlog;
+		    ifs.close();
+		    return false;
+		}
+		return true;
+	    }
+
+	    /* Reads the argument row groups of the column into the vector: */
+
+	    template<class T>bool read_column(const std::string& name,column_types::type type,size_type first,size_type last,std::vector<T>& data)
+	    {
+		data.clear();
+		int i=column_index(name);
+		if(!ifs.is_open() or i<0 or types[i]!=type or last>row_groups())
+		{
+		    return false;
+		}
+		size_type n=0;
+		for(size_type g=first;g<last;++g)
+		{
+		    n+=group_rows[g];
+		}
+		data.resize(n);
+		n=0;
+		for(size_type g=first;g<last;++g)
+		{
+		    if(group_rows[g]==0)
+		    {
+			continue;
+		    }
+		    ifs.clear();
+		    ifs.seekg(offsets[g][i]);
+		    ifs.read(reinterpret_cast<char*>(&data[n]),group_rows[g]*sizeof(T));
+		    if(ifs.fail())
+		    {
+			data.clear();
+			return false;
+		    }
+		    n+=group_rows[g];
+		}
+		return true;
+	    }
+
+	    /* Copying is not supported: */
+
+	    column_reader(const column_reader<value_t>&);
+	    column_reader<value_t>& operator = (const column_reader<value_t>&);
+    };
+}
+
+#endif /*CAMGEN_COL_READER_H_*/
+
@@ -89,6 +89,8 @@ namespace Camgen
 			{
 			    return NULL;
 			}
+		    case colour_generators::colour_ordered:
+			return colour_ordered_summer<value_type,N_in,N_out,cc>::template create_instance<model_t>(it);
 		    default:
 			return NULL;
 		}
@@ -47,6 +47,10 @@ namespace Camgen
 	    /* Friend declaration of the interaction base class: */
 
 	    friend class interaction_base<model_t,N>;
+
+	    /* Friend declaration of the instruction array class: */
+
+	    template<class mod_t,std::size_t M,bool decomp>friend class instruction_array;
 	    
 	    /* Friend declarations of current_tree, process_tree and CM_algorithm classes: */
 	    
@@ -56,13 +60,13 @@ namespace Camgen
 
 	    /* Default constructor: */
 
-	    current_base():particle_t(NULL),CM_tag(false),coupled(true),outgoing(false),initialised(false),final_amplitude(NULL),phase_space(NULL){}
+	    current_base():momentum(),particle_t(NULL),CM_tag(false),coupled(true),outgoing(false),initialised(false),multiplicity(0),final_amplitude(NULL),phase_space(NULL){}
 
 	    /* Regular constructor, specifying the type of particle propagated by the
 	     * current, the bitstring-coded momentum channel and an outgoing-particle
 	     * boolean tag: */
 
-	    current_base(const particle_type* phi,const bit_string<N>& b,bool out):particle_t(phi),bitstring(b),CM_tag(false),coupled(true),initialised(false),final_amplitude(NULL),phase_space(NULL)
+	    current_base(const particle_type* phi,const bit_string<N>& b,bool out):momentum(),particle_t(phi),bitstring(b),CM_tag(false),coupled(true),initialised(false),multiplicity(0),final_amplitude(NULL),phase_space(NULL)
 	    {
 		if(b.count()<=1)
 		{
@@ -81,8 +85,41 @@ namespace Camgen
 		if(other.phase_space!=NULL)
 		{
 		    allocate_phase_space();
+		    phase_space->copy_dofs(*(other.phase_space));
 		}
 	    }
+
+	    /* Assignment operator, copying the phase space object rather than
+	     * its address: */
+
+	    current_base<model_t,N>& operator = (const current_base<model_t,N>& other)
+	    {
+		if(this!=&other)
+		{
+		    momentum=other.momentum;
+		    particle_t=other.particle_t;
+		    bitstring=other.bitstring;
+		    CM_tag=other.CM_tag;
+		    coupled=other.coupled;
+		    outgoing=other.outgoing;
+		    initialised=other.initialised;
+		    amplitude=other.amplitude;
+		    multiplicity=other.multiplicity;
+		    final_amplitude=other.final_amplitude;
+		    if(other.phase_space!=NULL)
+		    {
+			reallocate_phase_space();
+			phase_space->copy_dofs(*(other.phase_space));
+		    }
+		    else if(phase_space!=NULL)
+		    {
+			delete phase_space;
+			phase_space=NULL;
+		    }
+		}
+		return *this;
+	    }
+
 	    /* Destructor: */
 
 	    ~current_base()
@@ -631,10 +668,10 @@ namespace Camgen
 	    typedef typename base_type::momentum_type momentum_type;
 	    typedef typename base_type::particle_type particle_type;
 
-	    /* Additional type definitions involving stl sets of tensor
-	     * iterators: */
+	    /* Additional type definitions involving sets of tensor iterators:
+	     * */
 
-	    typedef std::set<iterator> iterset;
+	    typedef iterator_mask<iterator> iterset;
 	    typedef typename iterset::iterator iterset_iterator;
 	    typedef typename iterset::const_iterator const_iterset_iterator;
 
@@ -652,7 +689,22 @@ namespace Camgen
 	    
 	    /* Copy constructor: */
 	    
-	    current(const current<model_t,N,true>& other):base_type(other),amp_iters(other.amp_iters){}
+	    current(const current<model_t,N,true>& other):base_type(other)
+	    {
+		copy_iters(other);
+	    }
+
+	    /* Assignment operator: */
+
+	    current<model_t,N,true>& operator = (const current<model_t,N,true>& other)
+	    {
+		if(this!=&other)
+		{
+		    base_type::operator=(other);
+		    copy_iters(other);
+		}
+		return *this;
+	    }
 	    
 	    /* Subamplitude resetting function, only resetting the propagating
 	     * colour modes: */
@@ -677,6 +729,7 @@ namespace Camgen
 		    /* Allocate subamplitude: */
 
 		    this->particle_t->make_amplitude(this->amplitude);
+		    amp_iters.bind(this->amplitude.begin(),this->amplitude.size());
 		    
 		    /* Allocate phase space: */
 		    
@@ -753,7 +806,7 @@ namespace Camgen
 		CAMGEN_ERROR_IF((this->particle_t==NULL),"wave function contraction called without particle type instance...");
 		CAMGEN_ERROR_IF((this->phase_space==NULL),"wave function contraction called without phase-space instance...");
 		
-		if(this->particle_t->is_coupled() and amp_iters.size()>0)
+		if(this->particle_t->is_coupled() and !amp_iters.empty())
 		{
 		    return this->phase_space->contract(this->final_amplitude->begin(),this->amplitude.begin());
 		}
@@ -860,7 +913,8 @@ namespace Camgen
 	private:
 
 	    /* Set of propagating colour modes (i.e. iterators at nonzero
-	     * subtensors of the subamplitude: */
+	     * subtensors of the subamplitude), stored as a bitmask over the
+	     * subamplitude components: */
 
 	    iterset amp_iters;
 	    
@@ -874,6 +928,15 @@ namespace Camgen
 	    {
 		return amp_iters.end();
 	    }
+
+	    /* Copies the propagating colour modes of another current, pointing
+	     * them at the subamplitude of this instance: */
+
+	    void copy_iters(const current<model_t,N,true>& other)
+	    {
+		amp_iters.bind(this->amplitude.begin(),this->amplitude.size());
+		amp_iters.copy_bits(other.amp_iters);
+	    }
     };
 
     /* Overloaded I/O-stream operator: */
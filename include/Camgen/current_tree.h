@@ -13,12 +13,14 @@
 #include <Camgen/logstream.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
- * Definition of the current_tree class, which is essentially a static list of   *
- * current objects. Given the model type, the number of in- and outgoing legs of *
- * the process and the final particle number, the initialisation of the data     *
- * tree creates a big vector of all possible currents (all particle flavours in  *
- * all possible momentum channels). The actual subprocess trees consist of lists *
- * of interactions between these currents.                                       *
+ * Definition of the current_tree class, which is essentially a list of current  *
+ * objects. Given the model type, the number of in- and outgoing legs of the     *
+ * process and the final particle number, the initialisation of the data tree    *
+ * creates a big vector of all possible currents (all particle flavours in all   *
+ * possible momentum channels). The actual subprocess trees consist of lists of  *
+ * interactions between these currents. Every CM_algorithm instance owns its     *
+ * current tree, so that distinct algorithm instances (e.g. one per thread) do   *
+ * not share any off-shell current data.                                         *
  *                                                                               *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -40,15 +42,6 @@ namespace Camgen
 	    
 	    static const std::size_t static_size=(1<<N_bits);
 
-	private:
-
-	    /* Integer denoting the final particle for process trees built upon
-	     * the current tree: */
-
-	    static std::size_t N_final;
-
-	public:
-
 	    /* Current type definition: */
 
 	    typedef current<model_t,N_bits,get_colour_treatment<model_t>::decomposes> current_type;
@@ -61,9 +54,40 @@ namespace Camgen
 	    
 	    typedef typename std::vector<current_type>::size_type size_type;
 
+	    /* Subamplitude component type definition: */
+
+	    typedef typename current_type::tensor_type::value_type amplitude_type;
+
+	    /* Trivial constructor (the tree is built by initialise()): */
+
+	    current_tree():N_final(0),flavours(0),initialised(false){}
+
+	    /* Copy constructor, laying out the copied subamplitudes in a new
+	     * contiguous block: */
+
+	    current_tree(const current_tree<model_t,N_in,N_out>& other):N_final(other.N_final),data(other.data),flavours(other.flavours),initialised(other.initialised)
+	    {
+		pack_amplitudes();
+	    }
+
+	    /* Assignment operator: */
+
+	    current_tree<model_t,N_in,N_out>& operator = (const current_tree<model_t,N_in,N_out>& other)
+	    {
+		if(this!=&other)
+		{
+		    N_final=other.N_final;
+		    std::vector<current_type>(other.data).swap(data);
+		    flavours=other.flavours;
+		    initialised=other.initialised;
+		    pack_amplitudes();
+		}
+		return *this;
+	    }
+
 	    /* Initialisation phase: */
 
-	    static void initialise(std::size_t N_f=0)
+	    void initialise(std::size_t N_f=0)
 	    {
 		if(!initialised and N_f<(N_in+N_out))
 		{
@@ -80,7 +104,7 @@ namespace Camgen
 
 	    /* Tree construction function: */
 
-	    static void refresh()
+	    void refresh()
 	    {
 		if(initialised)
 		{
@@ -92,6 +116,7 @@ namespace Camgen
 
 		flavours=model_wrapper<model_t>::flavours();
 		data.clear();
+		std::vector<amplitude_type>().swap(amplitudes);
 		data.resize(static_size*(flavours));
 		
 		/* Construct initial & internal currents: */
@@ -121,7 +146,7 @@ namespace Camgen
 
 	    /* Function re-assigning the final particle currents: */
 
-	    static void set_final_current(size_type n)
+	    void set_final_current(size_type n)
 	    {
 		bool p=(N_final<N_in);
 		bool q=(n<N_in);
@@ -158,14 +183,14 @@ namespace Camgen
 
 	    /* Final current block readout: */
 
-	    static size_type final_current()
+	    size_type final_current()
 	    {
 		return N_final;
 	    }
 
 	    /* Output method: */
 
-	    static std::ostream& print(std::ostream& os)
+	    std::ostream& print(std::ostream& os)
 	    {
 		for(int i=0;i<data.size();++i)
 		{
@@ -177,15 +202,15 @@ namespace Camgen
 
 	    /* Useful iterators in the tree: */
 
-	    static iterator begin()
+	    iterator begin()
 	    {
 		return data.begin();
 	    }
-	    static iterator end()
+	    iterator end()
 	    {
 		return data.end();
 	    }
-	    static iterator begin_internals()
+	    iterator begin_internals()
 	    {
 		if(initialised)
 		{
@@ -197,7 +222,7 @@ namespace Camgen
 		    return data.end();
 		}
 	    }
-	    static iterator end_internals()
+	    iterator end_internals()
 	    {
 		if(initialised)
 		{
@@ -209,7 +234,7 @@ namespace Camgen
 
 	    /* Current-finding algorithms: */
 
-	    static iterator find_current(const bit_string<N_bits>& B)
+	    iterator find_current(const bit_string<N_bits>& B)
 	    {
 		if(initialised)
 		{
@@ -219,7 +244,7 @@ namespace Camgen
 		return data.end();
 	    }
 
-	    static iterator find_current(const bit_string<N_bits>& B,const particle<model_t>* phi)
+	    iterator find_current(const bit_string<N_bits>& B,const particle<model_t>* phi)
 	    {
 		if(initialised)
 		{
@@ -230,12 +255,12 @@ namespace Camgen
 		return data.end();
 	    }
 
-	    static iterator find_current(const bit_string<N_bits>& B,const std::string& str)
+	    iterator find_current(const bit_string<N_bits>& B,const std::string& str)
 	    {
 		return find_current(B,model_wrapper<model_t>::get_particle(str));
 	    }
 
-	    static iterator find_current(const bit_string<N_bits>& B,const std::size_t flav)
+	    iterator find_current(const bit_string<N_bits>& B,const std::size_t flav)
 	    {
 		if(initialised)
 		{
@@ -247,7 +272,7 @@ namespace Camgen
 
 	    /* Finding the first marked current in momentum channel B: */
 
-	    static iterator first_marked_current(const bit_string<N_bits>& B)
+	    iterator first_marked_current(const bit_string<N_bits>& B)
 	    {
 		if(initialised)
 		{
@@ -273,7 +298,7 @@ namespace Camgen
 	     * denotes whether the iterator shifted from the end of the channel
 	     * block to the beginning. */
 
-	    static bool next_marked_current(iterator& it)
+	    bool next_marked_current(iterator& it)
 	    {
 		if(initialised)
 		{
@@ -320,7 +345,7 @@ namespace Camgen
 	     * of the vector, contuining to the front as long as the iterators
 	     * were the last marked currents in their channel block: */
 
-	    static bool next_marked_currents(std::vector<iterator>& iters)
+	    bool next_marked_currents(std::vector<iterator>& iters)
 	    {
 		iterator check=first_marked_current(iters[0]->get_bit_string());
 		size_type n=iters.size()-1;
@@ -331,9 +356,37 @@ namespace Camgen
 		return (n != 0 or iters[0] != check);
 	    }
 
+	    /* Moves the subamplitudes of all initialised currents into one
+	     * contiguous block, in which every current takes the size of the
+	     * wave function of its particle type. Currents initialised later
+	     * keep their own storage until the next call: */
+
+	    void pack_amplitudes()
+	    {
+		size_type n=0;
+		for(size_type i=0;i<data.size();++i)
+		{
+		    if(data[i].initialised)
+		    {
+			n+=data[i].amplitude.size();
+		    }
+		}
+		std::vector<amplitude_type>block(n);
+		n=0;
+		for(size_type i=0;i<data.size();++i)
+		{
+		    if(data[i].initialised and data[i].amplitude.size()!=0)
+		    {
+			data[i].amplitude.bind_data(&block[n]);
+			n+=data[i].amplitude.size();
+		    }
+		}
+		amplitudes.swap(block);
+	    }
+
 	    /* Function unmarking all currents: */
 
-	    static void unmark()
+	    void unmark()
 	    {
 		for(size_type i=0;i<data.size();++i)
 		{
@@ -343,26 +396,32 @@ namespace Camgen
 
 	private:
 
+	    /* Integer denoting the final particle for process trees built upon
+	     * the current tree: */
+
+	    std::size_t N_final;
+
 	    /* Vector of currents of all possible flavours in all possible
 	     * momentum channels: */
 
-	    static std::vector<current_type>data;
+	    std::vector<current_type>data;
+
+	    /* Contiguous storage of the subamplitudes of the initialised
+	     * currents: */
+
+	    std::vector<amplitude_type>amplitudes;
 	    
 	    /* Number of flavours in the model: */
 	    
-	    static size_type flavours;
+	    size_type flavours;
 
 	    /* Initialisation tag: */
 
-	    static bool initialised;
+	    bool initialised;
     };
 
     template<class model_t,std::size_t N_in,std::size_t N_out>const std::size_t current_tree<model_t,N_in,N_out>::N_bits;
     template<class model_t,std::size_t N_in,std::size_t N_out>const std::size_t current_tree<model_t,N_in,N_out>::static_size;
-    template<class model_t,std::size_t N_in,std::size_t N_out>std::size_t current_tree<model_t,N_in,N_out>::N_final=0;
-    template<class model_t,std::size_t N_in,std::size_t N_out>std::vector<typename current_tree<model_t,N_in,N_out>::current_type >current_tree<model_t,N_in,N_out>::data;
-    template<class model_t,std::size_t N_in,std::size_t N_out>typename current_tree<model_t,N_in,N_out>::size_type current_tree<model_t,N_in,N_out>::flavours=0;
-    template<class model_t,std::size_t N_in,std::size_t N_out>bool current_tree<model_t,N_in,N_out>::initialised=false;
 }
 
 #endif /*CAMGEN_CURRENT_TREE_H_*/
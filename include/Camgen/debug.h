@@ -47,6 +47,16 @@
 #define __CAMGEN_FUNC__ "<unknown>"
 #endif
 
+/* Selecting the compiler's thread-local storage specifier, used for the static
+ * scratch variables in the amplitude evaluation path. Without it, distinct
+ * algorithm instances may not be evaluated concurrently: */
+
+#if __cplusplus >= 201103L
+#define CAMGEN_THREAD_LOCAL thread_local
+#else
+#define CAMGEN_THREAD_LOCAL
+#endif
+
 /* Helper macro definitions: */
 
 #define CAMGEN_STREAMLOC "file "<<__FILE__<<", function "<<__CAMGEN_FUNC__<<", line "<<__LINE__<<": "
@@ -57,14 +57,17 @@ typedef typename get_basic_types<M>::iterator iterator;									\
 typedef typename get_basic_types<M>::const_iterator const_iterator;							\
 typedef typename get_basic_types<M>::momentum_type momentum_type
 
-/* Macro defining the argument list of vertex class methods: */
+/* Macro defining the argument list of vertex class methods. The coupling
+ * addresses, subamplitude iterators and momentum addresses are passed as
+ * arrays, such that the operands can be stored contiguously in the instruction
+ * arena of a process tree: */
 
-#define ARG_LIST const value_type& factor,const std::vector<const value_type*>& couplings,std::vector<iterator>& iters,const std::vector<const momentum_type*>& momenta
+#define ARG_LIST const value_type& factor,const value_type* const* couplings,iterator* iters,const momentum_type* const* momenta
 
 /* Macro defining the argument list of vertex class methods in the case where
  * the program keeps track of nonzero propagating colour modes: */
 
-#define CFD_ARG_LIST const value_type& factor,const std::vector<const value_type*>& couplings,std::vector<iterator>& iters,const std::vector<const momentum_type*>& momenta,std::set<iterator>& produced_iters
+#define CFD_ARG_LIST const value_type& factor,const value_type* const* couplings,iterator* iters,const momentum_type* const* momenta,iterator_mask<iterator>& produced_iters
 
 /* Preprocessor definitions of the arguments in the lists above: */
 
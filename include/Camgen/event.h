@@ -128,13 +128,13 @@ namespace Camgen
 
 	    /* Default constructor: */
 
-	    event():sub_proc(NULL),procid(1){}
+	    event():sub_proc(NULL),procid(1),owns_proc(true){}
 
 	    /* Destructor: */
 
 	    virtual ~event()
             {
-                if(sub_proc!=NULL)
+                if(sub_proc!=NULL and owns_proc)
                 {
                     delete sub_proc;
                 }
@@ -799,6 +799,13 @@ namespace Camgen
             {
                 return *sub_proc;
             } 
+
+            /// Returns a pointer to the sub-process, or NULL if none was set.
+
+            const sub_process<model_type,N_in,N_out>* get_process_ptr() const
+            {
+                return sub_proc;
+            }
             
             /* Predefined event validation functions. */
             
@@ -880,6 +887,7 @@ namespace Camgen
 
             const sub_process<model_type,N_in,N_out>* sub_proc;
             int procid;
+            bool owns_proc;
     };
 
     /* Helper template class for transverse directions of 2-particle initial states in 3d: */
@@ -1107,13 +1115,13 @@ namespace Camgen
 
 	    /* Default constructor: */
 
-	    event():sub_proc(NULL),procid(1){}
+	    event():sub_proc(NULL),procid(1),owns_proc(true){}
 
 	    /* Destructor: */
 
 	    virtual ~event()
             {
-                if(sub_proc!=NULL)
+                if(sub_proc!=NULL and owns_proc)
                 {
                     delete sub_proc;
                 }
@@ -1940,6 +1948,13 @@ namespace Camgen
             {
                 return *sub_proc;
             } 
+
+            /// Returns a pointer to the sub-process, or NULL if none was set.
+
+            const sub_process<model_type,2,N_out>* get_process_ptr() const
+            {
+                return sub_proc;
+            }
             
             /* Predefined event validation functions. */
             
@@ -2025,6 +2040,7 @@ namespace Camgen
 
             const sub_process<model_type,2,N_out>* sub_proc;
             int procid;
+            bool owns_proc;
     };
 
     /// Output streaming operator overload for events.
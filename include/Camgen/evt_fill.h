@@ -40,16 +40,62 @@ namespace Camgen
 	    typedef typename base_type::spacetime_type spacetime_type;
             typedef typename base_type::particle_type particle_type;
 
+            /// Constructor.
+
+            fillable_event():proc_copy(NULL){}
+
             /// Sets the current sub-process.
 
             virtual void set_process(const sub_process<model_t,N_in,N_out>* sub_proc_,int id=1)
             {
-                if(this->sub_proc!=NULL)
+                if(this->sub_proc!=NULL and this->owns_proc)
+                {
+                    delete this->sub_proc;
+                }
+                proc_copy=NULL;
+                this->sub_proc=sub_proc_;
+                this->procid=id;
+                this->owns_proc=true;
+            }
+
+            /// Sets the current sub-process without taking ownership. The
+            /// argument should outlive its use by the event.
+
+            void set_process_reference(const sub_process<model_t,N_in,N_out>* sub_proc_,int id=1)
+            {
+                if(this->sub_proc!=NULL and this->owns_proc)
                 {
                     delete this->sub_proc;
                 }
+                proc_copy=NULL;
                 this->sub_proc=sub_proc_;
                 this->procid=id;
+                this->owns_proc=false;
+            }
+
+            /// Sets the current sub-process to an owned copy of the argument,
+            /// overwriting the owned descriptor if present.
+
+            void copy_process(const sub_process<model_t,N_in,N_out>* sub_proc_,int id=1)
+            {
+                if(sub_proc_==NULL)
+                {
+                    set_process_reference(NULL,id);
+                }
+                else if(proc_copy!=NULL)
+                {
+                    if(proc_copy!=sub_proc_)
+                    {
+                        *proc_copy=*sub_proc_;
+                    }
+                    this->procid=id;
+                }
+                else
+                {
+                    sub_process<model_t,N_in,N_out>* p=sub_proc_->clone();
+                    set_process(p,id);
+                    proc_copy=p;
+                }
             }
 
             /// Copies the argument vector to the i-th incoming momentum.
@@ -104,6 +150,46 @@ namespace Camgen
 
             virtual void set_colour_connection(const vector<int,N_in+N_out>&,const vector<int,N_in+N_out>&)=0;
 
+            /// Copies the momenta and metadata of the argument event. The
+            /// sub-process is copied into a descriptor owned by this event,
+            /// which is reused by subsequent copies, so the copy stays valid
+            /// when the generator of the argument event removes its process.
+
+            void copy_event(const event<model_t,N_in,N_out>& evt)
+            {
+                for(size_type i=0;i<N_in;++i)
+                {
+                    set_p_in(i,evt.p_in(i));
+                    set_beam_energy(-(int)i-1,evt.E_beam(i));
+                    set_beam_id(-(int)i-1,evt.beam_id(-(int)i-1));
+                    set_pdfg(-(int)i-1,evt.pdfg(-(int)i-1));
+                    set_pdfs(-(int)i-1,evt.pdfs(-(int)i-1));
+                }
+                for(size_type i=0;i<N_out;++i)
+                {
+                    set_p_out(i,evt.p_out(i));
+                }
+                set_w(evt.w());
+                set_max_w(evt.max_w());
+                set_xsec(evt.xsec());
+                set_process_xsec(evt.process_xsec());
+                set_Ecm_hat(evt.Ecm_hat());
+                set_mu_F(evt.mu_F());
+                vector<int,N_in+N_out>c,cbar;
+                for(size_type i=0;i<N_in;++i)
+                {
+                    c[i]=evt.c_in(i);
+                    cbar[i]=evt.cbar_in(i);
+                }
+                for(size_type i=0;i<N_out;++i)
+                {
+                    c[N_in+i]=evt.c_out(i);
+                    cbar[N_in+i]=evt.cbar_out(i);
+                }
+                set_colour_connection(c,cbar);
+                copy_process(evt.get_process_ptr(),evt.process_id());
+            }
+
             /// Resets to default (zero)momenta.
 
             void reset()
@@ -125,6 +211,13 @@ namespace Camgen
                 c.assign(0);
                 set_colour_connection(c,c);
             }
+
+        private:
+
+            /* Writable alias of the sub-process if it is an owned copy made
+             * by copy_process, NULL otherwise: */
+
+            sub_process<model_t,N_in,N_out>* proc_copy;
     };
 }
 
@@ -14,6 +14,10 @@
 
 #include <Camgen/proc_gen.h>
 
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
+
 namespace Camgen
 {
     /* Forward declaration of process generator factory base: */
@@ -40,6 +44,15 @@ namespace Camgen
 
                 generator_type* generator;
                 typename generator_type::value_type alpha;
+
+                /* Amplitude instance evaluated by the generator: */
+
+                CM_algorithm<model_t,N_in,N_out>* amplitude;
+
+                /* Random number substream of the initialisation, kept between
+                 * the pre-initialisation and initialisation phases: */
+
+                rng_t* engine;
             };
 
             /* Type definitions: */
@@ -125,18 +138,25 @@ namespace Camgen
                 for(size_type i=0;i<procs.size();++i)
                 {
                     delete procs[i].generator;
+                    delete procs[i].engine;
+                }
+                for(size_type i=0;i<amplitude_copies.size();++i)
+                {
+                    delete amplitude_copies[i];
                 }
             }
 
             /// Pre-initialisation method to obtain first subprocess cross
             /// section estimates, determining which subprocesses are relevant.
+            /// If the subprocess generators were distributed over several
+            /// amplitude instances (see set_init_threads), the subprocesses of
+            /// each instance are pre-initialised by a separate thread.
 
             void pre_initialise(size_type n_evts,bool verbose=false)
             {
-                for(sub_proc=procs.begin();sub_proc!=procs.end();++sub_proc)
-                {
-                    sub_proc->generator->pre_initialise(n_evts,verbose);
-                }
+                init_settings settings={true,n_evts,0,0,0,0,verbose,false};
+                initialise_processes(settings);
+                sub_proc=procs.begin();
                 this->refresh_cross_section();
                 adapt_processes();
                 this->base_type::reset();
@@ -147,21 +167,20 @@ namespace Camgen
                 update_counter=0;
             }
 
-            /// Initialiser method.
+            /// Initialiser method. Adapts the subprocess generators and
+            /// estimates their cross sections with sub_proc_evts events each.
+            /// If the subprocess generators were distributed over several
+            /// amplitude instances (see set_init_threads), the subprocesses of
+            /// each instance are initialised by a separate thread. If the
+            /// random number engine provides substreams, every subprocess
+            /// draws from the stream selected by its id, so the result does
+            /// not depend on the number of threads.
 
             void initialise(size_type channel_iters,size_type channel_batch,size_type grid_iters,size_type grid_batch,size_type sub_proc_evts,bool verbose=false)
             {
-                for(sub_proc=procs.begin();sub_proc!=procs.end();++sub_proc)
-                {
-                    if(verbose)
-                    {
-                        std::stringstream ss;
-                        sub_proc->generator->print_process(ss);
-                        std::cout<<std::endl<<ss.str()<<std::endl;
-                    }
-                    sub_proc->generator->initialise(channel_iters,channel_batch,grid_iters,grid_batch,verbose);
-                    loop_process(sub_proc_evts,verbose);
-                }
+                init_settings settings={false,sub_proc_evts,channel_iters,channel_batch,grid_iters,grid_batch,verbose,true};
+                initialise_processes(settings);
+                sub_proc=procs.begin();
                 this->refresh_cross_section();
                 adapt_processes();
             }
@@ -202,6 +221,38 @@ namespace Camgen
                 }
             }
 
+            /// Sets the two-stage unweighting flag for all subprocess
+            /// generators.
+
+            void set_two_stage_unweighting(bool q)
+            {
+                for(process_iterator it=procs.begin();it!=procs.end();++it)
+                {
+                    it->generator->set_two_stage_unweighting(q);
+                }
+            }
+
+            /// Sets the partial unweighting flag for all subprocess generators.
+
+            void set_partial_unweighting(bool q)
+            {
+                for(process_iterator it=procs.begin();it!=procs.end();++it)
+                {
+                    it->generator->set_partial_unweighting(q);
+                }
+            }
+
+            /// Sets the safety factor of the two-stage unweighting matrix
+            /// element bound for all subprocess generators.
+
+            void set_me_bound_factor(const value_type& x)
+            {
+                for(process_iterator it=procs.begin();it!=procs.end();++it)
+                {
+                    it->generator->set_me_bound_factor(x);
+                }
+            }
+
             /// Sets the automatic multichannel adaptation batch size for all
             /// subprocess generators.
 
@@ -278,15 +329,7 @@ namespace Camgen
                     return true;
                 }
                 value_type rho=throw_number((value_type)0,(value_type)1);
-                process_iterator p_it=procs.begin();
-                value_type r(0);
-                while(r<=rho and p_it!=procs.end())
-                {
-                    r+=p_it->alpha;
-                    ++p_it;
-                }
-                --p_it;
-                set_sub_process(p_it);
+                set_sub_process(select_process(alpha_sums,rho,true));
                 if(sub_proc==procs.end())
                 {
                     log(log_level::warning)<<CAMGEN_STREAMLOC<<"subprocess iterator overflow detected--no generation performed"<<endlog;
@@ -319,21 +362,16 @@ namespace Camgen
             bool generate_unweighted(bool verbose)
             {
                 value_type rho=throw_number(0,this->cross_section().value);
-                process_iterator p_it=procs.begin();
-                value_type r(0);
-                while(r<rho and p_it!=procs.end())
-                {
-                    r+=(sub_proc->generator->cross_section().value);
-                    ++p_it;
-                }
-                --p_it;
-                set_sub_process(p_it);
+                set_sub_process(select_process(xsec_sums,rho,false));
                 if(sub_proc==procs.end())
                 {
                     log(log_level::warning)<<"Subprocesses iterator overflow detected...no generation performed"<<endlog;
                     return false;
                 }
                 bool success=sub_proc->generator->generate_unweighted(verbose);
+                value_type xsec=sub_proc->generator->cross_section().value;
+                this->weight()=(xsec==(value_type)0)?(value_type)0:(this->cross_section().value*sub_proc->generator->weight()/xsec);
+                this->get_event_ptr()->set_w(this->weight());
                 if(update_counter!=0 and auto_proc_adapt!=0 and update_counter%auto_proc_adapt==0)
                 {
                     adapt_processes();
@@ -368,6 +406,7 @@ namespace Camgen
                     it->generator->reset();
                     it->alpha=(value_type)1/procs.size();
                 }
+                refresh_alpha_sums();
                 update_counter=0;
             }
 
@@ -507,6 +546,7 @@ namespace Camgen
                 {
                     it->alpha/=norm;
                 }
+                process_generator_type* current=(sub_proc==procs.end())?NULL:(sub_proc->generator);
                 std::sort(procs.begin(),procs.end(),alpha_more);
                 process_iterator it=procs.begin();
                 while(it!=procs.end() and it->alpha!=(value_type)0)
@@ -515,19 +555,87 @@ namespace Camgen
                 }
                 if(it==procs.end() or it==procs.begin())
                 {
+                    refresh_alpha_sums();
+                    up_to_date=false;
+                    restore_sub_process(current);
                     return;
                 }
                 std::size_t newsize=it-procs.begin();
                 process_iterator it2;
                 while(it!=procs.end())
                 {
-                    algorithm.set_process(it->generator->amplitude);
-                    algorithm.remove_process();
-                    delete it->generator;
+                    delete_process(*it);
                     ++it;
                 }
                 procs.resize(newsize);
-                sub_proc=procs.begin();
+                refresh_alpha_sums();
+                up_to_date=false;
+                restore_sub_process(current);
+            }
+
+            /// Writes the call counters, the subprocess weights and the adaptive
+            /// states of all subprocess generators to the binary output
+            /// stream.
+
+            void save_state(std::ostream& os) const
+            {
+                binary_io::write(os,n_calls);
+                binary_io::write(os,update_counter);
+                binary_io::write(os,procs.size());
+                for(const_process_iterator it=procs.begin();it!=procs.end();++it)
+                {
+                    binary_io::write(os,it->generator->id);
+                    binary_io::write(os,it->alpha);
+                    it->generator->save_state(os);
+                }
+            }
+
+            /// Reads the state written by save_state from the binary input
+            /// stream. The subprocesses are identified by their id and put in
+            /// the saved order; subprocesses which were removed from the saved
+            /// generator are removed as well.
+
+            bool load_state(std::istream& is)
+            {
+                size_type n;
+                if(!(binary_io::read(is,n_calls) and binary_io::read(is,update_counter) and binary_io::read(is,n)) or n>procs.size())
+                {
+                    return false;
+                }
+                process_container loaded;
+                bool success=true;
+                int id;
+                for(size_type i=0;i<n and success;++i)
+                {
+                    success=binary_io::read(is,id);
+                    process_iterator it=procs.begin();
+                    while(success and it!=procs.end() and it->generator->id!=id)
+                    {
+                        ++it;
+                    }
+                    success=(success and it!=procs.end() and binary_io::read(is,it->alpha) and it->generator->load_state(is));
+                    if(success)
+                    {
+                        loaded.push_back(*it);
+                        procs.erase(it);
+                    }
+                }
+                if(success)
+                {
+                    for(process_iterator it=procs.begin();it!=procs.end();++it)
+                    {
+                        delete_process(*it);
+                    }
+                    procs.swap(loaded);
+                }
+                else
+                {
+                    procs.insert(procs.begin(),loaded.begin(),loaded.end());
+                }
+                refresh_alpha_sums();
+                up_to_date=false;
+                sub_proc=procs.end();
+                return success;
             }
 
             /// Sets up the weight histogram (default 1000 bins).
@@ -562,6 +670,13 @@ namespace Camgen
                 if(!up_to_date)
                 {
                     integral_sum=compute_cross_section();
+                    xsec_sums.resize(procs.size());
+                    value_type sum(0);
+                    for(size_type i=0;i<procs.size();++i)
+                    {
+                        sum+=procs[i].generator->cross_section().value;
+                        xsec_sums[i]=sum;
+                    }
                     up_to_date=true;
                 }
                 return integral_sum;
@@ -941,7 +1056,8 @@ namespace Camgen
 
             std::ostream& print_status(std::ostream& os=std::cout) const
             {
-                size_type evt_counter=0,pos_evt_counter=0,calls=0,grid_adaptations=0,channel_adaptations=0;
+                size_type evt_counter=0,pos_evt_counter=0,calls=0,grid_adaptations=0,channel_adaptations=0,skipped_amplitudes=0,unweighted_events=0,overweight_events=0;
+                value_type w_factor_sum=0;
                 value_type efficiency=0;
                 for(const_process_iterator it=procs.begin();it!=procs.end();++it)
                 {
@@ -950,6 +1066,10 @@ namespace Camgen
                     calls+=(it->generator->calls());
                     grid_adaptations+=(it->generator->grid_adaptations);
                     channel_adaptations+=(it->generator->channel_adaptations);
+                    skipped_amplitudes+=(it->generator->skipped_amplitudes);
+                    unweighted_events+=(it->generator->unweighted_events);
+                    overweight_events+=(it->generator->overweight_events);
+                    w_factor_sum+=(it->generator->w_factor_sum);
                     efficiency+=(it->generator->efficiency()/procs.size());
                 }
                 os<<"###############################################################################################"<<std::endl;
@@ -960,6 +1080,10 @@ namespace Camgen
                 os<<"Nr of updates performed:                           "<<std::scientific<<update_counter<<std::endl;
                 os<<"Nr of grid adaptations performed:                  "<<std::scientific<<grid_adaptations<<std::endl;
                 os<<"Nr of channel adaptations performed:               "<<std::scientific<<channel_adaptations<<std::endl;
+                os<<"Nr of amplitudes skipped by two-stage unweighting: "<<std::scientific<<skipped_amplitudes<<std::endl;
+                os<<"Nr of unweighted events generated:                 "<<std::scientific<<unweighted_events<<std::endl;
+                os<<"Nr of overweight unweighted events:                "<<std::scientific<<overweight_events<<std::endl;
+                os<<"Average unweighted event weight / cross section:   "<<std::scientific<<((unweighted_events==0)?(value_type)1:(w_factor_sum/unweighted_events))<<std::endl;
                 os<<"Monte Carlo efficiency (%):                        "<<std::scientific<<efficiency<<std::endl;
                 os<<"Cross section (pb):                                "<<std::scientific<<this->cross_section()<<std::endl;
                 os<<"###############################################################################################"<<std::endl;
@@ -1012,6 +1136,15 @@ namespace Camgen
 
             process_iterator sub_proc;
 
+            /* Cumulative subprocess channel weights: */
+
+            std::vector<value_type> alpha_sums;
+
+            /* Cumulative subprocess cross sections, updated with the total
+             * cross section: */
+
+            mutable std::vector<value_type> xsec_sums;
+
             /* Total cross section: */
 
             mutable MC_integral<value_type> integral_sum;
@@ -1036,22 +1169,144 @@ namespace Camgen
 
             size_type auto_proc_adapt;
 
-            /* Helper function for initialisation: */
+            /* Additional amplitude instances, owned by the generator, for the
+             * concurrent initialisation of the subprocesses: */
+
+            std::vector<CM_algorithm<model_t,N_in,N_out>*> amplitude_copies;
+
+            /* Subprocess initialisation settings: */
 
-            void loop_process(size_type sub_proc_evts,bool verbose)
+            struct init_settings
             {
+                bool pre;
+                size_type events;
+                size_type channel_iters;
+                size_type channel_batch;
+                size_type grid_iters;
+                size_type grid_batch;
+                bool verbose;
+                bool record;
+            };
+
+            /* Initialises all subprocess generators. A thread per amplitude
+             * instance is used only if the random number engine provides
+             * substreams, since other engines would give correlated or
+             * racing streams across the threads: */
+
+            void initialise_processes(const init_settings& settings)
+            {
+#if __cplusplus >= 201103L
+                if(amplitude_copies.size()!=0 and rn_substream<rng_t>::value)
+                {
+                    init_settings quiet=settings;
+                    quiet.verbose=false;
+                    quiet.record=false;
+                    std::vector<std::thread>workers;
+                    for(size_type i=0;i<amplitude_copies.size();++i)
+                    {
+                        workers.push_back(std::thread(&event_generator::initialise_group,this,amplitude_copies[i],quiet));
+                    }
+                    initialise_group(&algorithm,quiet);
+                    for(size_type i=0;i<workers.size();++i)
+                    {
+                        workers[i].join();
+                    }
+
+                    /* Leave the integrand and weight of the last event, as
+                     * in the sequential initialisation: */
+
+                    if(settings.record and settings.events!=0 and !procs.empty())
+                    {
+                        this->integrand()=procs.back().generator->integrand();
+                        this->weight()=procs.back().generator->weight()/procs.back().alpha;
+                    }
+                    if(settings.verbose)
+                    {
+                        print_cross_sections();
+                    }
+                    return;
+                }
+#endif
+                for(process_iterator it=procs.begin();it!=procs.end();++it)
+                {
+                    initialise_process(*it,settings);
+                }
+            }
+
+            /* Initialises the subprocess generators evaluating the argument
+             * amplitude instance: */
+
+            void initialise_group(CM_algorithm<model_t,N_in,N_out>* amp,init_settings settings)
+            {
+                for(process_iterator it=procs.begin();it!=procs.end();++it)
+                {
+                    if(it->amplitude==amp or (it->amplitude==NULL and amp==&algorithm))
+                    {
+                        initialise_process(*it,settings);
+                    }
+                }
+            }
+
+            /* Initialises a single subprocess generator, drawing from the
+             * random number substream selected by its id if available. The
+             * substream continues where the previous initialisation phase of
+             * the subprocess stopped, and the engine of the calling thread is
+             * restored afterwards: */
+
+            void initialise_process(subprocess_type& proc,const init_settings& settings)
+            {
+                if(proc.engine==NULL)
+                {
+                    proc.engine=rn_substream<rng_t>::create(proc.generator->id);
+                }
+                typename random_number_generator::saved_engine previous_engine;
+                if(proc.engine!=NULL)
+                {
+                    previous_engine=random_number_generator::swap_engine(proc.engine);
+                }
+                if(settings.pre)
+                {
+                    proc.generator->pre_initialise(settings.events,settings.verbose);
+                }
+                else
+                {
+                    if(settings.verbose)
+                    {
+                        std::stringstream ss;
+                        proc.generator->print_process(ss);
+                        std::cout<<std::endl<<ss.str()<<std::endl;
+                    }
+                    proc.generator->initialise(settings.channel_iters,settings.channel_batch,settings.grid_iters,settings.grid_batch,settings.verbose);
+                    loop_process(proc,settings.events,settings.verbose,settings.record);
+                }
+                if(proc.engine!=NULL)
+                {
+                    random_number_generator::restore_engine(previous_engine);
+                }
+            }
+
+            /* Estimates the cross section of the argument subprocess. If
+             * the record flag is set, the integrand and weight of every event
+             * are copied to the event generator: */
+
+            void loop_process(subprocess_type& proc,size_type sub_proc_evts,bool verbose,bool record)
+            {
+                process_generator_type* gen=proc.generator;
                 if(verbose)
                 {
                     std::cout<<"estimating xsec";
                     std::cout.flush();
-                    size_type batch=sub_proc_evts/10;
+                    size_type batch=std::max(sub_proc_evts/10,(size_type)1);
                     for(size_type i=0;i<sub_proc_evts;++i)
                     {
-                        sub_proc->generator->throw_event();
-                        sub_proc->generator->update();
-                        sub_proc->generator->refresh_cross_section();
-                        this->integrand()=sub_proc->generator->integrand();
-                        this->weight()=sub_proc->generator->weight()/sub_proc->alpha;
+                        gen->throw_event();
+                        gen->update();
+                        gen->refresh_cross_section();
+                        if(record)
+                        {
+                            this->integrand()=gen->integrand();
+                            this->weight()=gen->weight()/proc.alpha;
+                        }
                         if(i%batch==0)
                         {
                             std::cout<<'.';
@@ -1064,30 +1319,95 @@ namespace Camgen
                 {
                     for(size_type i=0;i<sub_proc_evts;++i)
                     {
-                        sub_proc->generator->generate();
-                        sub_proc->generator->update();
-                        sub_proc->generator->refresh_cross_section();
-                        this->integrand()=sub_proc->generator->integrand();
-                        this->weight()=sub_proc->generator->weight()/sub_proc->alpha;
+                        gen->generate();
+                        gen->update();
+                        gen->refresh_cross_section();
+                        if(record)
+                        {
+                            this->integrand()=gen->integrand();
+                            this->weight()=gen->weight()/proc.alpha;
+                        }
                     }
                 }
                 if(verbose)
                 {
-                    std::cout<<std::setw(15)<<sub_proc->generator->cross_section().value;
-                    std::cout<<std::setw(15)<<sub_proc->generator->cross_section().error;
-                    std::cout<<std::setw(15)<<sub_proc->generator->cross_section().error_error;
-                    std::cout<<std::setw(10)<<sub_proc->generator->calls()<<std::endl;
+                    std::cout<<std::setw(15)<<gen->cross_section().value;
+                    std::cout<<std::setw(15)<<gen->cross_section().error;
+                    std::cout<<std::setw(15)<<gen->cross_section().error_error;
+                    std::cout<<std::setw(10)<<gen->calls()<<std::endl;
+                }
+            }
+
+            /* Removes the subprocess from its amplitude and deletes the
+             * generator: */
+
+            void delete_process(subprocess_type& p)
+            {
+                CM_algorithm<model_t,N_in,N_out>& amp=(p.amplitude==NULL)?algorithm:(*(p.amplitude));
+                amp.set_process(p.generator->amplitude);
+                amp.remove_process();
+                delete p.generator;
+                delete p.engine;
+            }
+
+            /* Recomputes the cumulative subprocess channel weights: */
+
+            void refresh_alpha_sums()
+            {
+                alpha_sums.resize(procs.size());
+                value_type sum(0);
+                for(size_type i=0;i<procs.size();++i)
+                {
+                    sum+=procs[i].alpha;
+                    alpha_sums[i]=sum;
+                }
+            }
+
+            /* Selects the subprocess at which the cumulative weights exceed
+             * rho (or reach rho if the second argument is false) by a binary
+             * search. Rounding overflows select the last subprocess: */
+
+            process_iterator select_process(const std::vector<value_type>& sums,const value_type& rho,bool exceed)
+            {
+                if(procs.size()==0 or sums.size()!=procs.size())
+                {
+                    return procs.end();
+                }
+                typename std::vector<value_type>::const_iterator it=exceed?std::upper_bound(sums.begin(),sums.end(),rho):std::lower_bound(sums.begin(),sums.end(),rho);
+                if(it==sums.end())
+                {
+                    --it;
+                }
+                return procs.begin()+(it-sums.begin());
+            }
+
+            /* Moves the subprocess iterator to the argument generator after
+             * reordering the subprocesses, or to the first subprocess if the
+             * generator was removed: */
+
+            void restore_sub_process(const process_generator_type* gen)
+            {
+                for(process_iterator it=procs.begin();it!=procs.end();++it)
+                {
+                    if(it->generator==gen)
+                    {
+                        set_sub_process(it);
+                        return;
+                    }
                 }
+                set_sub_process(procs.begin());
             }
 
-            /* Helper function for sub-process setting: */
+            /* Helper function for sub-process setting. The event refers to
+             * the subprocess descriptor of the process generator, so no copy
+             * is made: */
 
             void set_sub_process(process_iterator it)
             {
                 sub_proc=it;
                 if(sub_proc!=procs.end())
                 {
-                    this->get_event_ptr()->set_process(sub_proc->generator->get_process().clone(),sub_proc-procs.begin());
+                    this->get_event_ptr()->set_process_reference(&(sub_proc->generator->get_process()),sub_proc-procs.begin());
                 }
             }
 
@@ -21,6 +21,7 @@
 
 #include <Camgen/evt_stream.h>
 #include <Camgen/evt_output_conf.h>
+#include <Camgen/gz_ostream.h>
 
 namespace Camgen
 {
@@ -110,7 +111,7 @@ namespace Camgen
 		    return false;
 		}
 		std::ofstream ofs;
-		std::string fname(output->file_name+"_stats.dat");
+		std::string fname(gz_ofstream::base_name(output->file_name)+"_stats.dat");
 		ofs.open(fname.c_str());
 		if(ofs.is_open())
 		{
@@ -6,24 +6,36 @@
 //
 
 /*! \file evt_queue.h
-  \brief Event interface copying input events into a queue on the heap.
+  \brief Event interface copying input events into a ring of event slots.
 */
 
 #ifndef CAMGEN_EVT_QUEUE_H_
 #define CAMGEN_EVT_QUEUE_H_
 
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
- * Partial implementation of the event stream interface that *
- * pushes the events to a queue in memory.                   *
- *                                                           *
- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Partial implementation of the event stream interface that copies the      *
+ * events into a ring of preallocated event slots. By default the ring grows *
+ * when it is full. In concurrent mode the capacity is fixed, and a single   *
+ * producer thread may fill the queue while a single consumer thread reads   *
+ * and pops it. The indices are atomic, and a producer finding the ring full *
+ * waits until the consumer pops an event. Concurrent mode requires C++11;   *
+ * with older compilers the flag is ignored and the ring always grows.       *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <vector>
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#endif
 #include <Camgen/evt_stream.h>
-#include <queue>
+#include <Camgen/evt_data.h>
 
 namespace Camgen
 {
-    /// Partial event interface implementation copying events to a queue in memory.
+    /// Partial event interface implementation copying events to a ring
+    /// buffer in memory.
 
     template<class model_t,std::size_t N_in,std::size_t N_out>class event_queue: public event_stream<model_t,N_in,N_out>
     {
@@ -34,45 +46,73 @@ namespace Camgen
             /* Public type definitions: */
 
             typedef typename base_type::event_type event_type;
-            typedef typename std::queue<const event_type*>::size_type size_type;
+            typedef typename base_type::size_type size_type;
+            typedef event_data<model_t,N_in,N_out> slot_type;
+
+            /// Constructor with the number of preallocated event slots. If
+            /// the concurrent flag is set, the capacity is fixed and the queue
+            /// may be filled and popped by two different threads.
+
+#if __cplusplus >= 201103L
+            event_queue(size_type capacity_=64,bool concurrent_=false):concurrent(concurrent_),head(0),tail(0),waiting(false)
+#else
+            event_queue(size_type capacity_=64,bool concurrent_=false):concurrent(false),head(0),tail(0)
+#endif
+            {
+                slots.resize(capacity_>0?capacity_:1);
+                for(size_type i=0;i<slots.size();++i)
+                {
+                    slots[i]=new slot_type();
+                }
+            }
 
             /// Virtual destructor.
 
             virtual ~event_queue()
             {
-                while(!empty())
+                for(size_type i=0;i<slots.size();++i)
                 {
-                    delete evt_queue.front();
-                    evt_queue.pop();
+                    delete slots[i];
                 }
             }
 
+            /// Concurrent mode flag.
+
+            const bool concurrent;
+
             /// Returns whether the queue contains events.
 
             bool empty() const
             {
-                return evt_queue.empty();
+                return load_head()==load_tail();
             }
 
             /// Returns the number of events in the queue.
 
             size_type size() const
             {
-                return evt_queue.size();
+                return load_head()-load_tail();
+            }
+
+            /// Returns the number of event slots.
+
+            size_type capacity() const
+            {
+                return slots.size();
             }
 
             /// Returns the front of the queue (oldest event).
 
             const event_type* front() const
             {
-                return evt_queue.front();
+                return slots[load_tail()%slots.size()];
             }
 
             /// Returns the back of the queue (newest event).
 
             const event_type* back() const
             {
-                return evt_queue.back();
+                return slots[(load_head()-1)%slots.size()];
             }
 
             /// Pops the front of the queue.
@@ -83,11 +123,45 @@ namespace Camgen
                 {
                     return false;
                 }
-                delete evt_queue.front();
-                evt_queue.pop();
+                store_tail(load_tail()+1);
+#if __cplusplus >= 201103L
+                if(concurrent and waiting.load(std::memory_order_seq_cst))
+                {
+                    std::lock_guard<std::mutex>lock(mutex);
+                    not_full.notify_one();
+                }
+#endif
                 return true;
             }
 
+            /// Copies the argument event to the back of the queue. If the
+            /// queue is full, the ring grows, or in concurrent mode, waits for
+            /// the consumer to pop an event.
+
+            void push(const event_type& evt)
+            {
+                size_type n=load_head();
+                if(n-load_tail()==slots.size())
+                {
+#if __cplusplus >= 201103L
+                    if(concurrent)
+                    {
+                        wait_for_slot(n);
+                    }
+                    else
+                    {
+                        grow();
+                        n=load_head();
+                    }
+#else
+                    grow();
+                    n=load_head();
+#endif
+                }
+                slots[n%slots.size()]->copy_event(evt);
+                store_head(n+1);
+            }
+
             /// Event size implementation.
 
             size_type event_size() const
@@ -113,15 +187,117 @@ namespace Camgen
 
             bool fill_event(const event_type& evt)
             {
-                evt_queue.push(evt.clone());
+                push(evt);
                 return true;
             }
 
         private:
 
-            std::queue<const event_type*> evt_queue;
+            /* Event slots: */
+
+            std::vector<slot_type*> slots;
+
+#if __cplusplus >= 201103L
+
+            /* Number of events pushed and popped: */
+
+            std::atomic<size_type> head,tail;
+
+            /* Flag denoting whether the producer waits for a free slot: */
+
+            std::atomic<bool> waiting;
+
+            /* Mutex and condition signalled by the consumer when the waiting
+             * producer may continue: */
+
+            std::mutex mutex;
+            std::condition_variable not_full;
+
+            /* Index accessors: */
+
+            size_type load_head() const
+            {
+                return head.load(std::memory_order_acquire);
+            }
+            size_type load_tail() const
+            {
+                return tail.load(std::memory_order_acquire);
+            }
+            void store_head(size_type n)
+            {
+                head.store(n,std::memory_order_release);
+            }
+
+            /* Sequentially consistent, so a consumer cannot miss the
+             * waiting flag of a producer that read the old tail: */
+
+            void store_tail(size_type n)
+            {
+                tail.store(n,std::memory_order_seq_cst);
+            }
+
+            /* Blocks the producer until the consumer has popped the event
+             * preceding the argument push count by a full ring: */
+
+            void wait_for_slot(size_type n)
+            {
+                std::unique_lock<std::mutex>lock(mutex);
+                waiting.store(true,std::memory_order_seq_cst);
+                while(n-tail.load(std::memory_order_seq_cst)==slots.size())
+                {
+                    not_full.wait(lock);
+                }
+                waiting.store(false,std::memory_order_relaxed);
+            }
+#else
+
+            /* Number of events pushed and popped: */
+
+            size_type head,tail;
+
+            /* Index accessors: */
+
+            size_type load_head() const
+            {
+                return head;
+            }
+            size_type load_tail() const
+            {
+                return tail;
+            }
+            void store_head(size_type n)
+            {
+                head=n;
+            }
+            void store_tail(size_type n)
+            {
+                tail=n;
+            }
+#endif
+
+            /* Doubles the number of slots, moving the queued events to the
+             * front of the ring: */
+
+            void grow()
+            {
+                size_type n=slots.size();
+                size_type t=load_tail();
+                std::vector<slot_type*> new_slots(2*n);
+                for(size_type i=0;i<n;++i)
+                {
+                    new_slots[i]=slots[(t+i)%n];
+                    new_slots[n+i]=new slot_type();
+                }
+                slots.swap(new_slots);
+                store_tail(0);
+                store_head(n);
+            }
+
+            /* Copying is not supported: */
+
+            event_queue(const event_queue<model_t,N_in,N_out>&);
+            event_queue<model_t,N_in,N_out>& operator = (const event_queue<model_t,N_in,N_out>&);
     };
 }
 
 #endif /*CAMGEN_EVT_QUEUE_H_*/
-
@@ -137,17 +137,44 @@ namespace Camgen
 
 		procs.clear();
 		procs.reserve(amplitude.n_trees());
+
+		/* For the concurrent initialisation, the subprocesses are
+		 * distributed round-robin over the amplitude and copies of it,
+		 * each of which is initialised by a separate thread. This
+		 * requires independent random number substreams: */
+
+		std::vector<amplitude_type*>amplitudes(1,&amplitude);
+		std::size_t n_amplitudes=std::min(init_threads(),(std::size_t)amplitude.n_trees());
+		if(n_amplitudes>1 and !rn_substream<rng_t>::value)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"random number engine provides no substreams--initialising subprocesses sequentially"<<endlog;
+		    n_amplitudes=1;
+		}
+		for(std::size_t i=1;i<n_amplitudes;++i)
+		{
+		    amplitudes.push_back(new amplitude_type(amplitude));
+		    evtgen->amplitude_copies.push_back(amplitudes.back());
+		}
 		if(amplitude.reset_process())
 		{
+		    for(std::size_t i=1;i<amplitudes.size();++i)
+		    {
+			amplitudes[i]->reset_process();
+		    }
 		    int id=1;
 		    do
 		    {
 			if(!amplitude.get_tree_iterator()->is_empty())
 			{
-                            process_generator_type* proc_gen=process_generator_factory->create_generator(amplitude.get_tree_iterator(),*conf,id++);
-			    typename event_generator_type::subprocess_type subproc={proc_gen,1.0};
+			    amplitude_type* amp=amplitudes[(id-1)%amplitudes.size()];
+                            process_generator_type* proc_gen=process_generator_factory->create_generator(amp->get_tree_iterator(),*conf,id++);
+			    typename event_generator_type::subprocess_type subproc={proc_gen,1.0,amp,NULL};
                             procs.push_back(subproc);
 			}
+			for(std::size_t i=1;i<amplitudes.size();++i)
+			{
+			    amplitudes[i]->next_process();
+			}
 		    }
 		    while(amplitude.next_process());
 
@@ -161,6 +188,7 @@ namespace Camgen
 			{
 			    procs[i].alpha=alpha;
 			}
+			evtgen->refresh_alpha_sums();
 			evtgen->set_sub_process(procs.begin());
 		    }
 		    else
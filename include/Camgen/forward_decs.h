@@ -48,6 +48,7 @@ namespace Camgen
 	/// The template parameter denote the model type, incoming and outgoing number of particles in the
 	/// process, and a boolean denoting whether the helicities are continuous. 
 	
+	template<class model_t,std::size_t N,bool decomp>class instruction_array;
 	template<class model_t,std::size_t N,bool decomp>class interaction;
 	template<class model_t,std::size_t N>class interaction_base;
 	template<class model_t>class m_anti_fermion_wave_function;
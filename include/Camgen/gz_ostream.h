@@ -0,0 +1,134 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file gz_ostream.h
+    \brief Output file stream with transparent gzip compression.
+ */
+
+#ifndef CAMGEN_GZ_OSTREAM_H_
+#define CAMGEN_GZ_OSTREAM_H_
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Output file stream compressing its contents with zlib if the file name    *
+ * ends with '.gz', and writing a plain file otherwise. The compressing      *
+ * buffer is compiled into the library, so the zlib support is fixed when    *
+ * Camgen is configured (see zlib_support()); without it, compressed file    *
+ * names are written uncompressed without the '.gz' extension.               *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <string>
+#include <fstream>
+
+namespace Camgen
+{
+    /// Output file stream, compressing the data if the file name ends with
+    /// '.gz'.
+
+    class gz_ofstream: public std::ostream
+    {
+	public:
+
+	    /// Default constructor.
+
+	    gz_ofstream():std::ostream(NULL),gz_buf(NULL),compressed(false){}
+
+	    /// Destructor.
+
+	    ~gz_ofstream();
+
+	    /// Returns whether the argument file name ends with '.gz'.
+
+	    static bool is_compressed(const std::string& fname)
+	    {
+		return fname.size()>3 and fname.compare(fname.size()-3,3,".gz")==0;
+	    }
+
+	    /// Returns the argument file name without a '.gz' extension.
+
+	    static std::string base_name(const std::string& fname)
+	    {
+		return is_compressed(fname)?fname.substr(0,fname.size()-3):fname;
+	    }
+
+	    /// Returns the name of the file with the argument extension, placing
+	    /// it before the '.gz' extension if present.
+
+	    static std::string file_name(const std::string& fname,const std::string& ext)
+	    {
+		return is_compressed(fname)?(base_name(fname)+ext+".gz"):(fname+ext);
+	    }
+
+	    /// Sets the zlib compression level (0-9, or -1 for the zlib default)
+	    /// of subsequently opened compressed files.
+
+	    static bool set_compression_level(int n)
+	    {
+		if(n<-1 or n>9)
+		{
+		    return false;
+		}
+		level()=n;
+		return true;
+	    }
+
+	    /// Returns the compression level of compressed files.
+
+	    static int compression_level()
+	    {
+		return level();
+	    }
+
+	    /// Returns whether the library was built with zlib, i.e. whether
+	    /// files with '.gz' names are compressed.
+
+	    static bool zlib_support();
+
+	    /// Opens the argument file.
+
+	    bool open(const std::string& fname);
+
+	    /// Returns whether a file is open.
+
+	    bool is_open() const;
+
+	    /// Flushes and closes the file.
+
+	    bool close();
+
+	private:
+
+	    /* Plain file buffer: */
+
+	    std::filebuf file_buf;
+
+	    /* Compressing buffer, allocated by the library at the first
+	     * compressed file: */
+
+	    std::streambuf* gz_buf;
+
+	    /* Compression flag of the open file: */
+
+	    bool compressed;
+
+	    /* Compression level storage: */
+
+	    static int& level()
+	    {
+		static int n=6;
+		return n;
+	    }
+
+	    /* Copying is not supported: */
+
+	    gz_ofstream(const gz_ofstream&);
+	    gz_ofstream& operator = (const gz_ofstream&);
+    };
+}
+
+#endif /*CAMGEN_GZ_OSTREAM_H_*/
+
@@ -208,6 +208,34 @@ namespace Camgen
 		xgen->adapt();
 	    }
 
+	    /* Sets the number of worker threads updating the grid: */
+
+	    void set_update_workers(size_type n)
+	    {
+		xgen->set_update_workers(n);
+	    }
+
+	    /* Merges the worker shadows into the grid: */
+
+	    void merge_shadows()
+	    {
+		xgen->merge_shadows();
+	    }
+
+	    /* Writes the adaptive grid to the binary output stream: */
+
+	    void save_state(std::ostream& os) const
+	    {
+		xgen->save_state(os);
+	    }
+
+	    /* Reads the adaptive grid from the binary input stream: */
+
+	    bool load_state(std::istream& is)
+	    {
+		return xgen->load_state(is);
+	    }
+
 	    /* Resets adaptive grids: */
 
 	    void reset()
@@ -647,6 +675,37 @@ namespace Camgen
 		y_gen->adapt();
 	    }
 
+	    /* Sets the number of worker threads updating the grids: */
+
+	    void set_update_workers(size_type n)
+	    {
+		tau_gen->set_update_workers(n);
+		y_gen->set_update_workers(n);
+	    }
+
+	    /* Merges the worker shadows into the grids: */
+
+	    void merge_shadows()
+	    {
+		tau_gen->merge_shadows();
+		y_gen->merge_shadows();
+	    }
+
+	    /* Writes the adaptive grids to the binary output stream: */
+
+	    void save_state(std::ostream& os) const
+	    {
+		tau_gen->save_state(os);
+		y_gen->save_state(os);
+	    }
+
+	    /* Reads the adaptive grids from the binary input stream: */
+
+	    bool load_state(std::istream& is)
+	    {
+		return (tau_gen->load_state(is) and y_gen->load_state(is));
+	    }
+
 	    /* Resets adaptive grids: */
 
 	    void reset()
@@ -1021,6 +1080,34 @@ namespace Camgen
 		y_gen->adapt();
 	    }
 
+	    /* Sets the number of worker threads updating the grid: */
+
+	    void set_update_workers(size_type n)
+	    {
+		y_gen->set_update_workers(n);
+	    }
+
+	    /* Merges the worker shadows into the grid: */
+
+	    void merge_shadows()
+	    {
+		y_gen->merge_shadows();
+	    }
+
+	    /* Writes the adaptive grid to the binary output stream: */
+
+	    void save_state(std::ostream& os) const
+	    {
+		y_gen->save_state(os);
+	    }
+
+	    /* Reads the adaptive grid from the binary input stream: */
+
+	    bool load_state(std::istream& is)
+	    {
+		return y_gen->load_state(is);
+	    }
+
 	    /* Resets adaptive grids: */
 
 	    void reset()
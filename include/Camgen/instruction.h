@@ -0,0 +1,309 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#ifndef CAMGEN_INSTRUCTION_H_
+#define CAMGEN_INSTRUCTION_H_
+
+#include <vector>
+#include <bitset>
+#include <Camgen/forward_decs.h>
+#include <Camgen/current.h>
+#include <Camgen/interaction.h>
+#include <Camgen/def_args.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Definition of the instruction array class template, the lowered evaluation *
+ * schedule of a process tree. Once the interactions of a tree are built and   *
+ * their momentum policies assigned, every interaction is translated into an   *
+ * instruction holding the Feynman rule address, the Fermi sign and offsets    *
+ * into one operand arena, in which the subamplitude iterators, momentum      *
+ * addresses and current addresses of all interactions are stored back to     *
+ * back, and into one coupling arena. Evaluating the tree then amounts to a    *
+ * single sweep over these contiguous blocks. In colour-flow decomposition     *
+ * mode the Feynman rules are applied to every combination of nonzero colour  *
+ * components of the interacting currents, and the instructions simply refer  *
+ * to the interaction objects of the tree.                                     *
+ *                                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+namespace Camgen
+{
+    /* Lowered interaction for models without colour-flow decomposition: */
+
+    template<class model_t,std::size_t N>class instruction
+    {
+	public:
+
+	    /* The usual type definitions: */
+
+	    DEFINE_BASIC_TYPES(model_t);
+
+	    /* Vertex and Feynman rule type definitions: */
+
+	    typedef typename get_basic_types<model_t>::vertex_type vertex_type;
+	    typedef typename get_basic_types<model_t>::vert_func vert_func;
+
+	    /* Recursive relation: */
+
+	    vert_func Feynman_rule;
+
+	    /* Fermi sign factor passed to the recursive relation: */
+
+	    value_type factor;
+
+	    /* Vertex address, queried for the decoupling flag: */
+
+	    const vertex_type* vertex;
+
+	    /* Offset of the operands in the operand arena: */
+
+	    size_type operands;
+
+	    /* Offset of the coupling addresses in the coupling arena: */
+
+	    size_type couplings;
+
+	    /* Number of operands: */
+
+	    size_type rank;
+
+	    /* Operand index of the produced current: */
+
+	    size_type produced;
+
+	    /* Momentum propagation policy, as in the interaction class: */
+
+	    std::bitset<3>policy;
+
+	    /* Momentum address to copy the produced momentum from: */
+
+	    const momentum_type* produced_momentum;
+    };
+
+    /* Instruction array for models without colour-flow decomposition: */
+
+    template<class model_t,std::size_t N>class instruction_array<model_t,N,false>
+    {
+	public:
+
+	    /* The usual type definitions: */
+
+	    DEFINE_BASIC_TYPES(model_t);
+
+	    /* Instruction, interaction and current type definitions: */
+
+	    typedef instruction<model_t,N> instruction_type;
+	    typedef interaction<model_t,N,false> interaction_type;
+	    typedef current<model_t,N,false> current_type;
+
+	    /* Translates the argument interactions, in order of evaluation,
+	     * into the instruction array: */
+
+	    void lower(std::vector<interaction_type>& interactions)
+	    {
+		clear();
+		size_type n_operands=0;
+		size_type n_couplings=0;
+		for(typename std::vector<interaction_type>::const_iterator it=interactions.begin();it!=interactions.end();++it)
+		{
+		    n_operands+=it->currents.size();
+		    n_couplings+=it->vertex_t->nr_of_couplings();
+		}
+		instructions.reserve(interactions.size());
+		iters.reserve(n_operands);
+		momenta.reserve(n_operands);
+		currents.reserve(n_operands);
+		couplings.reserve(n_couplings);
+		for(typename std::vector<interaction_type>::const_iterator it=interactions.begin();it!=interactions.end();++it)
+		{
+		    instruction_type I;
+		    I.Feynman_rule=it->Feynman_rule;
+		    I.factor=value_type(it->Fermi_sign,0);
+		    I.vertex=it->vertex_t;
+		    I.operands=iters.size();
+		    I.couplings=couplings.size();
+		    I.rank=it->currents.size();
+		    I.produced=it->produced_current;
+		    I.policy=it->prop_policy;
+		    I.produced_momentum=it->produced_momentum;
+		    for(size_type i=0;i<I.rank;++i)
+		    {
+			iters.push_back(it->amp_iters[i]);
+			momenta.push_back(it->momenta[i]);
+			currents.push_back(&(*(it->currents[i])));
+		    }
+		    const std::vector<const value_type*>& c=it->vertex_t->get_couplings();
+		    couplings.insert(couplings.end(),c.begin(),c.end());
+		    instructions.push_back(I);
+		}
+	    }
+
+	    /* Removes all instructions: */
+
+	    void clear()
+	    {
+		instructions.clear();
+		iters.clear();
+		momenta.clear();
+		currents.clear();
+		couplings.clear();
+	    }
+
+	    /* Number of instructions: */
+
+	    size_type size() const
+	    {
+		return instructions.size();
+	    }
+
+	    /* Executes all instructions in order: */
+
+	    void execute()
+	    {
+		for(size_type n=0;n<instructions.size();++n)
+		{
+		    execute(n);
+		}
+	    }
+
+	    /* Executes the n-th instruction: computes the produced momentum and
+	     * decoupling flag, applies the recursive relation and propagates
+	     * the produced current: */
+
+	    void execute(size_type n)
+	    {
+		const instruction_type& I=instructions[n];
+		current_type* const* c=&currents[I.operands];
+		current_type* produced=c[I.produced];
+		if(I.policy[0])
+		{
+		    produced->momentum.assign((r_value_type)0);
+		    for(size_type i=0;i<I.rank;++i)
+		    {
+			if(i!=I.produced)
+			{
+			    produced->momentum+=c[i]->momentum;
+			}
+		    }
+		}
+		else if(I.policy[1])
+		{
+		    produced->momentum=*(I.produced_momentum);
+		}
+		bool coupled=I.vertex->is_coupled();
+		for(size_type i=0;i<I.rank and coupled;++i)
+		{
+		    if(i!=I.produced)
+		    {
+			coupled&=c[i]->coupled;
+		    }
+		}
+		if(I.policy[0] or I.policy[1])
+		{
+		    produced->coupled=coupled;
+		}
+		else
+		{
+		    produced->coupled|=coupled;
+		}
+		if(coupled)
+		{
+		    I.Feynman_rule(I.factor,couplings.empty()?NULL:&couplings[0]+I.couplings,&iters[I.operands],&momenta[I.operands]);
+		}
+		if(I.policy[2])
+		{
+		    produced->propagate();
+		}
+	    }
+
+	private:
+
+	    /* Instruction array: */
+
+	    std::vector<instruction_type>instructions;
+
+	    /* Operand arena, stored as parallel arrays of the subamplitude
+	     * iterators, momentum addresses and current addresses: */
+
+	    std::vector<iterator>iters;
+	    std::vector<const momentum_type*>momenta;
+	    std::vector<current_type*>currents;
+
+	    /* Coupling arena: */
+
+	    std::vector<const value_type*>couplings;
+    };
+
+    /* Instruction array for models with colour-flow decomposition, executing
+     * the interaction objects in place: */
+
+    template<class model_t,std::size_t N>class instruction_array<model_t,N,true>
+    {
+	public:
+
+	    /* The usual type definitions: */
+
+	    DEFINE_BASIC_TYPES(model_t);
+
+	    /* Interaction type definition: */
+
+	    typedef interaction<model_t,N,true> interaction_type;
+
+	    /* Constructor: */
+
+	    instruction_array():interactions(NULL){}
+
+	    /* Refers the instructions to the argument interactions: */
+
+	    void lower(std::vector<interaction_type>& v)
+	    {
+		interactions=&v;
+	    }
+
+	    /* Removes all instructions: */
+
+	    void clear()
+	    {
+		interactions=NULL;
+	    }
+
+	    /* Number of instructions: */
+
+	    size_type size() const
+	    {
+		return (interactions==NULL)?0:interactions->size();
+	    }
+
+	    /* Executes all instructions in order: */
+
+	    void execute()
+	    {
+		for(size_type n=0;n<size();++n)
+		{
+		    execute(n);
+		}
+	    }
+
+	    /* Executes the n-th instruction: */
+
+	    void execute(size_type n)
+	    {
+		(*interactions)[n].evaluate();
+	    }
+
+	private:
+
+	    /* Interactions of the process tree: */
+
+	    std::vector<interaction_type>* interactions;
+    };
+}
+
+#include <Camgen/undef_args.h>
+
+#endif /*CAMGEN_INSTRUCTION_H_*/
+
@@ -71,6 +71,10 @@ namespace Camgen
 
 	    template<class mod,std::size_t N_in,std::size_t N_out>friend class process_tree;
 
+	    /* Friend declaration of the instruction array class template: */
+
+	    template<class mod,std::size_t M,bool decomp>friend class instruction_array;
+
 	    /* Trivial constructor: */
 
 	    interaction_base():vertex_t(NULL),produced_current(0),Feynman_rule(NULL),swap_fermions(false),Fermi_sign(1),flow(0),CM_tag(false),coupled(vertex_t->is_coupled()),produced_momentum(NULL)
@@ -88,7 +92,7 @@ namespace Camgen
 
 	    /* Copy constructor: */
 
-	    interaction_base(const interaction_base<model_t,N>& other):vertex_t(other.vertex_t),currents(other.currents),amp_iters(other.amp_iters),momenta(other.momenta),produced_current(other.produced_current),Feynman_rule(other.Feynman_rule),swap_fermions(false),Fermi_sign(other.Fermi_sign),flow(other.flow),CM_tag(other.CM_tag),coupled(other.coupled),prop_policy(other.prop_policy),produced_momentum(other.produced_momentum)
+	    interaction_base(const interaction_base<model_t,N>& other):vertex_t(other.vertex_t),currents(other.currents),amp_iters(other.amp_iters),momenta(other.momenta),produced_current(other.produced_current),Feynman_rule(other.Feynman_rule),swap_fermions(other.swap_fermions),Fermi_sign(other.Fermi_sign),flow(other.flow),CM_tag(other.CM_tag),coupled(other.coupled),prop_policy(other.prop_policy),produced_momentum(other.produced_momentum)
 	    {
 		++object_counter;
 	    }
@@ -126,6 +130,13 @@ namespace Camgen
 		return vertex_t;
 	    }
 
+	    /* Produced leg readout: */
+
+	    size_type get_produced_leg() const
+	    {
+		return produced_current;
+	    }
+
 	    /* CM_tag readout: */
 
 	    bool is_marked() const
@@ -264,6 +275,13 @@ namespace Camgen
 		Fermi_sign=1;
 	    }
 
+	    /* Fermi sign readout: */
+
+	    int get_Fermi_sign() const
+	    {
+		return Fermi_sign;
+	    }
+
 	    /* Function resetting the produced current: */
 
 	    void reset()
@@ -367,6 +385,24 @@ namespace Camgen
 		}
 	    }
 
+	    /* Function moving the current iterators from the current vector
+	     * starting at the first argument to the (copied) current vector
+	     * starting at the second argument: */
+
+	    void rebind(current_iterator old_begin,current_iterator new_begin)
+	    {
+		for(size_type i=0;i<currents.size();++i)
+		{
+		    currents[i]=new_begin+(currents[i]-old_begin);
+		    momenta[i]=&(currents[i]->momentum);
+		    amp_iters[i]=currents[i]->amplitude.begin();
+		}
+		if(swap_fermions)
+		{
+		    std::swap(amp_iters[1],amp_iters[2]);
+		}
+	    }
+
 	    /* Function computing the memory usage of all interaction objects
 	     * together in the program: */
 
@@ -712,7 +748,7 @@ namespace Camgen
 		this->compute_coupling_flag();
 		if(this->coupled)
 		{
-		    this->Feynman_rule(value_type(this->Fermi_sign,0),this->vertex_t->get_couplings(),this->amp_iters,this->momenta);
+		    this->Feynman_rule(value_type(this->Fermi_sign,0),this->vertex_t->get_coupling_addresses(),&(this->amp_iters[0]),&(this->momenta[0]));
 		}
 		this->propagate();
 	    }
@@ -776,7 +812,7 @@ namespace Camgen
 			do
 			{
 			    import_iters();
-			    this->Feynman_rule(value_type(this->Fermi_sign,0),this->vertex_t->get_couplings(),this->amp_iters,this->momenta,this->currents[this->produced_current]->amp_iters);
+			    this->Feynman_rule(value_type(this->Fermi_sign,0),this->vertex_t->get_coupling_addresses(),&(this->amp_iters[0]),&(this->momenta[0]),this->currents[this->produced_current]->amp_iters);
 			}
 			while(next_iters());
 		    }
@@ -797,7 +833,7 @@ namespace Camgen
 	    {
 		for(size_type i=0;i<this->produced_current;++i)
 		{
-		    if(this->currents[i]->amp_iters.size()==0)
+		    if(this->currents[i]->amp_iters.empty())
 		    {
 			return false;
 		    }
@@ -805,7 +841,7 @@ namespace Camgen
 		}
 		for(size_type i=this->produced_current+1;i<this->currents.size();++i)
 		{
-		    if(this->currents[i]->amp_iters.size()==0)
+		    if(this->currents[i]->amp_iters.empty())
 		    {
 			return false;
 		    }
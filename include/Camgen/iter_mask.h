@@ -0,0 +1,247 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#ifndef CAMGEN_ITER_MASK_H_
+#define CAMGEN_ITER_MASK_H_
+
+#include <vector>
+#include <cstddef>
+#include <climits>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Declaration and definition of the iterator_mask class template, a set of     *
+ * tensor iterators into a single tensor, stored as a bitmask over the iterator *
+ * offsets. It replaces the stl set of propagating colour modes in the colour-   *
+ * decomposed currents: insertion is a single bit operation, clearance zeroes   *
+ * the words without releasing memory, and iteration runs over the set bits in *
+ * increasing offset order, skipping empty words. After the first event no      *
+ * memory is allocated.                                                          *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+namespace Camgen
+{
+    template<class iterator_t>class iterator_mask
+    {
+	public:
+
+	    /* Type definitions: */
+
+	    typedef iterator_t value_type;
+	    typedef std::size_t size_type;
+	    typedef unsigned long word_type;
+
+	    /* Number of bits per word: */
+
+	    static const size_type word_bits=sizeof(word_type)*CHAR_BIT;
+
+	    /* Forward iterator class declaration: */
+
+	    class const_iterator;
+	    friend class const_iterator;
+
+	    /* Forward iterator over the set bits, dereferencing to tensor
+	     * iterators: */
+
+	    class const_iterator
+	    {
+		public:
+
+		    /* Trivial constructor: */
+
+		    const_iterator():mask(NULL),pos(0){}
+
+		    /* Constructor from the mask and a starting bit position,
+		     * which is moved to the first set bit: */
+
+		    const_iterator(const iterator_mask<iterator_t>* m,size_type n):mask(m),pos(n)
+		    {
+			seek();
+		    }
+
+		    /* Dereferencing operators: */
+
+		    const iterator_t& operator * () const
+		    {
+			return value;
+		    }
+		    const iterator_t* operator -> () const
+		    {
+			return &value;
+		    }
+
+		    /* Pre-increment operator: */
+
+		    const_iterator& operator ++ ()
+		    {
+			++pos;
+			seek();
+			return *this;
+		    }
+
+		    /* Post-increment operator: */
+
+		    const_iterator operator ++ (int)
+		    {
+			const_iterator result(*this);
+			++(*this);
+			return result;
+		    }
+
+		    /* Comparison operators: */
+
+		    bool operator == (const const_iterator& other) const
+		    {
+			return pos==other.pos;
+		    }
+		    bool operator != (const const_iterator& other) const
+		    {
+			return pos!=other.pos;
+		    }
+
+		private:
+
+		    /* Mask address: */
+
+		    const iterator_mask<iterator_t>* mask;
+
+		    /* Bit position: */
+
+		    size_type pos;
+
+		    /* Tensor iterator at the current position: */
+
+		    iterator_t value;
+
+		    /* Moves the position to the first set bit at or after the
+		     * current one, skipping empty words: */
+
+		    void seek()
+		    {
+			size_type n=mask->words.size()*word_bits;
+			while(pos<n)
+			{
+			    word_type w=mask->words[pos/word_bits]>>(pos%word_bits);
+			    if(w==0)
+			    {
+				pos=(pos/word_bits+1)*word_bits;
+				continue;
+			    }
+			    while((w&1)==0)
+			    {
+				w>>=1;
+				++pos;
+			    }
+			    value=mask->origin+pos;
+			    return;
+			}
+			pos=n;
+		    }
+	    };
+
+	    /* Elements are immutable, as in stl sets: */
+
+	    typedef const_iterator iterator;
+
+	    /* Trivial constructor: */
+
+	    iterator_mask(){}
+
+	    /* Binds the mask to the tensor starting at the argument iterator,
+	     * with n components. Clears the mask: */
+
+	    void bind(const iterator_t& first,size_type n)
+	    {
+		origin=first;
+		words.assign((n+word_bits-1)/word_bits,0);
+	    }
+
+	    /* Copies the set bits of another mask, keeping the own tensor
+	     * binding: */
+
+	    void copy_bits(const iterator_mask<iterator_t>& other)
+	    {
+		words=other.words;
+	    }
+
+	    /* Inserts the argument tensor iterator: */
+
+	    void insert(const iterator_t& it)
+	    {
+		size_type n=it.get_offset();
+		if(n/word_bits>=words.size())
+		{
+		    words.resize(n/word_bits+1,0);
+		}
+		words[n/word_bits]|=(word_type(1)<<(n%word_bits));
+	    }
+
+	    /* Removes all elements: */
+
+	    void clear()
+	    {
+		for(size_type i=0;i<words.size();++i)
+		{
+		    words[i]=0;
+		}
+	    }
+
+	    /* Returns whether the set is empty: */
+
+	    bool empty() const
+	    {
+		for(size_type i=0;i<words.size();++i)
+		{
+		    if(words[i]!=0)
+		    {
+			return false;
+		    }
+		}
+		return true;
+	    }
+
+	    /* Returns the number of elements: */
+
+	    size_type size() const
+	    {
+		size_type n=0;
+		for(size_type i=0;i<words.size();++i)
+		{
+		    for(word_type w=words[i];w!=0;w&=(w-1))
+		    {
+			++n;
+		    }
+		}
+		return n;
+	    }
+
+	    /* Iterators to the first and past-the-last elements: */
+
+	    const_iterator begin() const
+	    {
+		return const_iterator(this,0);
+	    }
+	    const_iterator end() const
+	    {
+		return const_iterator(this,words.size()*word_bits);
+	    }
+
+	private:
+
+	    /* Iterator at the first tensor component: */
+
+	    iterator_t origin;
+
+	    /* Bit words: */
+
+	    std::vector<word_type>words;
+    };
+    template<class iterator_t>const typename iterator_mask<iterator_t>::size_type iterator_mask<iterator_t>::word_bits;
+}
+
+#endif /*CAMGEN_ITER_MASK_H_*/
+
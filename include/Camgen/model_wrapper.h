@@ -217,6 +217,25 @@ namespace Camgen
 		return particle_content.size();
 	    }
 
+	    /* Number of vertices in the model: */
+
+	    static size_type vertices()
+	    {
+		return vertex_content.size();
+	    }
+
+	    /* Returns the n-th vertex of the model, or NULL if the argument is
+	     * out of range: */
+
+	    static const vertex_type* get_vertex(size_type n)
+	    {
+		if(n < vertex_content.size())
+		{
+		    return vertex_content[n];
+		}
+		return NULL;
+	    }
+
 	    /* Particle fusion finder function: */
 
 	    static std::pair<fusion_iterator,fusion_iterator>find_fusion(const std::vector<const particle_type*>& parts)
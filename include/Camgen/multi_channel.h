@@ -201,7 +201,8 @@ namespace Camgen
 		return true;
 	    }
 
-	    /// Updates internal multichannel weights.
+	    /// Updates internal multichannel weights with the event stored in
+	    /// the instance. Worker threads should use accumulate() instead.
 
 	    void update()
 	    {
@@ -229,10 +230,92 @@ namespace Camgen
 		++update_counter;
 	    }
 
+	    /// Thread-safe update of the multichannel weights for worker
+	    /// threads (see shadow_acc.h). The arguments are the integrand and
+	    /// the weights of the channel generators for the event; the
+	    /// contributions are added to the worker's shadow. Called by the
+	    /// owning thread, updates the channel weights in place.
+
+	    void accumulate(const value_type& f,const std::vector<value_type>& channel_weights)
+	    {
+		if(channels.size()<=1 or channel_weights.size()!=channels.size())
+		{
+		    return;
+		}
+		value_type g(0);
+		bool zero_weight=false;
+		for(size_type i=0;i<channels.size();++i)
+		{
+		    if(channel_weights[i]==(value_type)0 and channels[i].alpha>(value_type)0)
+		    {
+			zero_weight=true;
+		    }
+		    else if(channel_weights[i]!=(value_type)0)
+		    {
+			g+=(channels[i].alpha/channel_weights[i]);
+		    }
+		}
+		value_type w2=f*f;
+		value_type w3=zero_weight?(value_type)0:(w2/g);
+		channel_sums* s=shadows.local();
+		if(s==NULL)
+		{
+		    for(size_type i=0;i<channels.size();++i)
+		    {
+			channels[i].W+=(channel_weights[i]==(value_type)0)?w2:(w3/channel_weights[i]);
+		    }
+		    if(w3!=(value_type)0)
+		    {
+			update_flag=true;
+		    }
+		    ++update_counter;
+		    return;
+		}
+		s->W.resize(channels.size(),(value_type)0);
+		for(size_type i=0;i<channels.size();++i)
+		{
+		    s->W[i]+=(channel_weights[i]==(value_type)0)?w2:(w3/channel_weights[i]);
+		}
+		s->flag|=(w3!=(value_type)0);
+		++(s->n);
+	    }
+
+	    /// Sets the number of worker threads accumulating multichannel
+	    /// updates. Pending shadow updates are merged first.
+
+	    void set_update_workers(size_type n)
+	    {
+		merge_shadows();
+		shadows.resize(n);
+	    }
+
+	    /// Adds the updates collected by the workers to the channel weight
+	    /// sums, in worker order. Called by adapt(). Shadows collected for a
+	    /// different set of channels are discarded.
+
+	    void merge_shadows()
+	    {
+		for(size_type i=0;i<shadows.size();++i)
+		{
+		    channel_sums& s=shadows[i];
+		    if(s.n!=0 and s.W.size()==channels.size())
+		    {
+			for(size_type j=0;j<channels.size();++j)
+			{
+			    channels[j].W+=s.W[j];
+			}
+			update_counter+=s.n;
+			update_flag|=s.flag;
+		    }
+		    s=channel_sums();
+		}
+	    }
+
 	    /// Adapts multichannel weights.
 
 	    void adapt()
 	    {
+		merge_shadows();
 		if(channels.size()<2 || !update_flag)
 		{
 		    return;
@@ -248,6 +331,43 @@ namespace Camgen
 		update_counter=0;
 	    }
 
+	    /// Writes the multichannel weights and the collected updates to the
+	    /// binary output stream.
+
+	    void save_state(std::ostream& os) const
+	    {
+		binary_io::write(os,channels.size());
+		for(const_channel_iterator it=channels.begin();it!=channels.end();++it)
+		{
+		    binary_io::write(os,it->alpha);
+		    binary_io::write(os,it->W);
+		}
+		binary_io::write(os,update_flag);
+		binary_io::write(os,update_counter);
+	    }
+
+	    /// Reads the multichannel weights and collected updates from the
+	    /// binary input stream. Returns false if the number of channels
+	    /// differs.
+
+	    bool load_state(std::istream& is)
+	    {
+		size_type n;
+		if(!binary_io::read(is,n) or n!=channels.size())
+		{
+		    return false;
+		}
+		for(channel_iterator it=channels.begin();it!=channels.end();++it)
+		{
+		    if(!(binary_io::read(is,it->alpha) and binary_io::read(is,it->W)))
+		    {
+			return false;
+		    }
+		}
+		current_channel_iterator=channels.end();
+		return (binary_io::read(is,update_flag) and binary_io::read(is,update_counter));
+	    }
+
 	    /// Removes and returns zero-weight channels
 
 	    std::vector<generator_type*> clean_channels()
@@ -299,7 +419,7 @@ namespace Camgen
 
 	    /// Queries whether the given generator is in the multichannel
 
-	    bool contains_generator(generator_type* generator) const
+	    bool contains_generator(const generator_type* generator) const
 	    {
 		match_channels predicate(generator);
 		return std::find_if(channels.begin(),channels.end(),predicate)!=channels.end();
@@ -324,6 +444,13 @@ namespace Camgen
 		return channels[i].generator;
 	    }
 
+	    /// Returns the i-th channel (no bound-checking).
+
+	    generator_type* generator(size_type i)
+	    {
+		return channels[i].generator;
+	    }
+
 	    /// Returns the i-th multichannel weight (no bound-checking).
 
 	    value_type alpha(size_type i) const
@@ -349,6 +476,19 @@ namespace Camgen
 
 	    size_type update_counter;
 
+	    /* Worker shadow of the channel weight sums: */
+
+	    struct channel_sums
+	    {
+		std::vector<value_type> W;
+		size_type n;
+		bool flag;
+
+		channel_sums():n(0),flag(false){}
+	    };
+
+	    shadow_accumulator<channel_sums> shadows;
+
 	    /* Normalises the channel weights: */
 
 	    void normalise_channel_weights()
@@ -0,0 +1,143 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file node_pool.h
+    \brief Fixed-size node storage pool.
+ */
+
+#ifndef CAMGEN_NODE_POOL_H_
+#define CAMGEN_NODE_POOL_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Storage pool for the nodes of linked data structures. Memory is obtained in  *
+ * contiguous chunks of nodes, and released nodes are kept in a free list, so   *
+ * repeated insertion and removal of nodes does not allocate and nodes created  *
+ * after each other are adjacent in memory. The pool only provides raw storage; *
+ * the nodes are constructed with placement new and destroyed explicitly.      *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+namespace Camgen
+{
+    /// Storage pool for objects of type T, allocated in chunks of N objects.
+
+    template<class T,std::size_t N=64>class node_pool
+    {
+	public:
+
+	    /// Number of nodes per chunk.
+
+	    static const std::size_t chunk_size=N;
+
+	    /// Constructor.
+
+	    node_pool():free_nodes(NULL){}
+
+	    /// Destructor. Releases the chunks; all nodes should have been
+	    /// destroyed.
+
+	    ~node_pool()
+	    {
+		for(std::size_t i=0;i<chunks.size();++i)
+		{
+		    delete[] chunks[i];
+		}
+	    }
+
+	    /// Returns storage for a single node, or NULL if no memory could be
+	    /// obtained.
+
+	    void* allocate()
+	    {
+		if(free_nodes==NULL and !grow())
+		{
+		    return NULL;
+		}
+		slot* s=free_nodes;
+		free_nodes=s->next;
+		return s->data;
+	    }
+
+	    /// Returns the argument node storage to the pool.
+
+	    void deallocate(void* p)
+	    {
+		slot* s=static_cast<slot*>(p);
+		s->next=free_nodes;
+		free_nodes=s;
+	    }
+
+	    /// Destroys the argument node and returns its storage to the pool.
+
+	    void destroy(T* p)
+	    {
+		p->~T();
+		deallocate(p);
+	    }
+
+	    /// Returns the number of nodes the pool can hold without
+	    /// allocating.
+
+	    std::size_t capacity() const
+	    {
+		return N*chunks.size();
+	    }
+
+	private:
+
+	    /* Node storage, aligned for the types used in the nodes: */
+
+	    union slot
+	    {
+		char data[sizeof(T)];
+		slot* next;
+		long double ld;
+		void* p;
+	    };
+
+	    /* Allocated chunks: */
+
+	    std::vector<slot*> chunks;
+
+	    /* Head of the free list: */
+
+	    slot* free_nodes;
+
+	    /* Allocates a new chunk and links its nodes into the free list in
+	     * ascending order: */
+
+	    bool grow()
+	    {
+		slot* chunk=new(std::nothrow) slot[N];
+		if(chunk==NULL)
+		{
+		    return false;
+		}
+		chunks.push_back(chunk);
+		for(std::size_t i=N;i>0;--i)
+		{
+		    chunk[i-1].next=free_nodes;
+		    free_nodes=chunk+(i-1);
+		}
+		return true;
+	    }
+
+	    /* Copying is not allowed: */
+
+	    node_pool(const node_pool<T,N>&);
+	    node_pool<T,N>& operator = (const node_pool<T,N>&);
+    };
+
+    template<class T,std::size_t N>const std::size_t node_pool<T,N>::chunk_size;
+}
+
+#endif /*CAMGEN_NODE_POOL_H_*/
+
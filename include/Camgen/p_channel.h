@@ -18,6 +18,7 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <list>
+#include <algorithm>
 #include <limits>
 #include <Camgen/bit_string.h>
 #include <Camgen/particle.h>
@@ -25,6 +26,7 @@
 #include <Camgen/multi_channel.h>
 #include <Camgen/uni_val_gen.h>
 #include <Camgen/Dirac_delta.h>
+#include <Camgen/val_gen_grid.h>
 
 namespace Camgen
 {
@@ -73,7 +75,7 @@ namespace Camgen
 	    /* Constructors: */
 	    /* ------------- */
 
-	    particle_channel(momentum_channel_type* ps_channel_,const particle<model_t>* particle_type_=NULL):particle_type(particle_type_),name(make_channel_name(particle_type_,ps_channel_->bitstring)),s_sampling_exponent(0),ps_channel(ps_channel_),s_gen(new uniform_value_generator<value_type,rng_t>())
+	    particle_channel(momentum_channel_type* ps_channel_,const particle<model_t>* particle_type_=NULL):particle_type(particle_type_),name(make_channel_name(particle_type_,ps_channel_->bitstring)),s_sampling_exponent(0),ps_channel(ps_channel_),s_gen(new uniform_value_generator<value_type,rng_t>()),memoise_s_weight(true)
 	    {
 		s_gen->set_value(&(ps_channel->s()));
 	    }
@@ -153,6 +155,13 @@ namespace Camgen
 		delete s_gen;
 		s_gen=s_gen_;
 		s_gen->set_value(&(ps_channel->s()));
+
+		/* Adaptive generators keep the state of their last evaluation for
+		 * the grid update, which a memoised density would not restore: */
+
+		memoise_s_weight=(dynamic_cast<adaptive_value_generator<value_type,rng_t>*>(s_gen)==NULL);
+		s_densities=s_density_cache();
+		t_densities=t_density_cache();
 		
 		Dirac_delta<value_type,rng_t>* dirac_delta=dynamic_cast<Dirac_delta<value_type,rng_t>*>(s_gen);
 
@@ -298,11 +307,84 @@ namespace Camgen
 		return s_gen->generate();
 	    }
 
-	    /* Evaluates the weight of the invariant mass generation. */
+	    /* Evaluates the weight of the invariant mass generation. The density
+	     * is memoised for the current event and sampling range, so that the
+	     * branchings sharing this channel evaluate it only once. */
 
 	    bool evaluate_s_weight()
 	    {
-		return s_gen->evaluate_weight();
+		if(!memoise_s_weight)
+		{
+		    return s_gen->evaluate_weight();
+		}
+		size_type n=ps_channel->evaluation_count();
+		value_type s=ps_channel->s();
+		value_type smin=s_gen->lower_bound();
+		value_type smax=s_gen->upper_bound();
+		for(size_type i=0;i<s_density_cache::size;++i)
+		{
+		    const s_density& d=s_densities.entries[i];
+		    if(d.evaluation==n and d.s==s and d.smin==smin and d.smax==smax)
+		    {
+			s_gen->weight()=d.weight;
+			return d.valid;
+		    }
+		}
+		bool q=s_gen->evaluate_weight();
+		s_density& d=s_densities.entries[s_densities.next];
+		d.evaluation=n;
+		d.s=s;
+		d.smin=smin;
+		d.smax=smax;
+		d.weight=s_gen->weight();
+		d.valid=q;
+		s_densities.next=(s_densities.next+1)%s_density_cache::size;
+		return q;
+	    }
+
+	    /* Looks up the t-branching density memoised for the current event
+	     * and the branching invariants (incoming, second beam, first and
+	     * second outgoing and total invariant masses-squared). On success,
+	     * restores the t-channel weight and returns the branching factor
+	     * excluding the timelike weights: */
+
+	    bool find_t_density(const value_type* invariants,value_type& factor,bool& valid)
+	    {
+		if(!memoise_s_weight)
+		{
+		    return false;
+		}
+		size_type n=ps_channel->evaluation_count();
+		for(size_type i=0;i<t_density_cache::size;++i)
+		{
+		    const t_density& d=t_densities.entries[i];
+		    if(d.evaluation==n and std::equal(invariants,invariants+5,d.invariants))
+		    {
+			s_gen->weight()=d.weight;
+			factor=d.factor;
+			valid=d.valid;
+			return true;
+		    }
+		}
+		return false;
+	    }
+
+	    /* Memoises the t-branching density for the current event and the
+	     * branching invariants, together with the current t-channel weight: */
+
+	    void memoise_t_density(const value_type* invariants,const value_type& factor,bool valid)
+	    {
+		if(!memoise_s_weight)
+		{
+		    return;
+		}
+		t_density& d=t_densities.entries[t_densities.next];
+		d.evaluation=ps_channel->evaluation_count();
+		std::copy(invariants,invariants+5,d.invariants);
+		d.weight=valid?s_gen->weight():(value_type)0;
+		d.factor=factor;
+		d.valid=valid;
+		t_densities.next=(t_densities.next+1)%t_density_cache::size;
 	    }
 
 	    /* Returns the weight corresponding to the generated incoming
@@ -337,6 +419,23 @@ namespace Camgen
 		s_gen->adapt();
 	    }
 
+	    /* Sets the number of worker threads updating the multichannel and
+	     * the invariant mass grid: */
+
+	    void set_update_workers(size_type n)
+	    {
+		branching_multichannel.set_update_workers(n);
+		s_gen->set_update_workers(n);
+	    }
+
+	    /* Merges the worker shadows: */
+
+	    void merge_shadows()
+	    {
+		branching_multichannel.merge_shadows();
+		s_gen->merge_shadows();
+	    }
+
 	    /* Adapts multichannel weights and vegas grids: */
 
 	    void adapt()
@@ -367,6 +466,64 @@ namespace Camgen
 		return result;
 	    }
 
+	    /* Writes the invariant mass grid, the branching grids and the
+	     * branching multichannel weights to the binary output stream. */
+
+	    void save_state(std::ostream& os) const
+	    {
+		s_gen->save_state(os);
+		size_type n=branching_count();
+		binary_io::write(os,n);
+		for(size_type i=0;i<n;++i)
+		{
+		    binary_io::write_string(os,branching(i)->signature());
+		    branching(i)->save_state(os);
+		}
+		branching_multichannel.save_state(os);
+	    }
+
+	    /* Reads the state written by save_state. Branchings missing in the
+	     * saved channel, which were thrown out during adaptation, are
+	     * removed from the multichannel. */
+
+	    bool load_state(std::istream& is)
+	    {
+		size_type n;
+		if(!s_gen->load_state(is) or !binary_io::read(is,n) or n>branching_count())
+		{
+		    return false;
+		}
+		std::vector<branching_type*>removed;
+		std::string sig;
+		size_type j=0;
+		for(size_type i=0;i<n;++i)
+		{
+		    if(!binary_io::read_string(is,sig))
+		    {
+			return false;
+		    }
+		    while(j<branching_count() and branching(j)->signature()!=sig)
+		    {
+			removed.push_back(branching(j));
+			++j;
+		    }
+		    if(j==branching_count() or !branching(j)->load_state(is))
+		    {
+			return false;
+		    }
+		    ++j;
+		}
+		for(;j<branching_count();++j)
+		{
+		    removed.push_back(branching(j));
+		}
+		for(typename std::vector<branching_type*>::iterator it=removed.begin();it!=removed.end();++it)
+		{
+		    branching_multichannel.remove_generator(*it);
+		}
+		return branching_multichannel.load_state(is);
+	    }
+
 	    /* Evaluates the invariant mass from the momentum. */
 
 	    value_type evaluate_s()
@@ -601,6 +758,20 @@ namespace Camgen
 		return static_cast<const branching_type*>(branching_multichannel.generator(i));
 	    }
 
+	    /* Returns the i-th branching instance: */
+
+	    branching_type* branching(size_type i)
+	    {
+		return static_cast<branching_type*>(branching_multichannel.generator(i));
+	    }
+
+	    /* Returns whether the argument branching is in the multichannel: */
+
+	    bool contains_branching(const branching_type* br) const
+	    {
+		return branching_multichannel.contains_generator(br);
+	    }
+
 	    /* Returns the channel generation status for readout: */
 
 	    status_type get_status() const
@@ -730,6 +901,64 @@ namespace Camgen
 
 	    s_generator_type* s_gen;
 
+	    /* Memoised invariant mass density: */
+
+	    struct s_density
+	    {
+		size_type evaluation;
+		value_type s,smin,smax,weight;
+		bool valid;
+
+		s_density():evaluation(0),s(0),smin(0),smax(0),weight(0),valid(false){}
+	    };
+
+	    /* Densities evaluated for the last few sampling ranges, filled
+	     * cyclically: */
+
+	    struct s_density_cache
+	    {
+		static const size_type size=4;
+		s_density entries[size];
+		size_type next;
+
+		s_density_cache():next(0){}
+	    };
+
+	    s_density_cache s_densities;
+
+	    /* Memoised t-branching density: */
+
+	    struct t_density
+	    {
+		size_type evaluation;
+		value_type invariants[5];
+		value_type weight,factor;
+		bool valid;
+
+		t_density():evaluation(0),weight(0),factor(0),valid(false)
+		{
+		    std::fill(invariants,invariants+5,(value_type)0);
+		}
+	    };
+
+	    /* t-branching densities for the last few branching invariants,
+	     * filled cyclically: */
+
+	    struct t_density_cache
+	    {
+		static const size_type size=4;
+		t_density entries[size];
+		size_type next;
+
+		t_density_cache():next(0){}
+	    };
+
+	    t_density_cache t_densities;
+
+	    /* Memoise densities flag, false for adaptive generators: */
+
+	    bool memoise_s_weight;
+
 	    /* Branchings multi-channel: */
 
 	    multi_channel<value_type,rn_engine> branching_multichannel;
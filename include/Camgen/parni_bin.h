@@ -26,6 +26,8 @@
 #include <Camgen/MC_config.h>
 #include <Camgen/plt_script.h>
 #include <Camgen/rn_strm.h>
+#include <Camgen/bin_io.h>
+#include <Camgen/node_pool.h>
 
 namespace Camgen
 {
@@ -91,6 +93,15 @@ namespace Camgen
 	    typedef reverse_parni_leaf_iterator<value_t,D,rng_t,key_t> reverse_leaf_iterator;
 	    typedef const_reverse_parni_leaf_iterator<value_t,D,rng_t,key_t> const_reverse_leaf_iterator;
 
+	    /* Update statistics of a leaf bin, collected by a worker thread: */
+
+	    struct accumulator
+	    {
+		value_type F0,F1,F2,fmax,fmax1,fmax2;
+
+		accumulator():F0(0),F1(0),F2(0),fmax(0),fmax1(0),fmax2(0){}
+	    };
+
 	    /* Static factory methods: */
 	    /*-------------------------*/
 
@@ -150,10 +161,17 @@ namespace Camgen
 	    /*----------------------------------*/
 
 	    /* Constructor of a rectangular bin with total integration domain
-	    lower and upper bound arguments: */
+	    lower and upper bound arguments. If the split index argument is
+	    smaller than D, the bin will be divided along that direction,
+	    otherwise along its longest edge: */
 
-	    parni_bin(const point_type* min_pos_,const point_type* max_pos_,const vector<key_type,D>& key_,grid_modes::type mode_=grid_modes::cumulant_weights):min_pos(min_pos_),max_pos(max_pos_),key(raise(key_)),depth(msb(key)),mode(mode_),F0(0),F1(0),F2(0),fmax(0),fmax1(0),fmax2(0),w(volume()),parent(NULL),child1(NULL),child2(NULL),split_ind(0)
+	    parni_bin(const point_type* min_pos_,const point_type* max_pos_,const vector<key_type,D>& key_,grid_modes::type mode_=grid_modes::cumulant_weights,size_type split_ind_=D):min_pos(min_pos_),max_pos(max_pos_),key(raise(key_)),depth(msb(key)),mode(mode_),F0(0),F1(0),F2(0),fmax(0),fmax1(0),fmax2(0),w(volume()),parent(NULL),child1(NULL),child2(NULL),split_ind(split_ind_),pool(NULL),leaf_index(0)
 	    {
+		if(split_ind<D)
+		{
+		    return;
+		}
+		split_ind=0;
 		value_type x=0,max_edge=edge(0),prev_edge=max_edge;
 		bool q=true;
 		for(size_type i=1;i<D;++i)
@@ -179,11 +197,11 @@ namespace Camgen
 	    {
 		if(child1!=NULL)
 		{
-		    delete child1;
+		    delete_bin(child1);
 		}
 		if(child2!=NULL)
 		{
-		    delete child2;
+		    delete_bin(child2);
 		}
 	    }
 
@@ -206,7 +224,7 @@ namespace Camgen
 		}
 		vector<key_type,D>key1=key;
 		(key1[split_ind])<<=1;
-		child1=new(std::nothrow)parni_bin<value_t,D,rng_t>(min_pos,max_pos,key1,mode);
+		child1=new_bin(key1);
 		if(child1==NULL)
 		{
 		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"failed to allocate first child--split aborted"<<endlog;
@@ -219,11 +237,11 @@ namespace Camgen
 		vector<key_type,D>key2=key;
 		(key2[split_ind])<<=1;
 		++(key2[split_ind]);
-		child2=new(std::nothrow)parni_bin<value_t,D,rng_t>(min_pos,max_pos,key2,mode);
+		child2=new_bin(key2);
 		if(child2==NULL)
 		{
 		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"failed to allocate second child--split aborted"<<endlog;
-		    delete child1;
+		    delete_bin(child1);
 		    child1=NULL;
 		    return false;
 		}
@@ -260,17 +278,81 @@ namespace Camgen
 		if(child1!=NULL)
 		{
 		    child1->merge();
-		    delete child1;
+		    delete_bin(child1);
 		    child1=NULL;
 		}
 		if(child2!=NULL)
 		{
 		    child2->merge();
-		    delete child2;
+		    delete_bin(child2);
 		    child2=NULL;
 		}
 	    }
 
+	    /* Writes the bin data and its descendants in preorder to the binary
+	     * output stream: */
+
+	    void save(std::ostream& os) const
+	    {
+		binary_io::write(os,F0);
+		binary_io::write(os,F1);
+		binary_io::write(os,F2);
+		binary_io::write(os,fmax);
+		binary_io::write(os,fmax1);
+		binary_io::write(os,fmax2);
+		binary_io::write(os,w);
+		binary_io::write(os,split_ind);
+		bool q=!is_leaf();
+		binary_io::write(os,q);
+		if(q)
+		{
+		    child1->save(os);
+		    child2->save(os);
+		}
+	    }
+
+	    /* Reads the bin data written by save and rebuilds the descendants.
+	     * The instance should be a leaf: */
+
+	    bool load(std::istream& is)
+	    {
+		if(!(binary_io::read(is,F0) and binary_io::read(is,F1) and binary_io::read(is,F2)))
+		{
+		    return false;
+		}
+		if(!(binary_io::read(is,fmax) and binary_io::read(is,fmax1) and binary_io::read(is,fmax2) and binary_io::read(is,w)))
+		{
+		    return false;
+		}
+		if(!binary_io::read(is,split_ind) or split_ind>=D)
+		{
+		    return false;
+		}
+		bool q;
+		if(!binary_io::read(is,q))
+		{
+		    return false;
+		}
+		if(!q)
+		{
+		    return true;
+		}
+		vector<key_type,D>key1=key;
+		(key1[split_ind])<<=1;
+		vector<key_type,D>key2=key1;
+		++(key2[split_ind]);
+		child1=new_bin(key1,0);
+		child2=new_bin(key2,0);
+		if(child1==NULL or child2==NULL)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"failed to allocate child bins--loading aborted"<<endlog;
+		    return false;
+		}
+		child1->parent=this;
+		child2->parent=this;
+		return (child1->load(is) and child2->load(is));
+	    }
+
 	    /* Resetting method: */
 
 	    void reset()
@@ -310,6 +392,43 @@ namespace Camgen
 		}
 	    }
 
+	    /* Adds the update by the argument point and integrand to the
+	    accumulator instead of the bin: */
+
+	    void update(const point_type& x,const value_type& f,accumulator& acc) const
+	    {
+		++acc.F0;
+		acc.F1+=f;
+		if(mode==grid_modes::variance_weights)
+		{
+		    acc.F2+=(f*f);
+		}
+		if(mode==grid_modes::maximum_weights)
+		{
+		    acc.fmax=std::max(f,acc.fmax);
+		    if(x[split_ind]<lower_bound(split_ind)+0.5*edge(split_ind))
+		    {
+			acc.fmax1=std::max(f,acc.fmax1);
+		    }
+		    else
+		    {
+			acc.fmax2=std::max(f,acc.fmax2);
+		    }
+		}
+	    }
+
+	    /* Adds the statistics collected in the accumulator: */
+
+	    void add(const accumulator& acc)
+	    {
+		F0+=acc.F0;
+		F1+=acc.F1;
+		F2+=acc.F2;
+		fmax=std::max(acc.fmax,fmax);
+		fmax1=std::max(acc.fmax1,fmax1);
+		fmax2=std::max(acc.fmax2,fmax2);
+	    }
+
 	    /* Adapts the weight and all subbin weights: */
 
 	    void adapt()
@@ -362,10 +481,12 @@ namespace Camgen
 
 	    bool generate(point_type& x)
 	    {
+		value_type r[D];
+		rn_stream::fill(r,D);
 		x=lower_bound();
 		for(size_type i=0;i<D;++i)
 		{
-		    x[i]+=rn_stream::throw_number(edge(i));
+		    x[i]+=r[i]*edge(i);
 		}
 		return true;
 	    }
@@ -377,16 +498,21 @@ namespace Camgen
 	    {
 		point_type lb=lower_bound();
 		point_type ub=upper_bound();
-		value_type xminbis,xmaxbis;
+		value_type xminbis[D],xmaxbis[D];
 		for(size_type i=0;i<D;++i)
 		{
-		    xminbis=std::max(xmin[i],lb[i]);
-		    xmaxbis=std::min(xmax[i],ub[i]);
-		    if(xminbis>xmaxbis)
+		    xminbis[i]=std::max(xmin[i],lb[i]);
+		    xmaxbis[i]=std::min(xmax[i],ub[i]);
+		    if(xminbis[i]>xmaxbis[i])
 		    {
 			return false;
 		    }
-		    x[i]=rn_stream::throw_number(xminbis,xmaxbis);
+		}
+		value_type r[D];
+		rn_stream::fill(r,D);
+		for(size_type i=0;i<D;++i)
+		{
+		    x[i]=xminbis[i]+r[i]*(xmaxbis[i]-xminbis[i]);
 		}
 		return true;
 	    }
@@ -548,56 +674,84 @@ namespace Camgen
 
 	    parni_bin<value_t,D,rng_t>* find_point(const point_type& x)
 	    {
-		value_type lb(lower_bound(split_ind)),vol(edge(split_ind));
-                if(x[split_ind]<lb or x[split_ind]>(lb+vol))
-                {
-                    log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*this<<"\n--returning NULL."<<endlog;
-                    return NULL;
-                }
-		if(child1==NULL or child2==NULL)
+		parni_bin<value_t,D,rng_t>* bin=this;
+		while(true)
 		{
-		    return this;
+		    value_type lb(bin->lower_bound(bin->split_ind)),vol(bin->edge(bin->split_ind));
+		    if(x[bin->split_ind]<lb or x[bin->split_ind]>(lb+vol))
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*bin<<"\n--returning NULL."<<endlog;
+			return NULL;
+		    }
+		    if(bin->child1==NULL or bin->child2==NULL)
+		    {
+			return bin;
+		    }
+		    bin=(x[bin->split_ind]<(lb+0.5*vol))?(bin->child1):(bin->child2);
 		}
-		return (x[split_ind]<(lb+0.5*vol))?(child1->find_point(x)):(child2->find_point(x));
 	    }
 
 	    /* Finds the lowest-level const sub-bin containing the point x: */
 
 	    const parni_bin<value_t,D,rng_t>* find_point(const point_type& x) const
 	    {
-		value_type lb(lower_bound(split_ind)),vol(edge(split_ind));
-                if(x[split_ind]<lb or x[split_ind]>(lb+vol))
-                {
-                    log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*this<<"\n--returning NULL."<<endlog;
-                    return NULL;
-                }
-		if(child1==NULL or child2==NULL)
+		const parni_bin<value_t,D,rng_t>* bin=this;
+		while(true)
 		{
-		    return this;
+		    value_type lb(bin->lower_bound(bin->split_ind)),vol(bin->edge(bin->split_ind));
+		    if(x[bin->split_ind]<lb or x[bin->split_ind]>(lb+vol))
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*bin<<"\n--returning NULL."<<endlog;
+			return NULL;
+		    }
+		    if(bin->child1==NULL or bin->child2==NULL)
+		    {
+			return bin;
+		    }
+		    bin=(x[bin->split_ind]<(lb+0.5*vol))?(bin->child1):(bin->child2);
 		}
-		return (x[split_ind]<(lb+0.5*vol))?(child1->find_point(x)):(child2->find_point(x));
 	    }
 
 	    /* Finds the lowest-level sub-bin with weight smaller than the argument: */
 
 	    parni_bin<value_t,D,rng_t>* find_weight(const value_type& w_)
 	    {
-		if(child1==NULL or child2==NULL)
+		parni_bin<value_t,D,rng_t>* bin=this;
+		value_type rho(w_);
+		while(bin->child1!=NULL and bin->child2!=NULL)
 		{
-		    return this;
+		    if(rho<bin->child1->w)
+		    {
+			bin=bin->child1;
+		    }
+		    else
+		    {
+			rho-=bin->child1->w;
+			bin=bin->child2;
+		    }
 		}
-		return (w_<child1->w)?(child1->find_weight(w_)):(child2->find_weight(w_-child1->w));
+		return bin;
 	    }
 
 	    /* Finds the lowest-level const sub-bin with weight smaller than the argument: */
 
 	    const parni_bin<value_t,D,rng_t>* find_weight(const value_type& w_) const
 	    {
-		if(child1==NULL or child2==NULL)
+		const parni_bin<value_t,D,rng_t>* bin=this;
+		value_type rho(w_);
+		while(bin->child1!=NULL and bin->child2!=NULL)
 		{
-		    return this;
+		    if(rho<bin->child1->w)
+		    {
+			bin=bin->child1;
+		    }
+		    else
+		    {
+			rho-=bin->child1->w;
+			bin=bin->child2;
+		    }
 		}
-		return (w_<child1->w)?(child1->find_weight(w_)):(child2->find_weight(w_-child1->w));
+		return bin;
 	    }
 
 	    /* Recursive printing method: */
@@ -714,6 +868,48 @@ namespace Camgen
 
 	    size_type split_ind;
 
+	    /* Node storage of the tree, or NULL if the bins are allocated on the
+	     * heap: */
+
+	    node_pool<parni_bin<value_t,D,rng_t> >* pool;
+
+	    /* Position of the leaf in the shadow accumulators of the generator: */
+
+	    size_type leaf_index;
+
+	    /* Creates a bin with the argument key and split index, taking the
+	     * storage from the pool if present: */
+
+	    parni_bin<value_t,D,rng_t>* new_bin(const vector<key_type,D>& k,size_type ind=D) const
+	    {
+		if(pool==NULL)
+		{
+		    return new(std::nothrow)parni_bin<value_t,D,rng_t>(min_pos,max_pos,k,mode,ind);
+		}
+		void* storage=pool->allocate();
+		if(storage==NULL)
+		{
+		    return NULL;
+		}
+		parni_bin<value_t,D,rng_t>* b=new(storage)parni_bin<value_t,D,rng_t>(min_pos,max_pos,k,mode,ind);
+		b->pool=pool;
+		return b;
+	    }
+
+	    /* Destroys a bin created by new_bin: */
+
+	    void delete_bin(parni_bin<value_t,D,rng_t>* b) const
+	    {
+		if(pool==NULL)
+		{
+		    delete b;
+		}
+		else
+		{
+		    pool->destroy(b);
+		}
+	    }
+
 	    /* Returns the current instance: */
 
 	    parni_bin<value_t,D,rng_t>* first_bin()
@@ -1035,6 +1231,15 @@ namespace Camgen
 	    typedef reverse_parni_leaf_iterator<value_t,1,rng_t,key_t> reverse_leaf_iterator;
 	    typedef const_reverse_parni_leaf_iterator<value_t,1,rng_t,key_t> const_reverse_leaf_iterator;
 
+	    /* Update statistics of a leaf bin, collected by a worker thread: */
+
+	    struct accumulator
+	    {
+		value_type F0,F1,F2,fmax,fmax1,fmax2;
+
+		accumulator():F0(0),F1(0),F2(0),fmax(0),fmax1(0),fmax2(0){}
+	    };
+
 	    /* Static factory methods: */
 	    /*-------------------------*/
 
@@ -1080,7 +1285,7 @@ namespace Camgen
 	    /* Constructor of a rectangular bin with total integration domain
 	    lower and upper bound arguments: */
 
-	    parni_bin(const point_type* min_pos_,const point_type* max_pos_,key_type key_,grid_modes::type mode_=grid_modes::cumulant_weights):min_pos(min_pos_),max_pos(max_pos_),key(std::max((key_type)1,key_)),depth(msb(key)),mode(mode_),F0(0),F1(0),F2(0),fmax(0),fmax1(0),fmax2(0),w(volume()),parent(NULL),child1(NULL),child2(NULL){}
+	    parni_bin(const point_type* min_pos_,const point_type* max_pos_,key_type key_,grid_modes::type mode_=grid_modes::cumulant_weights):min_pos(min_pos_),max_pos(max_pos_),key(std::max((key_type)1,key_)),depth(msb(key)),mode(mode_),F0(0),F1(0),F2(0),fmax(0),fmax1(0),fmax2(0),w(volume()),parent(NULL),child1(NULL),child2(NULL),pool(NULL),leaf_index(0){}
 	    
 	    /* Destructor. The bin owns its children: */
 	    
@@ -1088,11 +1293,11 @@ namespace Camgen
 	    {
 		if(child1!=NULL)
 		{
-		    delete child1;
+		    delete_bin(child1);
 		}
 		if(child2!=NULL)
 		{
-		    delete child2;
+		    delete_bin(child2);
 		}
 	    }
 
@@ -1113,7 +1318,7 @@ namespace Camgen
 		{
 		    return false;
 		}
-		child1=new(std::nothrow)parni_bin<value_t,1,rng_t>(min_pos,max_pos,(key<<1),mode);
+		child1=new_bin(key<<1);
 		if(child1==NULL)
 		{
 		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"failed to allocate first child--split aborted."<<endlog;
@@ -1123,11 +1328,11 @@ namespace Camgen
 		child1->F0=(value_type)0.5*F0;
 		child1->F1=(value_type)0.5*F1;
 
-		child2=new(std::nothrow)parni_bin<value_t,1,rng_t>(min_pos,max_pos,(key<<1)+1,mode);
+		child2=new_bin((key<<1)+1);
 		if(child2==NULL)
 		{
 		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"failed to allocate second child--split aborted."<<endlog;
-		    delete child1;
+		    delete_bin(child1);
 		    child1=NULL;
 		    return false;
 		}
@@ -1165,17 +1370,72 @@ namespace Camgen
 		if(child1!=NULL)
 		{
 		    child1->merge();
-		    delete child1;
+		    delete_bin(child1);
 		    child1=NULL;
 		}
 		if(child2!=NULL)
 		{
 		    child2->merge();
-		    delete child2;
+		    delete_bin(child2);
 		    child2=NULL;
 		}
 	    }
 
+	    /* Writes the bin data and its descendants in preorder to the binary
+	     * output stream: */
+
+	    void save(std::ostream& os) const
+	    {
+		binary_io::write(os,F0);
+		binary_io::write(os,F1);
+		binary_io::write(os,F2);
+		binary_io::write(os,fmax);
+		binary_io::write(os,fmax1);
+		binary_io::write(os,fmax2);
+		binary_io::write(os,w);
+		bool q=!is_leaf();
+		binary_io::write(os,q);
+		if(q)
+		{
+		    child1->save(os);
+		    child2->save(os);
+		}
+	    }
+
+	    /* Reads the bin data written by save and rebuilds the descendants.
+	     * The instance should be a leaf: */
+
+	    bool load(std::istream& is)
+	    {
+		if(!(binary_io::read(is,F0) and binary_io::read(is,F1) and binary_io::read(is,F2)))
+		{
+		    return false;
+		}
+		if(!(binary_io::read(is,fmax) and binary_io::read(is,fmax1) and binary_io::read(is,fmax2) and binary_io::read(is,w)))
+		{
+		    return false;
+		}
+		bool q;
+		if(!binary_io::read(is,q))
+		{
+		    return false;
+		}
+		if(!q)
+		{
+		    return true;
+		}
+		child1=new_bin(key<<1);
+		child2=new_bin((key<<1)+1);
+		if(child1==NULL or child2==NULL)
+		{
+		    log(log_level::warning)<<CAMGEN_STREAMLOC<<"failed to allocate child bins--loading aborted"<<endlog;
+		    return false;
+		}
+		child1->parent=this;
+		child2->parent=this;
+		return (child1->load(is) and child2->load(is));
+	    }
+
 	    /* Resetting method: */
 
 	    void reset()
@@ -1216,6 +1476,44 @@ namespace Camgen
 		}
 	    }
 
+	    /* Adds the update by the argument point and integrand to the
+	    accumulator instead of the bin: */
+
+	    void update(const point_type& x,const value_type& f,accumulator& acc) const
+	    {
+		++acc.F0;
+		acc.F1+=f;
+		if(mode==grid_modes::variance_weights)
+		{
+		    acc.F2+=(f*f);
+		}
+		value_type vol(volume());
+		if(mode==grid_modes::maximum_weights)
+		{
+		    acc.fmax=std::max(f,acc.fmax);
+		    if(x<lower_bound()+0.5*vol)
+		    {
+			acc.fmax1=std::max(f,acc.fmax1);
+		    }
+		    else
+		    {
+			acc.fmax2=std::max(f,acc.fmax2);
+		    }
+		}
+	    }
+
+	    /* Adds the statistics collected in the accumulator: */
+
+	    void add(const accumulator& acc)
+	    {
+		F0+=acc.F0;
+		F1+=acc.F1;
+		F2+=acc.F2;
+		fmax=std::max(acc.fmax,fmax);
+		fmax1=std::max(acc.fmax1,fmax1);
+		fmax2=std::max(acc.fmax2,fmax2);
+	    }
+
 	    /* Adapts the weight and all subbin weights: */
 
 	    void adapt()
@@ -1398,34 +1696,42 @@ namespace Camgen
 
 	    parni_bin<value_t,1,rng_t>* find_point(const point_type& x)
 	    {
-		value_type lb(lower_bound()),vol(volume());
-                if(x<lb or x>(lb+vol))
-                {
-                    log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*this<<"\n--returning NULL."<<endlog;
-                    return NULL;
-                }
-		if(child1==NULL or child2==NULL)
+		parni_bin<value_t,1,rng_t>* bin=this;
+		while(true)
 		{
-		    return this;
+		    value_type lb(bin->lower_bound()),vol(bin->volume());
+		    if(x<lb or x>(lb+vol))
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*bin<<"\n--returning NULL."<<endlog;
+			return NULL;
+		    }
+		    if(bin->child1==NULL or bin->child2==NULL)
+		    {
+			return bin;
+		    }
+		    bin=(x<(lb+0.5*vol))?(bin->child1):(bin->child2);
 		}
-		return (x<(lb+0.5*vol))?(child1->find_point(x)):(child2->find_point(x));
 	    }
 
 	    /* Finds the lowest-level const sub-bin containing the point x: */
 
 	    const parni_bin<value_t,1,rng_t>* find_point(const point_type& x) const
 	    {
-		value_type lb(lower_bound()),vol(volume());
-                if(x<lb or x>(lb+vol))
-                {
-                    log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*this<<"\n--returning NULL."<<endlog;
-                    return NULL;
-                }
-		if(child1==NULL or child2==NULL)
+		const parni_bin<value_t,1,rng_t>* bin=this;
+		while(true)
 		{
-		    return this;
+		    value_type lb(bin->lower_bound()),vol(bin->volume());
+		    if(x<lb or x>(lb+vol))
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*bin<<"\n--returning NULL."<<endlog;
+			return NULL;
+		    }
+		    if(bin->child1==NULL or bin->child2==NULL)
+		    {
+			return bin;
+		    }
+		    bin=(x<(lb+0.5*vol))?(bin->child1):(bin->child2);
 		}
-		return (x<(lb+0.5*vol))?(child1->find_point(x)):(child2->find_point(x));
 	    }
 
 	    /* Finds the lowest-level sub-bin containing the point x and store the
@@ -1433,18 +1739,30 @@ namespace Camgen
 
 	    parni_bin<value_t,1,rng_t>* find_point(const point_type& x,value_type& s)
 	    {
-		value_type lb(lower_bound()),vol(volume());
-                if(x<lb or x>(lb+vol))
-                {
-                    log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*this<<"\n--returning NULL."<<endlog;
-		    return NULL;
-                }
-		if(child1==NULL or child2==NULL)
+		parni_bin<value_t,1,rng_t>* bin=this;
+		while(true)
 		{
-		    s+=((x-lb)*w/vol);
-		    return this;
+		    value_type lb(bin->lower_bound()),vol(bin->volume());
+		    if(x<lb or x>(lb+vol))
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*bin<<"\n--returning NULL."<<endlog;
+			return NULL;
+		    }
+		    if(bin->child1==NULL or bin->child2==NULL)
+		    {
+			s+=((x-lb)*bin->w/vol);
+			return bin;
+		    }
+		    if(x<(lb+0.5*vol))
+		    {
+			bin=bin->child1;
+		    }
+		    else
+		    {
+			s+=bin->child1->w;
+			bin=bin->child2;
+		    }
 		}
-		return (x<(lb+0.5*vol))?(child1->find_point(x,s)):(child2->find_point(x,s+=(child1->w)));
 	    }
 
 	    /* Finds the lowest-level const sub-bin containing the point x and store the
@@ -1452,40 +1770,72 @@ namespace Camgen
 
 	    const parni_bin<value_t,1,rng_t>* find_point(const point_type& x,value_type& s) const
 	    {
-		value_type lb(lower_bound()),vol(volume());
-                if(x<lb or x>(lb+vol))
-                {
-                    log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni grid--returning NULL."<<endlog;
-                    return NULL;
-                }
-		if(child1==NULL or child2==NULL)
+		const parni_bin<value_t,1,rng_t>* bin=this;
+		while(true)
 		{
-		    s+=((x-lb)*w/vol);
-		    return this;
+		    value_type lb(bin->lower_bound()),vol(bin->volume());
+		    if(x<lb or x>(lb+vol))
+		    {
+			log(log_level::warning)<<CAMGEN_STREAMLOC<<"point "<<x<<" not found in parni bin\n"<<*bin<<"\n--returning NULL."<<endlog;
+			return NULL;
+		    }
+		    if(bin->child1==NULL or bin->child2==NULL)
+		    {
+			s+=((x-lb)*bin->w/vol);
+			return bin;
+		    }
+		    if(x<(lb+0.5*vol))
+		    {
+			bin=bin->child1;
+		    }
+		    else
+		    {
+			s+=bin->child1->w;
+			bin=bin->child2;
+		    }
 		}
-		return (x<(lb+0.5*vol))?(child1->find_point(x,s)):(child2->find_point(x,s+=(child1->w)));
 	    }
 
 	    /* Finds the lowest-level sub-bin with weight smaller than the argument: */
 
 	    parni_bin<value_t,1,rng_t>* find_weight(const value_type& w_)
 	    {
-		if(child1==NULL or child2==NULL)
+		parni_bin<value_t,1,rng_t>* bin=this;
+		value_type rho(w_);
+		while(bin->child1!=NULL and bin->child2!=NULL)
 		{
-		    return this;
+		    if(rho<bin->child1->w)
+		    {
+			bin=bin->child1;
+		    }
+		    else
+		    {
+			rho-=bin->child1->w;
+			bin=bin->child2;
+		    }
 		}
-		return (w_<child1->w)?(child1->find_weight(w_)):(child2->find_weight(w_-child1->w));
+		return bin;
 	    }
 
 	    /* Finds the lowest-level const sub-bin with weight smaller than the argument: */
 
 	    const parni_bin<value_t,1,rng_t>* find_weight(const value_type& w_) const
 	    {
-		if(child1==NULL or child2==NULL)
+		const parni_bin<value_t,1,rng_t>* bin=this;
+		value_type rho(w_);
+		while(bin->child1!=NULL and bin->child2!=NULL)
 		{
-		    return this;
+		    if(rho<bin->child1->w)
+		    {
+			bin=bin->child1;
+		    }
+		    else
+		    {
+			rho-=bin->child1->w;
+			bin=bin->child2;
+		    }
 		}
-		return (w_<child1->w)?(child1->find_weight(w_)):(child2->find_weight(w_-child1->w));
+		return bin;
 	    }
 
 	    /* Recursive printing method: */
@@ -1591,6 +1941,48 @@ namespace Camgen
 	    parni_bin<value_t,1,rng_t>* child1;
 	    parni_bin<value_t,1,rng_t>* child2;
 
+	    /* Node storage of the tree, or NULL if the bins are allocated on the
+	     * heap: */
+
+	    node_pool<parni_bin<value_t,1,rng_t> >* pool;
+
+	    /* Position of the leaf in the shadow accumulators of the generator: */
+
+	    size_type leaf_index;
+
+	    /* Creates a bin with the argument key, taking the storage from the
+	     * pool if present: */
+
+	    parni_bin<value_t,1,rng_t>* new_bin(key_type k) const
+	    {
+		if(pool==NULL)
+		{
+		    return new(std::nothrow)parni_bin<value_t,1,rng_t>(min_pos,max_pos,k,mode);
+		}
+		void* storage=pool->allocate();
+		if(storage==NULL)
+		{
+		    return NULL;
+		}
+		parni_bin<value_t,1,rng_t>* b=new(storage)parni_bin<value_t,1,rng_t>(min_pos,max_pos,k,mode);
+		b->pool=pool;
+		return b;
+	    }
+
+	    /* Destroys a bin created by new_bin: */
+
+	    void delete_bin(parni_bin<value_t,1,rng_t>* b) const
+	    {
+		if(pool==NULL)
+		{
+		    delete b;
+		}
+		else
+		{
+		    pool->destroy(b);
+		}
+	    }
+
 	    /* Returns the current instance: */
 
 	    parni_bin<value_t,1,rng_t>* first_bin()
@@ -78,6 +78,7 @@ namespace Camgen
 		vector<key_t,D>key;
 		key.assign(1);
 		root_bin=new bin_type(&xmin,&xmax,key,mode);
+		root_bin->pool=&bin_pool;
 	    }
 
 	    /// Constructor with an external point address (to be filled) and
@@ -89,6 +90,7 @@ namespace Camgen
 		vector<key_t,D>key;
 		key.assign(1);
 		root_bin=new bin_type(&xmin,&xmax,key,mode);
+		root_bin->pool=&bin_pool;
 	    }
 
 	    /* Destructor: */
@@ -132,7 +134,8 @@ namespace Camgen
 		return true;
 	    }
 
-	    /// Overridden updating method.
+	    /// Overridden updating method, using the point and integrand stored
+	    /// in the instance. Worker threads should use accumulate() instead.
 
 	    void update()
 	    {
@@ -150,6 +153,7 @@ namespace Camgen
 
 	    void adapt()
 	    {
+		merge_shadows();
 		root_bin->adapt();
 		if(!final())
 		{
@@ -247,6 +251,7 @@ namespace Camgen
 			}
 		    }
 		}
+		index_leaves();
 	    }
 
 	    /// Resets the cross section and re-initialises the grid to a single
@@ -255,6 +260,101 @@ namespace Camgen
 	    void reset()
 	    {
 		root_bin->reset();
+		index_leaves();
+	    }
+
+	    /// Thread-safe updating method for worker threads (see
+	    /// shadow_acc.h), adding the integrand f at the point x to the
+	    /// worker's shadow of the grid statistics. Called by the owning
+	    /// thread, updates the bin containing x in place.
+
+	    void accumulate(const point_type& x,const value_type& f)
+	    {
+		if(!accept(f))
+		{
+		    return;
+		}
+		std::vector<typename bin_type::accumulator>* s=shadows.local();
+		if(s==NULL)
+		{
+		    bin_type* b=root_bin->find_point(x);
+		    if(b!=NULL)
+		    {
+			b->update(x,f);
+		    }
+		    return;
+		}
+		const bin_type* b=static_cast<const bin_type*>(root_bin)->find_point(x);
+		if(b!=NULL)
+		{
+		    b->update(x,f,(*s)[b->leaf_index]);
+		}
+	    }
+
+	    /// Sets the number of worker threads accumulating grid statistics.
+	    /// Pending shadow statistics are merged first.
+
+	    void set_update_workers(size_type n)
+	    {
+		merge_shadows();
+		shadows.resize(n);
+		index_leaves();
+	    }
+
+	    /// Adds the statistics collected by the workers to the bins, in
+	    /// worker order. Called by adapt().
+
+	    void merge_shadows()
+	    {
+		for(size_type i=0;i<shadows.size();++i)
+		{
+		    std::vector<typename bin_type::accumulator>& s=shadows[i];
+		    for(size_type j=0;j<s.size();++j)
+		    {
+			shadow_leaves[j]->add(s[j]);
+			s[j]=typename bin_type::accumulator();
+		    }
+		}
+	    }
+
+	    /// Writes the grid configuration and the bins to the binary output
+	    /// stream.
+
+	    void save_state(std::ostream& os) const
+	    {
+		binary_io::write(os,(unsigned)D);
+		binary_io::write(os,n_bins);
+		binary_io::write(os,mode);
+		root_bin->save(os);
+	    }
+
+	    /// Replaces the bins by the ones read from the binary input stream.
+	    /// Returns false and resets the grid if the data does not match the
+	    /// dimension, maximal number of bins or mode of the instance.
+
+	    bool load_state(std::istream& is)
+	    {
+		unsigned d;
+		size_type n;
+		grid_modes::type m;
+		if(!(binary_io::read(is,d) and binary_io::read(is,n) and binary_io::read(is,m)))
+		{
+		    return false;
+		}
+		if(d!=D or n!=n_bins or m!=mode)
+		{
+		    return false;
+		}
+		root_bin->reset();
+		reg_bin=root_bin;
+		if(!root_bin->load(is))
+		{
+		    root_bin->reset();
+		    index_leaves();
+		    return false;
+		}
+		index_leaves();
+		return true;
 	    }
 	    
 	    /// Creates a new sub grid generator with the current instance as parent.
@@ -267,6 +367,15 @@ namespace Camgen
 	    /* Public readout functions: */
 	    /*---------------------------*/
 
+	    /// Returns the grid weight at the argument point, without changing
+	    /// the state of the generator.
+
+	    value_type point_weight(const point_type& x) const
+	    {
+		const bin_type* b=static_cast<const bin_type*>(root_bin)->find_point(x);
+		return (b==NULL)?(value_type)0:(b->weight()*norm());
+	    }
+
 	    /// Returns whether the maximal number of bins has been reached.
 
 	    bool final() const
@@ -440,6 +549,10 @@ namespace Camgen
 	    
 	    point_type xmin,xmax;
 
+	    /* Storage of the bins: */
+
+	    node_pool<parni_bin<value_t,D,rng_t> > bin_pool;
+
 	    /* Root of the binary tree of bins: */
 
 	    bin_type* root_bin;
@@ -452,6 +565,14 @@ namespace Camgen
 
 	    std::set<parni_sub_grid<value_t,D,rng_t,key_t>*> subgrids;
 
+	    /* Worker shadows of the leaf statistics: */
+
+	    shadow_accumulator<std::vector<typename bin_type::accumulator> > shadows;
+
+	    /* Leaves in the order of the shadow statistics: */
+
+	    std::vector<bin_type*> shadow_leaves;
+
 	    /* Private constructors: */
 	    /*-----------------------*/
 
@@ -478,6 +599,23 @@ namespace Camgen
 		return false;
 	    }
 	    
+	    /* Numbers the leaves for the worker shadows and clears the shadows: */
+
+	    void index_leaves()
+	    {
+		shadow_leaves.clear();
+		if(shadows.size()==0)
+		{
+		    return;
+		}
+		for(leaf_iterator it=begin_leaves();it!=end_leaves();++it)
+		{
+		    (*it)->leaf_index=shadow_leaves.size();
+		    shadow_leaves.push_back(*it);
+		}
+		shadows.resize(shadows.size(),std::vector<typename bin_type::accumulator>(shadow_leaves.size()));
+	    }
+
 	    /* Returns the lowest-level bin containing the argument point: */
 
 	    bin_type* find_leaf(const point_type& x)
@@ -560,13 +698,19 @@ namespace Camgen
 	    /* Public constructors: */
 	    /*----------------------*/
 	    
-	    parni_generator(const point_type& xmin_,const point_type& xmax_,size_type n_bins_=500,grid_modes::type mode_=grid_modes::cumulant_weights):n_bins(n_bins_),mode(mode_),xmin(xmin_),xmax(xmax_),root_bin(new bin_type(&xmin,&xmax,1,mode)),reg_bin(root_bin){}
+	    parni_generator(const point_type& xmin_,const point_type& xmax_,size_type n_bins_=500,grid_modes::type mode_=grid_modes::cumulant_weights):n_bins(n_bins_),mode(mode_),xmin(xmin_),xmax(xmax_),root_bin(new bin_type(&xmin,&xmax,1,mode)),reg_bin(root_bin)
+	    {
+		root_bin->pool=&bin_pool;
+	    }
 
 	    /// Constructor with an external point address (to be filled) and
 	    /// lower-left and upper-right integration domain corners and the
 	    /// maximal number of bins as arguments.
 	    
-	    parni_generator(point_type* point_,const point_type& xmin_,const point_type& xmax_,size_type n_bins_=500,grid_modes::type mode_=grid_modes::cumulant_weights):base_type(point_),n_bins(n_bins_),mode(mode_),xmin(xmin_),xmax(xmax_),root_bin(new bin_type(&xmin,&xmax,1,mode)),reg_bin(root_bin){}
+	    parni_generator(point_type* point_,const point_type& xmin_,const point_type& xmax_,size_type n_bins_=500,grid_modes::type mode_=grid_modes::cumulant_weights):base_type(point_),n_bins(n_bins_),mode(mode_),xmin(xmin_),xmax(xmax_),root_bin(new bin_type(&xmin,&xmax,1,mode)),reg_bin(root_bin)
+	    {
+		root_bin->pool=&bin_pool;
+	    }
 
 	    /* Destructor: */
 	    /*-------------*/
@@ -613,7 +757,8 @@ namespace Camgen
 		return true;
 	    }
 
-	    /// Overridden updating method.
+	    /// Overridden updating method, using the point and integrand stored
+	    /// in the instance. Worker threads should use accumulate() instead.
 
 	    void update()
 	    {
@@ -635,6 +780,7 @@ namespace Camgen
 	    
 	    void adapt()
 	    {
+		merge_shadows();
 		root_bin->adapt();
 		if(!final())
 		{
@@ -732,6 +878,7 @@ namespace Camgen
 			}
 		    }
 		}
+		index_leaves();
 		for(typename std::set<parni_sub_grid<value_t,1,rng_t,key_t>*>::iterator it=subgrids.begin();it!=subgrids.end();++it)
 		{
 		    (*it)->refresh_bounds();
@@ -742,6 +889,7 @@ namespace Camgen
 
 	    void adapt(const point_type& a,const point_type& b)
 	    {
+		merge_shadows();
 		root_bin->adapt();
 		if(!final())
 		{
@@ -847,6 +995,7 @@ namespace Camgen
 			}
 		    }
 		}
+		index_leaves();
 		for(typename std::set<parni_sub_grid<value_t,1,rng_t,key_t>*>::iterator it=subgrids.begin();it!=subgrids.end();++it)
 		{
 		    (*it)->refresh_bounds();
@@ -859,6 +1008,112 @@ namespace Camgen
 	    void reset()
 	    {
 		root_bin->reset();
+		index_leaves();
+		for(typename std::set<parni_sub_grid<value_t,1,rng_t,key_t>*>::iterator it=subgrids.begin();it!=subgrids.end();++it)
+		{
+		    (*it)->refresh_bounds();
+		}
+	    }
+
+	    /// Thread-safe updating method for worker threads (see
+	    /// shadow_acc.h), adding the integrand f at the point x to the
+	    /// worker's shadow of the grid statistics. Called by the owning
+	    /// thread, updates the bin containing x in place. The bin weights
+	    /// do not change until the next adaptation, which refreshes the
+	    /// bounds of the sub grids.
+
+	    void accumulate(const point_type& x,const value_type& f)
+	    {
+		if(!accept(f))
+		{
+		    return;
+		}
+		std::vector<typename bin_type::accumulator>* s=shadows.local();
+		if(s==NULL)
+		{
+		    bin_type* b=root_bin->find_point(x);
+		    if(b!=NULL)
+		    {
+			b->update(x,f);
+		    }
+		    return;
+		}
+		const bin_type* b=static_cast<const bin_type*>(root_bin)->find_point(x);
+		if(b!=NULL)
+		{
+		    b->update(x,f,(*s)[b->leaf_index]);
+		}
+	    }
+
+	    /// Sets the number of worker threads accumulating grid statistics.
+	    /// Pending shadow statistics are merged first.
+
+	    void set_update_workers(size_type n)
+	    {
+		merge_shadows();
+		shadows.resize(n);
+		index_leaves();
+	    }
+
+	    /// Adds the statistics collected by the workers to the bins, in
+	    /// worker order. Called by adapt().
+
+	    void merge_shadows()
+	    {
+		for(size_type i=0;i<shadows.size();++i)
+		{
+		    std::vector<typename bin_type::accumulator>& s=shadows[i];
+		    for(size_type j=0;j<s.size();++j)
+		    {
+			shadow_leaves[j]->add(s[j]);
+			s[j]=typename bin_type::accumulator();
+		    }
+		}
+	    }
+
+	    /// Writes the grid configuration and the bins to the binary output
+	    /// stream.
+
+	    void save_state(std::ostream& os) const
+	    {
+		binary_io::write(os,(unsigned)1);
+		binary_io::write(os,n_bins);
+		binary_io::write(os,mode);
+		root_bin->save(os);
+	    }
+
+	    /// Replaces the bins by the ones read from the binary input stream.
+	    /// Returns false and resets the grid if the data does not match the
+	    /// dimension, maximal number of bins or mode of the instance.
+
+	    bool load_state(std::istream& is)
+	    {
+		unsigned d;
+		size_type n;
+		grid_modes::type m;
+		if(!(binary_io::read(is,d) and binary_io::read(is,n) and binary_io::read(is,m)))
+		{
+		    return false;
+		}
+		if(d!=1 or n!=n_bins or m!=mode)
+		{
+		    return false;
+		}
+		root_bin->reset();
+		reg_bin=root_bin;
+		if(!root_bin->load(is))
+		{
+		    root_bin->reset();
+		    index_leaves();
+		    return false;
+		}
+		index_leaves();
+		for(typename std::set<parni_sub_grid<value_t,1,rng_t,key_t>*>::iterator it=subgrids.begin();it!=subgrids.end();++it)
+		{
+		    (*it)->reg_bin=root_bin;
+		    (*it)->refresh_bounds();
+		}
+		return true;
 	    }
 
 	    /// Creates a new sub grid generator with the current instance as parent.
@@ -871,6 +1126,15 @@ namespace Camgen
 	    /* Public readout functions: */
 	    /*---------------------------*/
 
+	    /// Returns the grid weight at the argument point, without changing
+	    /// the state of the generator.
+
+	    value_type point_weight(const point_type& x) const
+	    {
+		const bin_type* b=static_cast<const bin_type*>(root_bin)->find_point(x);
+		return (b==NULL)?(value_type)0:(b->weight()*norm());
+	    }
+
 	    /// Returns whether the maximal number of bins has been reached.
 
 	    bool final() const
@@ -1041,6 +1305,10 @@ namespace Camgen
 	    
 	    point_type xmin,xmax;
 
+	    /* Storage of the bins: */
+
+	    node_pool<parni_bin<value_t,1,rng_t> > bin_pool;
+
 	    /* Root of the binary tree of bins: */
 
 	    bin_type* root_bin;
@@ -1053,6 +1321,14 @@ namespace Camgen
 
 	    std::set<parni_sub_grid<value_t,1,rng_t,key_t>*>subgrids;
 
+	    /* Worker shadows of the leaf statistics: */
+
+	    shadow_accumulator<std::vector<typename bin_type::accumulator> > shadows;
+
+	    /* Leaves in the order of the shadow statistics: */
+
+	    std::vector<bin_type*> shadow_leaves;
+
 	    /* Private constructors: */
 	    /*-----------------------*/
 
@@ -1079,6 +1355,23 @@ namespace Camgen
 		return false;
 	    }
 
+	    /* Numbers the leaves for the worker shadows and clears the shadows: */
+
+	    void index_leaves()
+	    {
+		shadow_leaves.clear();
+		if(shadows.size()==0)
+		{
+		    return;
+		}
+		for(leaf_iterator it=begin_leaves();it!=end_leaves();++it)
+		{
+		    (*it)->leaf_index=shadow_leaves.size();
+		    shadow_leaves.push_back(*it);
+		}
+		shadows.resize(shadows.size(),std::vector<typename bin_type::accumulator>(shadow_leaves.size()));
+	    }
+
 	    /* Returns the lowest-level bin containing the argument point: */
 
 	    bin_type* find_leaf(const point_type& x)
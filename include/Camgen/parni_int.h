@@ -103,10 +103,37 @@ namespace Camgen
 		generator.update();
 	    }
 
+	    /// Thread-safe updating method for worker threads (see
+	    /// shadow_acc.h), adding the integrand f at the point x to the grid
+	    /// statistics and the weight sums.
+
+	    void accumulate(const point_type& x,const value_type& f)
+	    {
+		generator.accumulate(x,f);
+		this->MC_integrator<value_t>::accumulate(generator.point_weight(x)*f);
+	    }
+
+	    /// Sets the number of worker threads accumulating updates.
+
+	    void set_update_workers(size_type n)
+	    {
+		this->MC_integrator<value_t>::set_update_workers(n);
+		generator.set_update_workers(n);
+	    }
+
+	    /// Merges the worker shadows of the weight sums and the grid.
+
+	    void merge_shadows()
+	    {
+		this->MC_integrator<value_t>::merge_shadows();
+		generator.merge_shadows();
+	    }
+
 	    /// Overridden adaptation method.
 
 	    void adapt()
 	    {
+		this->MC_integrator<value_t>::merge_shadows();
 		generator.adapt();
 	    }
 
@@ -117,6 +144,21 @@ namespace Camgen
 	    {
 		generator.reset();
 	    }
+
+	    /// Writes the weight sums and the grid to the binary output stream.
+
+	    void save_state(std::ostream& os) const
+	    {
+		this->MC_integrator<value_t>::save_state(os);
+		generator.save_state(os);
+	    }
+
+	    /// Reads the weight sums and the grid from the binary input stream.
+
+	    bool load_state(std::istream& is)
+	    {
+		return (this->MC_integrator<value_t>::load_state(is) and generator.load_state(is));
+	    }
 	    
 	    /// Creates a new sub grid generator with the current instance as parent.
 
@@ -559,6 +559,17 @@ namespace Camgen
 		    zero_hel=massive?value_type(1,0):value_type(0,0);
 		}
 	    }
+
+	    /// Assignment operator, copying the helicity phases of a holder of
+	    /// the same particle type.
+
+	    helicity_phases<value_t>& operator = (const helicity_phases<value_t>& other)
+	    {
+		pos_hels=other.pos_hels;
+		zero_hel=other.zero_hel;
+		neg_hels=other.neg_hels;
+		return *this;
+	    }
 	    
 	    /// Helicity phase access.
 	    
@@ -1555,6 +1566,16 @@ namespace Camgen
 		std::swap(this->colours,other.colours);
 	    }
 
+	    /* Copying method, assigning all phase space variables of another
+	     * particle phase space: */
+
+	    void copy_dofs(const particle_ps<model_t,dim,true>& other)
+	    {
+		this->p=other.p;
+		this->hel=other.hel;
+		this->colours=other.colours;
+	    }
+
 	    /* Printing method: */
 
 	    std::ostream& print_dofs(std::ostream& os) const
@@ -1659,6 +1680,15 @@ namespace Camgen
 		std::swap(this->hel,other.hel);
 	    }
 
+	    /* Copying method, assigning all phase space variables of another
+	     * particle phase space: */
+
+	    void copy_dofs(const particle_ps<model_t,dim,false>& other)
+	    {
+		this->p=other.p;
+		this->hel=other.hel;
+	    }
+
 	    /* Printing method: */
 
 	    std::ostream& print_dofs(std::ostream& os) const
@@ -1775,6 +1805,15 @@ namespace Camgen
 		std::swap(this->colours,other.colours);
 	    }
 
+	    /* Copying method, assigning all phase space variables of another
+	     * particle phase space: */
+
+	    void copy_dofs(const particle_ps<model_t,0,true>& other)
+	    {
+		this->p=other.p;
+		this->colours=other.colours;
+	    }
+
 	    /* Printing method: */
 
 	    std::ostream& print_dofs(std::ostream& os) const
@@ -1875,6 +1914,14 @@ namespace Camgen
 
 	    void swap(particle_ps<model_t,0,false>& other){}
 
+	    /* Copying method, assigning all phase space variables of another
+	     * particle phase space: */
+
+	    void copy_dofs(const particle_ps<model_t,0,false>& other)
+	    {
+		this->p=other.p;
+	    }
+
 	    /* Printing method: */
 
 	    std::ostream& print_dofs(std::ostream& os) const
@@ -0,0 +1,163 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file philox.h
+    \brief Philox counter-based pseudo-random number generator.
+ */
+
+#ifndef CAMGEN_PHILOX_H_
+#define CAMGEN_PHILOX_H_
+
+#include <cstddef>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Philox4x32-10 counter-based random number generator (Salmon et al., SC'11).  *
+ * The n-th block of four 32-bit numbers is a bijective function of the 128-bit *
+ * counter (n,stream) and the 64-bit key, so any number of independent streams  *
+ * can be selected by the stream index, and jumping ahead within a stream is    *
+ * an O(1) operation. The thrown integers are the upper 31 bits of the outputs. *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+namespace Camgen
+{
+    /// Philox4x32-10 random number stream, with independent substreams and
+    /// jump-ahead.
+
+    class philox
+    {
+	public:
+
+	    /* Numerical output type: */
+
+	    typedef int result_type;
+
+	    /* Unsigned 32-bit word type: */
+
+	    typedef unsigned int word_type;
+
+	    /* Unsigned 64-bit counter type: */
+
+	    typedef long long unsigned counter_type;
+
+	    /* Minimal and maximal thrown values: */
+
+	    static const result_type min_value=0;
+	    static const result_type max_value=0x7FFFFFFF;
+
+	    /// Default key, used by the trivial constructor.
+
+	    static counter_type seed;
+
+	    /// Constructor, selecting stream 0 with the default key.
+
+	    philox();
+
+	    /// Constructor, selecting the stream with index n with key k.
+
+	    philox(counter_type k,counter_type n=0);
+
+	    /// Throwing operator.
+
+	    result_type operator ()(void);
+
+	    /// Draws n integers into the argument array. Equivalent to n
+	    /// subsequent throws, but full blocks are computed eight at a time
+	    /// by a vectorisable kernel.
+
+	    void fill(result_type* r,std::size_t n);
+
+	    /// Moves to the beginning of the stream with index n.
+
+	    void set_stream(counter_type n);
+
+	    /// Returns the stream index.
+
+	    counter_type get_stream() const;
+
+	    /// Skips the next n throws.
+
+	    void jump(counter_type n);
+
+	    /// Returns the number of throws since the beginning of the
+	    /// stream.
+
+	    counter_type position() const;
+
+	    /// Computes the Philox4x32-10 block of the counter c and key k.
+
+	    static void block(const word_type c[4],const word_type k[2],word_type out[4]);
+
+	private:
+
+	    /* Key words: */
+
+	    word_type key[2];
+
+	    /* Stream index: */
+
+	    counter_type stream;
+
+	    /* Index of the next block to be computed: */
+
+	    counter_type next_block;
+
+	    /* Current block of outputs: */
+
+	    word_type buffer[4];
+
+	    /* Position of the next output in the buffer: */
+
+	    unsigned index;
+
+	    /* Number of blocks computed at once by the bulk kernel: */
+
+	    static const std::size_t lanes=8;
+
+	    /* Computes the block with index n into the buffer: */
+
+	    void fill_buffer(counter_type n);
+
+	    /* Computes the blocks with indices n,...,n+lanes-1 into the
+	     * argument array: */
+
+	    void fill_blocks(counter_type n,word_type out[4*lanes]) const;
+    };
+
+    /* Forward declaration of the substream factory: */
+
+    template<class rng_t>class rn_substream;
+
+    /* Bulk throwing overload for the random number stream: */
+
+    inline void fill_integers(philox& rng,philox::result_type* r,std::size_t n)
+    {
+	rng.fill(r,n);
+    }
+
+    /// Substream factory specialisation, selecting the Philox streams with the
+    /// default key.
+
+    template<>class rn_substream<philox>
+    {
+	public:
+
+	    /// Whether the engine provides independent substreams.
+
+	    static const bool value=true;
+
+	    /// Returns a new engine for the stream with index n.
+
+	    static philox* create(std::size_t n)
+	    {
+		return new philox(philox::seed,n);
+	    }
+    };
+}
+
+#endif /*CAMGEN_PHILOX_H_*/
+
@@ -20,6 +20,7 @@
 #include <Camgen/CM_algo.h>
 #include <Camgen/hel_gen.h>
 #include <Camgen/col_gen.h>
+#include <Camgen/col_matrix.h>
 #include <Camgen/ps_gen.h>
 #include <Camgen/rn_strm.h>
 
@@ -47,12 +48,17 @@ namespace Camgen
 
     template<class model_t,std::size_t N_in,std::size_t N_out,class rng_t>class process_generator_factory_base;
 
+    /* Forward declaration of event generator: */
+
+    template<class model_t,std::size_t N_in,std::size_t N_out,class rng_t>class event_generator;
+
     /// Single-process matrix-element Monte Carlo event generator class.
 
     template<class model_t,std::size_t N_in,std::size_t N_out, class rng_t>class process_generator: public MC_integrator<typename model_t::value_type>,
                                                                                                     public event_generator_base<model_t,N_in,N_out>
     {
 	friend class process_generator_factory_base<model_t,N_in,N_out,rng_t>;
+	friend class event_generator<model_t,N_in,N_out,rng_t>;
 
 	typedef MC_generator<typename model_t::value_type> base_type;
 	
@@ -127,6 +133,10 @@ namespace Camgen
 		{
 		    delete col_gen;
 		}
+		if(col_ordered!=NULL)
+		{
+		    delete col_ordered;
+		}
                 if(subproc!=NULL)
                 {
                     delete subproc;
@@ -445,6 +455,11 @@ namespace Camgen
 		{
 		    model_type::set_QCD_scale(this->R_scale());
 		}
+		if(col_ordered!=NULL)
+		{
+		    me=col_ordered->evaluate(summed_spins);
+		    return;
+		}
 		if(summed_spins.any() or summed_colours.any())
 		{
 		    me=amplitude->evaluate(summed_spins,summed_colours);
@@ -504,21 +519,41 @@ namespace Camgen
 		    generate();
 		    return false;
 		}
-		value_type rho=std::numeric_limits<value_type>::infinity();
-		do
+		value_type r(1);
+		if(two_stage_unweighting and !auto_update and max_me>(value_type)0)
 		{
-		    generate();
-		    if(!is_finite_number(tot_weight))
+		    while(!throw_unweighted_event());
+		    r=bound_weight_factor;
+		}
+		else
+		{
+		    value_type rho=std::numeric_limits<value_type>::infinity();
+		    do
 		    {
-			continue;
+			generate();
+			if(!is_finite_number(tot_weight))
+			{
+			    continue;
+			}
+			rho=throw_number((value_type)0,this->max_w_eps);
+		    }
+		    while(rho>tot_weight);
+		}
+		if(tot_weight>this->max_w_eps)
+		{
+		    ++overweight_events;
+		    if(partial_unweighting)
+		    {
+			r*=(tot_weight/this->max_w_eps);
 		    }
-		    rho=throw_number((value_type)0,this->max_w_eps);
 		}
-		while(rho>tot_weight);
-		tot_weight=this->cross_section().value;
+		++unweighted_events;
+		w_factor_sum+=r;
+		tot_weight=r*this->cross_section().value;
 		this->refresh_max_weight();
 		this->weight()=tot_weight;
 		this->integrand()=(value_type)1;
+		this->get_event_ptr()->set_w(tot_weight);
 		if(verbose)
 		{
 		    std::cout<<".....done."<<std::endl;
@@ -608,6 +643,7 @@ namespace Camgen
 			if(accept(me))
 			{
 			    set_integrands(me*f);
+			    max_me=std::max(max_me,me);
 			}
 			else
 			{
@@ -627,6 +663,82 @@ namespace Camgen
 		return true;
 	    }
 
+	    /* Two-stage unweighting helper: throws momenta, helicities, colours
+	     * and the hit-or-miss number, and evaluates the amplitude only if
+	     * the latter lies below the weight bound obtained from the maximal
+	     * matrix element. Consumes the same random numbers as the
+	     * single-stage loop, so the accepted events are identical as long
+	     * as the bound holds. If the matrix element exceeds the bound, the
+	     * event passed the hit-or-miss test with a too small probability,
+	     * and the ratio of the true and the used acceptance probabilities
+	     * is stored in bound_weight_factor. Returns whether the event is
+	     * accepted. */
+
+	    bool throw_unweighted_event()
+	    {
+		++evt_counter;
+		bound_weight_factor=(value_type)1;
+		bool q1=generate_momenta();
+		bool q2=generate_helicities();
+		bool q3=generate_colours();
+		if(!(q1 and q2 and q3))
+		{
+		    this->weight()=(value_type)0;
+		    set_integrands(0);
+		    copy_event_data();
+		    return !(throw_number((value_type)0,this->max_w_eps)>tot_weight);
+		}
+		this->weight()=ps_weight*hel_weight*col_weight;
+		value_type f=pb_conversion*symmetry_factor*ps_factor*hel_factor*col_factor;
+		value_type w_bound=this->weight()*f*me_bound();
+		bool early=is_finite_number(w_bound);
+		value_type rho(0);
+		if(early)
+		{
+		    rho=throw_number((value_type)0,this->max_w_eps);
+		    if(rho>w_bound)
+		    {
+			++skipped_amplitudes;
+			set_integrands(0);
+			copy_event_data();
+			return false;
+		    }
+		}
+		set_integrands(0);
+		if(f!=(value_type)0)
+		{
+		    evaluate_amplitude();
+		    if(accept(me))
+		    {
+			if(me>me_bound())
+			{
+			    ++me_bound_violations;
+			    log(log_level::warning)<<CAMGEN_STREAMLOC<<"matrix element "<<me<<" exceeds two-stage unweighting bound "<<me_bound()<<", raising bound"<<endlog;
+			    if(early and w_bound<this->max_w_eps)
+			    {
+				bound_weight_factor=std::min(me*f*this->weight(),this->max_w_eps)/w_bound;
+			    }
+			}
+			set_integrands(me*f);
+			max_me=std::max(max_me,me);
+		    }
+		}
+		copy_event_data();
+		if(tot_weight!=(value_type)0)
+		{
+		    ++pos_evt_counter;
+		}
+		if(!early)
+		{
+		    if(!is_finite_number(tot_weight))
+		    {
+			return false;
+		    }
+		    rho=throw_number((value_type)0,this->max_w_eps);
+		}
+		return !(rho>tot_weight);
+	    }
+
 	    /// Implementation of the pass_cuts method.
 
 	    bool pass()
@@ -675,10 +787,12 @@ namespace Camgen
 		}
 	    }
 
-	    /// Adapts the generators.
+	    /// Adapts the generators. Pending worker shadows of the cross section
+	    /// are merged first.
 
 	    void adapt()
 	    {
+		this->MC_integrator<value_type>::merge_shadows();
 		bool q;
 		if(ps_gen!=NULL)
 		{
@@ -692,6 +806,31 @@ namespace Camgen
 		}
 	    }
 
+	    /// Sets the number of worker threads accumulating updates of the
+	    /// cross section and the momentum generator grids and multichannels
+	    /// (see shadow_acc.h).
+
+	    void set_update_workers(size_type n)
+	    {
+		this->MC_integrator<value_type>::set_update_workers(n);
+		if(ps_gen!=NULL)
+		{
+		    ps_gen->set_update_workers(n);
+		}
+	    }
+
+	    /// Merges the worker shadows of the cross section and the momentum
+	    /// generator.
+
+	    void merge_shadows()
+	    {
+		this->MC_integrator<value_type>::merge_shadows();
+		if(ps_gen!=NULL)
+		{
+		    ps_gen->merge_shadows();
+		}
+	    }
+
 	    /// Resets cross section, multichannel weights and adaptive grids of
 	    /// phase space, helicity and colour generators.
 
@@ -705,6 +844,12 @@ namespace Camgen
 		evt_counter=0;
 		pos_evt_counter=0;
 		update_counter=0;
+		max_me=0;
+		skipped_amplitudes=0;
+		me_bound_violations=0;
+		unweighted_events=0;
+		overweight_events=0;
+		w_factor_sum=0;
 		grid_adaptations=0;
 		channel_adaptations=0;
 	    }
@@ -720,6 +865,52 @@ namespace Camgen
 		}
 	    }
 
+	    /// Writes the weight sums, counters and the phase space generator
+	    /// grids and channel weights to the binary output stream. The
+	    /// helicity and colour generators have no adaptive state.
+
+	    void save_state(std::ostream& os) const
+	    {
+		this->MC_integrator<value_type>::save_state(os);
+		binary_io::write(os,evt_counter);
+		binary_io::write(os,pos_evt_counter);
+		binary_io::write(os,update_counter);
+		binary_io::write(os,grid_adaptations);
+		binary_io::write(os,channel_adaptations);
+		binary_io::write(os,max_me);
+		bool q=(ps_gen!=NULL);
+		binary_io::write(os,q);
+		if(q)
+		{
+		    ps_gen->save_state(os);
+		}
+	    }
+
+	    /// Reads the state written by save_state from the binary input
+	    /// stream.
+
+	    bool load_state(std::istream& is)
+	    {
+		if(!this->MC_integrator<value_type>::load_state(is))
+		{
+		    return false;
+		}
+		if(!(binary_io::read(is,evt_counter) and binary_io::read(is,pos_evt_counter) and binary_io::read(is,update_counter)))
+		{
+		    return false;
+		}
+		bool q;
+		if(!(binary_io::read(is,grid_adaptations) and binary_io::read(is,channel_adaptations) and binary_io::read(is,max_me) and binary_io::read(is,q)))
+		{
+		    return false;
+		}
+		if(q!=(ps_gen!=NULL))
+		{
+		    return false;
+		}
+		return (ps_gen==NULL or ps_gen->load_state(is));
+	    }
+
 	    /// Refreshes phase space generator's internal parameters.
 
 	    bool refresh_params()
@@ -787,6 +978,47 @@ namespace Camgen
 		}
 	    }
 
+	    /// Sets the two-stage unweighting flag. If set, unweighted generation
+	    /// rejects trial events before evaluating the amplitude when the
+	    /// hit-or-miss number exceeds the event weight with the matrix element
+	    /// replaced by its bound. Only used when the generator is not
+	    /// auto-updating and a bound has been learned or supplied. Accepted
+	    /// events whose matrix element exceeds the bound get their event
+	    /// weight multiplied by the ratio of the matrix element and the
+	    /// bound, which keeps the distributions unbiased.
+
+	    void set_two_stage_unweighting(bool q)
+	    {
+		two_stage_unweighting=q;
+	    }
+
+	    /// Sets the partial unweighting flag. If set, unweighted events whose
+	    /// weight exceeds the epsilon-reduced maximal weight are given the
+	    /// cross section times the ratio of both weights as event weight,
+	    /// instead of being truncated to the cross section. Distributions
+	    /// should then be normalised by the sum of the event weights.
+
+	    void set_partial_unweighting(bool q)
+	    {
+		partial_unweighting=q;
+	    }
+
+	    /// Sets the matrix element bound used in two-stage unweighting,
+	    /// overriding the maximum learned during initialisation.
+
+	    void set_me_bound(const value_type& me_max)
+	    {
+		max_me=me_max/me_bound_factor;
+	    }
+
+	    /// Sets the safety factor multiplying the learned maximal matrix
+	    /// element in the two-stage unweighting bound.
+
+	    void set_me_bound_factor(const value_type& x)
+	    {
+		me_bound_factor=x;
+	    }
+
 	    /// Sets whther to use the pdf alpha_s.
 
 	    void set_pdf_alpha_s(bool q)
@@ -1019,6 +1251,44 @@ namespace Camgen
 		return tot_weight;
 	    }
 
+	    /// Returns the matrix element bound used in two-stage unweighting.
+
+	    value_type me_bound() const
+	    {
+		return me_bound_factor*max_me;
+	    }
+
+	    /// Returns the number of unweighted events generated.
+
+	    size_type unweighted_event_count() const
+	    {
+		return unweighted_events;
+	    }
+
+	    /// Returns the number of unweighted events with a weight above the
+	    /// epsilon-reduced maximal weight.
+
+	    size_type overweight_event_count() const
+	    {
+		return overweight_events;
+	    }
+
+	    /// Returns the number of matrix elements exceeding the two-stage
+	    /// unweighting bound.
+
+	    size_type me_bound_violation_count() const
+	    {
+		return me_bound_violations;
+	    }
+
+	    /// Returns the average unweighted event weight in units of the cross
+	    /// section, which exceeds one in partial unweighting mode.
+
+	    value_type average_weight_factor() const
+	    {
+		return (unweighted_events==0)?(value_type)1:(w_factor_sum/unweighted_events);
+	    }
+
 	    /// Returns the maximal event weight.
 
 	    value_type max_w() const
@@ -1218,6 +1488,11 @@ namespace Camgen
 		os<<"Nr of updates performed:                           "<<std::scientific<<update_counter<<std::endl;
 		os<<"Nr of grid adaptations performed:                  "<<std::scientific<<grid_adaptations<<std::endl;
 		os<<"Nr of channel adaptations performed:               "<<std::scientific<<channel_adaptations<<std::endl;
+		os<<"Nr of amplitudes skipped by two-stage unweighting: "<<std::scientific<<skipped_amplitudes<<std::endl;
+		os<<"Nr of matrix element bound violations:             "<<std::scientific<<me_bound_violations<<std::endl;
+		os<<"Nr of unweighted events generated:                 "<<std::scientific<<unweighted_events<<std::endl;
+		os<<"Nr of overweight unweighted events:                "<<std::scientific<<overweight_events<<std::endl;
+		os<<"Average unweighted event weight / cross section:   "<<std::scientific<<average_weight_factor()<<std::endl;
 		os<<"Monte Carlo efficiency (%):                        "<<std::scientific<<this->efficiency()<<std::endl;
 		os<<"Cross section (pb):                                "<<std::scientific<<this->cross_section()<<std::endl;
 		os<<"###############################################################################################"<<std::endl;
@@ -1280,6 +1555,8 @@ namespace Camgen
 		{
 		    os<<col_gen->type()<<std::endl;
 		}
+		os<<std::setw(30)<<std::left<<"two-stage unweighting:"<<(two_stage_unweighting?"yes":"no")<<std::endl;
+		os<<std::setw(30)<<std::left<<"partial unweighting:"<<(partial_unweighting?"yes":"no")<<std::endl;
 		os<<std::setw(30)<<std::left<<"momentum generator:";
 		if(ps_gen==NULL)
 		{
@@ -1297,7 +1574,7 @@ namespace Camgen
 
 	    /* Private constructor, no configuration performed: */
 
-	    process_generator(CM_tree_iterator it,int id_=1):id(id_),symmetry_factor(it->symmetry_factor()),amplitude(it),evt_counter(0),pos_evt_counter(0),tot_weight(0),zero_me(it->count_diagrams()==(long long unsigned)0),me(1),subproc(create_sub_proc(it)),ps_gen(NULL),ps_weight(1),ps_factor(1),hel_gen(NULL),hel_weight(1),hel_factor(1),col_gen(NULL),col_weight(1),col_factor(1),update_counter(0),auto_update(false),grid_adaptations(0),auto_grid_adapt(0),channel_adaptations(0),auto_channel_adapt(0),max_rejects(std::numeric_limits<size_type>::max()),alpha_pdf(true)
+	    process_generator(CM_tree_iterator it,int id_=1):id(id_),symmetry_factor(it->symmetry_factor()),amplitude(it),evt_counter(0),pos_evt_counter(0),tot_weight(0),zero_me(it->count_diagrams()==(long long unsigned)0),me(1),subproc(create_sub_proc(it)),ps_gen(NULL),ps_weight(1),ps_factor(1),hel_gen(NULL),hel_weight(1),hel_factor(1),col_gen(NULL),col_weight(1),col_factor(1),col_ordered(NULL),update_counter(0),auto_update(false),grid_adaptations(0),auto_grid_adapt(0),channel_adaptations(0),auto_channel_adapt(0),max_rejects(std::numeric_limits<size_type>::max()),alpha_pdf(true),two_stage_unweighting(false),max_me(0),me_bound_factor(2),skipped_amplitudes(0),me_bound_violations(0),bound_weight_factor(1),partial_unweighting(false),unweighted_events(0),overweight_events(0),w_factor_sum(0)
 	    {
 		summed_spins.reset();
 		summed_colours.reset();
@@ -1339,6 +1616,15 @@ namespace Camgen
 			summed_colours[i]=col_gen->sum_colour(i);
 		    }
 		}
+		if(col_ordered!=NULL)
+		{
+		    delete col_ordered;
+		    col_ordered=NULL;
+		}
+		if(col_gen!=NULL and col_gen->colour_ordered())
+		{
+		    col_ordered=colour_matrix_algorithm_factory<model_t,N_in,N_out>::create_algorithm(amplitude);
+		}
 	    }
 
 	    /* Sets the phase space generator type: */
@@ -1451,6 +1737,11 @@ namespace Camgen
 
 	    value_type col_weight,col_factor;
 
+	    /* Colour-ordered amplitude algorithm, used for the colour sum of
+	     * pure-gluon processes if the colour generator requests it: */
+
+	    typename colour_matrix_algorithm_factory<model_t,N_in,N_out>::algorithm_type* col_ordered;
+
 	    /* Update counter: */
 
 	    size_type update_counter;
@@ -1483,6 +1774,35 @@ namespace Camgen
 
 	    bool alpha_pdf;
 
+	    /* Two-stage unweighting flag: */
+
+	    bool two_stage_unweighting;
+
+	    /* Maximal matrix element encountered and the safety factor of the
+	     * two-stage unweighting bound: */
+
+	    value_type max_me,me_bound_factor;
+
+	    /* Amplitude evaluations skipped by two-stage unweighting and matrix
+	     * elements exceeding the bound: */
+
+	    size_type skipped_amplitudes,me_bound_violations;
+
+	    /* Weight correction of the last two-stage unweighted event whose
+	     * matrix element exceeded the bound: */
+
+	    value_type bound_weight_factor;
+
+	    /* Partial unweighting flag: */
+
+	    bool partial_unweighting;
+
+	    /* Unweighted and overweight event counters and the sum of the
+	     * unweighted event weights in units of the cross section: */
+
+	    size_type unweighted_events,overweight_events;
+	    value_type w_factor_sum;
+
             /* Copies process generator data to event: */
 
             void copy_event_data()
@@ -21,6 +21,7 @@
 #include <map>
 #include <Camgen/evt_stream.h>
 #include <Camgen/evt_output_conf.h>
+#include <Camgen/gz_ostream.h>
 
 namespace Camgen
 {
@@ -139,7 +140,7 @@ namespace Camgen
 		    return false;
 		}
 		std::ofstream ofs;
-		std::string fname(output->file_name+"_stats.dat");
+		std::string fname(gz_ofstream::base_name(output->file_name)+"_stats.dat");
 		ofs.open(fname.c_str());
 		if(ofs.is_open())
 		{
@@ -195,13 +196,17 @@ namespace Camgen
 
             proc_stream& add_process(size_type id)
             {
-		std::string namebase(output->file_name);
+		std::string namebase(gz_ofstream::base_name(output->file_name));
 		if(namebase.size()==0)
 		{
 		    namebase="proc";
 		}
                 std::stringstream ss;
                 ss<<namebase<<'_'<<id;
+                if(gz_ofstream::is_compressed(output->file_name))
+                {
+                    ss<<".gz";
+                }
                 std::string fname(ss.str());
                 
                 event_output<model_t,N_in,N_out>* sub_output=output->create(fname);
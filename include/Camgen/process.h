@@ -8,6 +8,7 @@
 #ifndef CAMGEN_PROCESS_H_
 #define CAMGEN_PROCESS_H_
 
+#include <list>
 #include <algorithm>
 #include <Camgen/decomp_proc.h>
 #include <Camgen/particle.h>
@@ -247,24 +248,33 @@ namespace Camgen
 		return !(this->operator<(p));
 	    }
 
-	    /* Function adding a process tree to a list of trees: */ 
+	    /* Function adding a process tree, built upon the current tree data,
+	     * to a list of trees: */ 
 
-	    std::list<tree_type>& add_tree(std::list<tree_type>& trees)
+	    std::list<tree_type>& add_tree(std::list<tree_type>& trees,typename tree_type::current_tree_type& data)
 	    {
-		trees.push_back(tree_type(IS_particles,FS_particles));
+		trees.push_back(tree_type(IS_particles,FS_particles,data));
 		tree_it=trees.end();
 		--tree_it;
 		return trees;
 	    }
 
-	    /* Function inserting a process tree to a list of trees: */ 
+	    /* Function inserting a process tree, built upon the current tree
+	     * data, to a list of trees: */ 
 
-	    tree_iterator insert_tree(std::list<tree_type>& trees,tree_iterator it)
+	    tree_iterator insert_tree(std::list<tree_type>& trees,tree_iterator it,typename tree_type::current_tree_type& data)
 	    {
-		tree_it=trees.insert(it,tree_type(IS_particles,FS_particles));
+		tree_it=trees.insert(it,tree_type(IS_particles,FS_particles,data));
 		return tree_it;
 	    }
 
+	    /* Tree iterator assignment (used when copying process lists): */
+
+	    void set_tree(tree_iterator it)
+	    {
+		tree_it=it;
+	    }
+
 	    /* Tree iterator access: */
 
 	    tree_iterator get_tree() const
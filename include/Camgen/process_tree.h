@@ -8,17 +8,20 @@
 #ifndef CAMGEN_PROCESS_TREE_H_
 #define CAMGEN_PROCESS_TREE_H_
 
-#include <list>
+#include <algorithm>
 #include <set>
+#include <map>
 #include <Camgen/current_tree.h>
 #include <Camgen/interaction.h>
+#include <Camgen/instruction.h>
 #include <Camgen/bspart.h>
+#include <Camgen/bin_io.h>
 #include <Camgen/def_args.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Definition of the process tree class template in Camgen. This class is at  *
  * the core of Camgen, and wraps all the interactions between the currents in *
- * the static current tree for a given subprocess.                             *
+ * the current tree of the algorithm instance for a given subprocess.          *
  *                                                                             *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -55,57 +58,71 @@ namespace Camgen
 
 	    typedef current<model_t,N_bits,decomposes> current_type;
 	    typedef interaction<model_t,N_bits,decomposes> interaction_type;
+	    typedef instruction_array<model_t,N_bits,decomposes> instruction_array_type;
 	    typedef current_tree<model_t,N_in,N_out> current_tree_type;
 	    
 	    /* Iterator definitions: */
 	    
 	    typedef typename std::vector<current_type>::iterator current_iterator;
 	    typedef typename std::vector<current_type>::const_iterator const_current_iterator;
-	    typedef typename std::list<interaction_type>::iterator interaction_iterator;
-	    typedef typename std::list<interaction_type>::const_iterator const_interaction_iterator;
-	    typedef typename std::list<interaction_type>::reverse_iterator reverse_interaction_iterator;
+	    typedef typename std::vector<interaction_type>::iterator interaction_iterator;
+	    typedef typename std::vector<interaction_type>::const_iterator const_interaction_iterator;
+	    typedef typename std::vector<interaction_type>::reverse_iterator reverse_interaction_iterator;
+
+	    /* Signature of an internal current in shared-current mode: the
+	     * external currents it is built from and, for every interaction
+	     * contributing to it in the tree, the vertex, the interacting
+	     * currents and the Fermi sign. Trees computing a current with equal
+	     * signatures produce equal amplitudes for it: */
+
+	    class current_signature
+	    {
+		public:
+
+		    std::vector<const current_type*>external_currents;
+		    std::vector<const vertex_type*>vertices;
+		    std::vector<const current_type*>interacting_currents;
+		    std::vector<int>Fermi_signs;
+
+		    bool operator == (const current_signature& other) const
+		    {
+			return (external_currents==other.external_currents and vertices==other.vertices and interacting_currents==other.interacting_currents and Fermi_signs==other.Fermi_signs);
+		    }
+	    };
 
 	    /* Declaring the CM_algorithm user interface class friend: */
 
 	    friend class CM_algorithm<model_t,N_in,N_out>;
 
-	    /* Static initialiser: */
+	    /* Constructor from a vector of incoming particles, a vector of
+	     * outgoing particles and the current tree owned by the algorithm
+	     * instance: */
 
-	    static void initialise(std::size_t N_f)
+	    process_tree(const vector<const particle_type*,N_in>& in,const vector<const particle_type*,N_out>& out,current_tree_type& data):empty(true),counter(0),currents(&data)
 	    {
-		current_tree_type::initialise(N_f);
-		N_final=current_tree_type::final_current();
+		/* Copy the model and current tree data: */
 
-		if(!initialised)
-		{
-		    // TODO: refactor to deal with dynamically changing model
-		    // structure...
-
-		    max_rank=model_wrapper<model_t>::maximal_vertex_rank();
-		    flavours=model_wrapper<model_t>::flavours();
-		    bit_string_partition<N_bits>::initialise(max_rank-1);
-		    bit_string_partition<N_bits>::sort();
-		    initialised=true;
-		}
-	    }
+		max_rank=model_wrapper<model_t>::maximal_vertex_rank();
+		flavours=model_wrapper<model_t>::flavours();
+		N_final=currents->final_current();
 
-	    /* Constructor from a vector of incoming particles and a vector of
-	     * outgoing particles: */
+		/* Initialise the shared bit string partition table. Levels
+		 * generated before are read-only, so concurrently constructed
+		 * trees only serialise on the extension: */
 
-	    process_tree(const vector<const particle_type*,N_in>& in,const vector<const particle_type*,N_out>& out):empty(true),counter(0)
-	    {
+		bit_string_partition<N_bits>::prepare(max_rank-1);
 
 		/* Copying initial current addresses to the process tree: */
 
 		init_currents.reserve(N_bits);
-		current_iterator it=current_tree_type::begin();
+		current_iterator it=currents->begin();
 		for(size_type i=0;i<N_in;++i)
 		{
 		    if(in[i]==NULL)
 		    {
 			log(log_level::error)<<CAMGEN_STREAMLOC<<"incoming particle "<<i<<" was not instantiated"<<endlog;
 		    }
-		    if(i != current_tree_type::final_current())
+		    if(i != N_final)
 		    {
 			init_currents.push_back(it+in[i]->get_flavour());
 			it+=flavours;
@@ -126,7 +143,7 @@ namespace Camgen
 
 		/* Copying final current addresses to the process tree: */
 
-		it=current_tree_type::end()-flavours;
+		it=currents->end()-flavours;
 		if(N_final<N_in)
 		{
 		    final_current=it+in[N_final]->get_flavour();
@@ -138,6 +155,32 @@ namespace Camgen
 		evaluate_symmetry_factor();
 	    }
 
+	    /* Re-targets the (copied) process tree to the argument current tree,
+	     * which should be a copy of the current tree the process tree was
+	     * built upon. The interaction topology is left untouched, only the
+	     * current addresses are moved: */
+
+	    void rebind(current_tree_type& data)
+	    {
+		current_iterator old_begin=currents->begin();
+		current_iterator new_begin=data.begin();
+		currents=&data;
+		for(size_type i=0;i<init_currents.size();++i)
+		{
+		    init_currents[i]=new_begin+(init_currents[i]-old_begin);
+		}
+		final_current=new_begin+(final_current-old_begin);
+		for(interaction_iterator it=interactions.begin();it!=interactions.end();++it)
+		{
+		    it->rebind(old_begin,new_begin);
+		}
+		if(!empty)
+		{
+		    final_current->set_argument(&(interactions.back().get_produced_current()->amplitude));
+		}
+		assign_momenta();
+	    }
+
 	    /* Tree building initialisation function, marking the initial and
 	     * final currents: */
 
@@ -183,7 +226,7 @@ namespace Camgen
 
 		if(!empty)
 		{
-		    interactions.sort();
+		    std::stable_sort(interactions.begin(),interactions.end());
 		}
 	    }
 
@@ -195,7 +238,7 @@ namespace Camgen
 		{
 		    /* Unmark all currents: */
 
-		    current_tree_type::unmark();
+		    currents->unmark();
 
 		    /* Starting from the last interaction, iteratively mark all
 		     * participating currents and their interactions: */
@@ -223,7 +266,12 @@ namespace Camgen
 		    /* Remove the unmarked interactions: */
 
 		    redundant<interaction_type>pred;
-		    interactions.remove_if(pred);
+		    interactions.erase(std::remove_if(interactions.begin(),interactions.end(),pred),interactions.end());
+
+		    /* Compact the evaluation schedule into a tightly allocated
+		     * contiguous block: */
+
+		    std::vector<interaction_type>(interactions).swap(interactions);
 		}
 		else
 		{
@@ -232,7 +280,7 @@ namespace Camgen
 
 		/* Unmark all currents again: */
 
-		current_tree_type::unmark();
+		currents->unmark();
 	    }
 
 	    /* Current initialisation phase: */
@@ -265,7 +313,9 @@ namespace Camgen
 		}
 	    }
 
-	    /* Momentum policy determination function: */
+	    /* Momentum policy determination function. Since this fixes the
+	     * interactions of the tree, the evaluation schedule is lowered
+	     * afterwards: */
 
 	    void assign_momenta()
 	    {
@@ -336,6 +386,10 @@ namespace Camgen
 			}
 		    }
 		}
+
+		/* Lower the interactions into the instruction array: */
+
+		schedule.lower(interactions);
 	    }
 
 	    /* Computes all the coupling flags (this is done every evaluation
@@ -411,7 +465,7 @@ namespace Camgen
 		
 		/* Reset all multiplicities: */
 
-		for(current_iterator it=current_tree_type::begin();it != current_tree_type::end();++it)
+		for(current_iterator it=currents->begin();it != currents->end();++it)
 		{
 		    it->multiplicity=0;
 		}
@@ -673,23 +727,41 @@ namespace Camgen
 		    }
 		}
 		r_value_type summed_amplitude(0);
-		size_type counter=0;
+
+		/* Loop over the external degrees of freedom. Only the
+		 * subamplitudes depending on the external currents that changed
+		 * w.r.t. the previous configuration are recomputed, the others
+		 * are reused: */
+
+		std::bitset<N_bits>changed;
+		changed.set();
+		bool proceed;
 		do
 		{
-		    for(interaction_iterator it=interactions.begin();it!=interactions.end();++it)
+		    for(size_type i=0;i<interactions.size();++i)
 		    {
-			it->evaluate();
+			if((interactions[i].get_produced_bit_string()&changed).any())
+			{
+			    schedule.execute(i);
+			}
 		    }
 		    r_value_type M=std::norm(final_current->contract_wave_function());
 		    summed_amplitude+=M;
-		    ++counter;
+		    changed.reset();
+		    proceed=next_dof_configuration(summed_spins,summed_cols,changed);
 		    for(interaction_iterator it=interactions.begin();it!=interactions.end();++it)
 		    {
-			it->reset();
+			if(!proceed or (it->get_produced_bit_string()&changed).any())
+			{
+			    it->reset();
+			}
+		    }
+		    if(!proceed or changed.any())
+		    {
+			(--interactions.end())->get_produced_current()->reset();
 		    }
-		    (--interactions.end())->get_produced_current()->reset();
 		}
-		while(next_dof_configuration(summed_spins,summed_cols));
+		while(proceed);
 		return colsum_factor*summed_amplitude;
 	    }
 
@@ -708,10 +780,7 @@ namespace Camgen
 
 		/* Evaluate all recursive relations: */
 
-		for(interaction_iterator it=interactions.begin();it != interactions.end();++it)
-		{
-		    it->evaluate();
-		}
+		schedule.execute();
 
 		/* Evaluate the final-particle wave function: */
 
@@ -723,6 +792,216 @@ namespace Camgen
 		return final_current->contract_wave_function();
 	    }
 
+	    /* Tree evaluation function in shared-current mode, where all trees
+	     * of the algorithm are evaluated in a row. Internal currents that
+	     * were last computed by a previous tree from the same external
+	     * currents are reused instead of recomputed (see
+	     * share_currents()): */
+
+	    value_type evaluate_shared()
+	    {
+		if(empty){return value_type(0,0);}
+
+		/* Evaluate initial external wave functions: */
+
+		for(size_type i=0;i<init_currents.size();++i)
+		{
+		    init_currents[i]->reset();
+		    init_currents[i]->evaluate();
+		}
+
+		/* Reset the produced currents that are recomputed: */
+
+		for(size_type i=0;i<interactions.size();++i)
+		{
+		    if(!reused[i])
+		    {
+			interactions[i].reset();
+		    }
+		}
+		if(!reused.back())
+		{
+		    interactions.back().get_produced_current()->reset();
+		}
+
+		/* Evaluate the remaining recursive relations: */
+
+		for(size_type i=0;i<interactions.size();++i)
+		{
+		    if(!reused[i])
+		    {
+			schedule.execute(i);
+		    }
+		}
+
+		/* Evaluate the final-particle wave function, which may be
+		 * shared with other trees, and contract: */
+
+		final_current->reset();
+		final_current->evaluate();
+		final_current->set_argument(&(interactions.back().get_produced_current()->amplitude));
+		return final_current->contract_wave_function();
+	    }
+
+	    /* Determines which interactions may be skipped in shared-current
+	     * mode. The argument maps the internal currents to the signatures
+	     * they were last computed with by the trees preceding this one, and
+	     * is updated with the currents computed by this tree. A current is
+	     * reused only if its external currents, contributing interactions
+	     * and their Fermi signs all coincide: */
+
+	    void share_currents(std::map<const current_type*,current_signature>& producers)
+	    {
+		reused.assign(interactions.size(),false);
+		size_type i=0;
+		while(i<interactions.size())
+		{
+		    const current_type* c=&(*(interactions[i].get_produced_current()));
+		    current_signature sig;
+		    bit_string<N_bits>b=interactions[i].get_produced_bit_string();
+		    for(size_type j=0;j<N_bits;++j)
+		    {
+			if(b[j])
+			{
+			    sig.external_currents.push_back(&(*(init_currents[j])));
+			}
+		    }
+		    size_type k=i;
+		    while(k<interactions.size() and &(*(interactions[k].get_produced_current()))==c)
+		    {
+			sig.vertices.push_back(interactions[k].get_vertex());
+			sig.Fermi_signs.push_back(interactions[k].get_Fermi_sign());
+			for(typename std::vector<current_iterator>::const_iterator it=interactions[k].begin();it!=interactions[k].end();++it)
+			{
+			    sig.interacting_currents.push_back(&(**it));
+			}
+			++k;
+		    }
+		    typename std::map<const current_type*,current_signature>::iterator it=producers.find(c);
+		    bool reuse=(it!=producers.end() and it->second==sig);
+		    if(!reuse)
+		    {
+			producers[c]=sig;
+		    }
+		    for(;i<k;++i)
+		    {
+			reused[i]=reuse;
+		    }
+		}
+	    }
+
+	    /* Writes the interaction topology of the tree to the binary output
+	     * stream. The external currents, and for every interaction the
+	     * vertex index in the model, the produced leg and the offsets of
+	     * the currents in the current tree are written: */
+
+	    void write_topology(std::ostream& os,const std::map<const vertex_type*,unsigned>& vertex_indices) const
+	    {
+		current_iterator first=currents->begin();
+		for(size_type i=0;i<init_currents.size();++i)
+		{
+		    binary_io::write(os,(unsigned)(init_currents[i]-first));
+		}
+		binary_io::write(os,(unsigned)(final_current-first));
+		binary_io::write(os,(unsigned)(empty?1:0));
+		binary_io::write(os,(unsigned)interactions.size());
+		for(const_interaction_iterator it=interactions.begin();it!=interactions.end();++it)
+		{
+		    typename std::map<const vertex_type*,unsigned>::const_iterator v=vertex_indices.find(it->get_vertex());
+		    binary_io::write(os,(v==vertex_indices.end())?(unsigned)(-1):v->second);
+		    binary_io::write(os,(unsigned)(it->get_produced_leg()));
+		    for(typename std::vector<current_iterator>::const_iterator c=it->begin();c!=it->end();++c)
+		    {
+			binary_io::write(os,(unsigned)(*c-first));
+		    }
+		}
+	    }
+
+	    /* Removes all interactions from the tree: */
+
+	    void clear_topology()
+	    {
+		interactions.clear();
+		schedule.clear();
+		reused.clear();
+		empty=true;
+	    }
+
+	    /* Reads the interaction topology written by write_topology and
+	     * rebuilds the evaluation schedule. Returns false if the external
+	     * currents do not match the ones of this tree or if the data is
+	     * inconsistent with the model, in which case the tree is left
+	     * empty: */
+
+	    bool read_topology(std::istream& is)
+	    {
+		clear_topology();
+		current_iterator first=currents->begin();
+		size_type N_currents=currents->end()-first;
+		unsigned n;
+		for(size_type i=0;i<init_currents.size();++i)
+		{
+		    if(!binary_io::read(is,n) or n>=N_currents or first+n!=init_currents[i])
+		    {
+			return false;
+		    }
+		}
+		if(!binary_io::read(is,n) or n>=N_currents or first+n!=final_current)
+		{
+		    return false;
+		}
+		unsigned is_empty,N_interactions;
+		if(!binary_io::read(is,is_empty) or !binary_io::read(is,N_interactions))
+		{
+		    return false;
+		}
+		if(N_interactions>N_currents*model_wrapper<model_t>::vertices())
+		{
+		    return false;
+		}
+		interactions.reserve(N_interactions);
+		for(unsigned k=0;k<N_interactions;++k)
+		{
+		    unsigned v,leg;
+		    if(!binary_io::read(is,v) or !binary_io::read(is,leg))
+		    {
+			interactions.clear();
+			return false;
+		    }
+		    const vertex_type* vert=model_wrapper<model_t>::get_vertex(v);
+		    if(vert==NULL or leg>=vert->get_rank())
+		    {
+			interactions.clear();
+			return false;
+		    }
+		    std::vector<current_iterator>in_currents(vert->get_rank());
+		    for(size_type i=0;i<in_currents.size();++i)
+		    {
+			if(!binary_io::read(is,n) or n>=N_currents)
+			{
+			    interactions.clear();
+			    return false;
+			}
+			in_currents[i]=first+n;
+		    }
+		    interaction_type node(vert,leg);
+		    if(!node.match_currents(in_currents))
+		    {
+			interactions.clear();
+			return false;
+		    }
+		    node.insert_currents(in_currents);
+		    node.fetch_Feynman_rule();
+		    interactions.push_back(node);
+		}
+		empty=(is_empty!=0 or interactions.empty());
+		if(empty)
+		{
+		    interactions.clear();
+		}
+		return true;
+	    }
+
 	    /* Function evaluating the next interaction/wave function w.r.t. the
 	     * counter: */
 
@@ -747,12 +1026,7 @@ namespace Camgen
 
 		else if(counter<(interactions.size()+N_bits))
 		{
-		    interaction_iterator it=interactions.begin();
-		    for(size_type i=0;i<(counter-N_bits);++i)
-		    {
-			++it;
-		    }
-		    it->evaluate();
+		    schedule.execute(counter-N_bits);
 		    ++counter;
 		    return counter;
 		}
@@ -949,6 +1223,7 @@ namespace Camgen
 		level=0;
 		B.reset();
 		interactions.clear();
+		schedule.clear();
 		empty=true;
 	    }
 
@@ -999,16 +1274,16 @@ namespace Camgen
 		}
 	    }
 
-	    /* Returns a const iterator to the beginning of the list of interactions
-	     * defining the tree: */
+	    /* Returns a const iterator to the beginning of the schedule of
+	     * interactions defining the tree: */
 
 	    const_interaction_iterator interactions_begin() const
 	    {
 		return interactions.begin();
 	    }
 
-	    /* Returns a const iterator to the end of the list of interactions defining
-	     * the tree: */
+	    /* Returns a const iterator to the end of the schedule of interactions
+	     * defining the tree: */
 
 	    const_interaction_iterator interactions_end() const
 	    {
@@ -1033,9 +1308,20 @@ namespace Camgen
 	    
 	    current_iterator final_current;
 
-	    /* List of interaction objects participating in the tree: */
+	    /* Interaction objects participating in the tree, in order of
+	     * evaluation: */
+
+	    std::vector<interaction_type>interactions;
+
+	    /* Evaluation schedule: the interactions lowered into a contiguous
+	     * instruction array: */
 
-	    std::list<interaction_type>interactions;
+	    instruction_array_type schedule;
+
+	    /* Flags denoting the interactions whose produced currents are
+	     * reused from a previous tree in shared-current mode: */
+
+	    std::vector<bool>reused;
 	    
 	    /* Utility bit string: */
 	    
@@ -1053,34 +1339,41 @@ namespace Camgen
 
 	    size_type symm_factor;
 
+	    /* Current tree holding the currents of the process tree: */
+
+	    current_tree_type* currents;
+
 	    /* Maximum vertex rank in the model under consideration: */
 
-	    static size_type max_rank;
+	    size_type max_rank;
 	    
 	    /* Number of flavours in the model under consideration: */
 	    
-	    static size_type flavours;
+	    size_type flavours;
 
 	    /* Final current: */
 
-	    static std::size_t N_final;
-
-	    /* Initialisation tag: */
-
-	    static bool initialised;
+	    std::size_t N_final;
 	    
 	    /* Bit string partition table: */
 	    
 	    std::vector< std::vector< bit_string<N_bits> > >partition;
 
 	    /* function moving to the next helicity configuration of external
-	     * particles in a spin sum: */
+	     * particles in a spin sum. The momentum channels of the initial
+	     * external currents whose wave functions changed are added to the
+	     * last argument: */
 
-	    bool next_dof_configuration(std::bitset<N_in+N_out>summed_spins,std::bitset<N_in+N_out>summed_cols)
+	    bool next_dof_configuration(std::bitset<N_in+N_out>summed_spins,std::bitset<N_in+N_out>summed_cols,std::bitset<N_bits>& changed)
 	    {
 		for(size_type n=0;n<N_final;++n)
 		{
-		    if(!init_currents[n]->evaluate_dof_sum(summed_spins[n],summed_cols[n]))
+		    bool carry=init_currents[n]->evaluate_dof_sum(summed_spins[n],summed_cols[n]);
+		    if(summed_spins[n] or summed_cols[n])
+		    {
+			changed|=init_currents[n]->get_bit_string();
+		    }
+		    if(!carry)
 		    {
 			return true;
 		    }
@@ -1091,7 +1384,12 @@ namespace Camgen
 		}
 		for(size_type n=N_final+1;n<N_in+N_out;++n)
 		{
-		    if(!init_currents[n-1]->evaluate_dof_sum(summed_spins[n],summed_cols[n]))
+		    bool carry=init_currents[n-1]->evaluate_dof_sum(summed_spins[n],summed_cols[n]);
+		    if(summed_spins[n] or summed_cols[n])
+		    {
+			changed|=init_currents[n-1]->get_bit_string();
+		    }
+		    if(!carry)
 		    {
 			return true;
 		    }
@@ -1142,8 +1440,8 @@ namespace Camgen
 			
 			for(size_type k=0;k<n;++k)
 			{
-			    iters[k]=current_tree_type::first_marked_current(partition[j][k]);
-			    if(iters[k]==current_tree_type::end())
+			    iters[k]=currents->first_marked_current(partition[j][k]);
+			    if(iters[k]==currents->end())
 			    {
 				abort=true;
 				break;
@@ -1185,7 +1483,7 @@ namespace Camgen
 
 				    /* Reconstruct the produced current: */
 
-				    current_iterator prod_curr=current_tree_type::find_current(B,f_iter->second.get_produced_particle());
+				    current_iterator prod_curr=currents->find_current(B,f_iter->second.get_produced_particle());
 
 				    /* Mark it for future iterations: */
 
@@ -1219,12 +1517,12 @@ namespace Camgen
 
 				    node.fetch_Feynman_rule();
 
-				    /* Add the interaction to the list: */
+				    /* Add the interaction to the schedule: */
 
 				    interactions.push_back(node);
 				}
 			    }
-			    while(current_tree_type::next_marked_currents(iters));
+			    while(currents->next_marked_currents(iters));
 			}
 		    }
 		}
@@ -1271,8 +1569,8 @@ namespace Camgen
 			
 			for(size_type k=0;k<n;++k)
 			{
-			    iters[k]=current_tree_type::first_marked_current(partition[j][k]);
-			    if(iters[k]==current_tree_type::end())
+			    iters[k]=currents->first_marked_current(partition[j][k]);
+			    if(iters[k]==currents->end())
 			    {
 				abort=true;
 				break;
@@ -1320,7 +1618,7 @@ namespace Camgen
 				    
 					/* Reconstruct the produced current: */
 
-					current_iterator prod_curr = current_tree_type::find_current(B,f_iter->second.get_produced_particle());
+					current_iterator prod_curr = currents->find_current(B,f_iter->second.get_produced_particle());
 
 					/* Mark it: */
 
@@ -1354,13 +1652,13 @@ namespace Camgen
 
 					node.fetch_Feynman_rule();
 
-					/* Add the interaction to the list: */
+					/* Add the interaction to the schedule: */
 
 					interactions.push_back(node);
 				    }
 				}
 			    }
-			    while(current_tree_type::next_marked_currents(iters));
+			    while(currents->next_marked_currents(iters));
 			}
 		    }
 		}
@@ -1398,10 +1696,6 @@ namespace Camgen
     };
     template<class model_t,std::size_t N_in,std::size_t N_out>const std::size_t process_tree<model_t,N_in,N_out>::N_bits;
     template<class model_t,std::size_t N_in,std::size_t N_out>const bool process_tree<model_t,N_in,N_out>::decomposes;
-    template<class model_t,std::size_t N_in,std::size_t N_out>typename process_tree<model_t,N_in,N_out>::size_type process_tree<model_t,N_in,N_out>::max_rank=0;
-    template<class model_t,std::size_t N_in,std::size_t N_out>typename process_tree<model_t,N_in,N_out>::size_type process_tree<model_t,N_in,N_out>::flavours=0;
-    template<class model_t,std::size_t N_in,std::size_t N_out>std::size_t process_tree<model_t,N_in,N_out>::N_final=0;
-    template<class model_t,std::size_t N_in,std::size_t N_out>bool process_tree<model_t,N_in,N_out>::initialised=false;
 
     /* Function requesting whether the tree is empty: */
 
@@ -308,6 +308,19 @@ namespace Camgen
 
 	    virtual std::string type() const=0;
 
+	    /* Returns a string identifying the branching by its type and the
+	     * names of the outgoing channels: */
+
+	    std::string signature() const
+	    {
+		std::string result=type();
+		for(size_type i=0;i<channels.size();++i)
+		{
+		    result+=(","+channels[i]->name);
+		}
+		return result;
+	    }
+
 	    /* Returns equivalence of branchings: */
 
 	    virtual bool equiv(const ps_branching<model_t,N_in,N_out,rng_t>* other) const
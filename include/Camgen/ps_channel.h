@@ -96,7 +96,7 @@ namespace Camgen
 
 	    /* Momentum-allocating constructor. */
 
-	    momentum_channel(bit_string_type bitstring_):bitstring(bitstring_),momentum(new momentum_type),alloc_momentum(true),invariant_mass(0),status(reset)
+	    momentum_channel(bit_string_type bitstring_):bitstring(bitstring_),momentum(new momentum_type),alloc_momentum(true),invariant_mass(0),status(reset),evaluation(1)
 	    {
 		if(timelike())
 		{
@@ -113,7 +113,7 @@ namespace Camgen
 
 	    /* Momentum reference-copying constructor. */
 
-	    momentum_channel(bit_string_type bitstring_,momentum_type* momentum_):bitstring(bitstring_),momentum(momentum_),alloc_momentum(false),invariant_mass(0),status(reset)
+	    momentum_channel(bit_string_type bitstring_,momentum_type* momentum_):bitstring(bitstring_),momentum(momentum_),alloc_momentum(false),invariant_mass(0),status(reset),evaluation(1)
 	    {
 		if(timelike())
 		{
@@ -515,6 +515,15 @@ namespace Camgen
 	    void reset_status()
 	    {
 		status=reset;
+		++evaluation;
+	    }
+
+	    /* Marks the start of a new event evaluation, invalidating the
+	     * densities memoised in the particle channels: */
+
+	    void new_evaluation()
+	    {
+		++evaluation;
 	    }
 
 
@@ -696,6 +705,13 @@ namespace Camgen
 		return status;
 	    }
 
+	    /* Returns the event evaluation counter: */
+
+	    size_type evaluation_count() const
+	    {
+		return evaluation;
+	    }
+
 	    /* Printing method. */
 	    
 	    std::ostream& print(std::ostream& os) const
@@ -768,6 +784,10 @@ namespace Camgen
 
 	    status_type status;
 
+	    /* Event evaluation counter: */
+
+	    size_type evaluation;
+
 	    /* Private modifiers: */
 	    /*--------------------*/
 
@@ -294,6 +294,24 @@ namespace Camgen
 		is->adapt_grids();
 	    }
 
+	    /// Sets the number of worker threads accumulating updates of the
+	    /// weight sums and initial state grids.
+
+	    virtual void set_update_workers(size_type n)
+	    {
+		this->base_type::set_update_workers(n);
+		is->set_update_workers(n);
+	    }
+
+	    /// Merges the worker shadows of the weight sums and initial state
+	    /// grids.
+
+	    virtual void merge_shadows()
+	    {
+		this->base_type::merge_shadows();
+		is->merge_shadows();
+	    }
+
 	    /// Multichannel weight adaptation method.
 
 	    virtual void adapt_channels()
@@ -309,6 +327,23 @@ namespace Camgen
 		adapt_channels();
 	    }
 
+	    /// Writes the weight sums and the initial state grids to the binary
+	    /// output stream.
+
+	    virtual void save_state(std::ostream& os) const
+	    {
+		this->base_type::save_state(os);
+		is->save_state(os);
+	    }
+
+	    /// Reads the weight sums and the initial state grids from the binary
+	    /// input stream.
+
+	    virtual bool load_state(std::istream& is_)
+	    {
+		return (this->base_type::load_state(is_) and is->load_state(is_));
+	    }
+
 	    /// Replaces current multichannel weights by there optimal values,
 	    /// collected over several adaptations.
 
@@ -69,7 +69,7 @@ namespace Camgen
 
             const event_type* fill()
             {
-                evt_queue.fill_event(gen->get_event());
+                evt_queue.push(gen->get_event());
                 return evt_queue.back();
             }
 
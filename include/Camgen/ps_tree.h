@@ -303,6 +303,12 @@ namespace Camgen
 	    typedef typename base_type::branching_factory_type branching_factory_type;
 	    typedef typename base_type::bit_string_type bit_string_type;
 
+	    /* Final t-branchings and their replacements, in the order of the
+	     * branching list, so that the resulting channel layout does not
+	     * depend on allocation addresses: */
+
+	    typedef std::vector< std::pair<branching_type*,branching_container> > branching_clone_container;
+
 	    /* Static utility functions: */
 
 	    static const particle<model_t>* get_anti_particle(const bit_string_type b,const particle<model_t>* phi)
@@ -626,7 +632,7 @@ namespace Camgen
 	    void replace_obsolete_sum_branchings()
 	    {
 		branching_container obsolete_sum_branchings;
-		std::map<branching_type*,branching_container> t_branching_clones;
+		branching_clone_container t_branching_clones;
 
 		for(typename branching_container::iterator it=this->ps_branchings.begin();it!=this->ps_branchings.end();++it)
 		{
@@ -640,7 +646,7 @@ namespace Camgen
 		    this->try_remove_branching_and_delete(*it);
 		}
 
-		for(typename std::map<branching_type*,branching_container>::iterator it=t_branching_clones.begin();it!=t_branching_clones.end();++it)
+		for(typename branching_clone_container::iterator it=t_branching_clones.begin();it!=t_branching_clones.end();++it)
 		{
 		    bool replacing=true;
 		    for(typename branching_container::iterator it2=it->second.begin();it2!=it->second.end();++it2)
@@ -665,7 +671,7 @@ namespace Camgen
 		}
 	    }
 
-	    std::map<branching_type*,branching_container>& create_final_t_channels(std::map<branching_type*,branching_container>& mapping, particle_channel_type* t_channel,particle_channel_type* s2_channel)
+	    branching_clone_container& create_final_t_channels(branching_clone_container& mapping, particle_channel_type* t_channel,particle_channel_type* s2_channel)
 	    {
 		for(typename branching_container::iterator it=this->ps_branchings.begin();it!=this->ps_branchings.end();++it)
 		{
@@ -680,7 +686,19 @@ namespace Camgen
 		    }
 		    branchings.push_back(t_branching_->copy_to_final_branching(s2_channel));
 
-		    mapping[t_branching_]=branchings;
+		    typename branching_clone_container::iterator it2=mapping.begin();
+		    while(it2!=mapping.end() and it2->first!=t_branching_)
+		    {
+			++it2;
+		    }
+		    if(it2==mapping.end())
+		    {
+			mapping.push_back(std::make_pair(static_cast<branching_type*>(t_branching_),branchings));
+		    }
+		    else
+		    {
+			it2->second=branchings;
+		    }
 		}
 		return mapping;
 	    }
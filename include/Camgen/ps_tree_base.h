@@ -165,12 +165,15 @@ namespace Camgen
 		return !this->is_generator()->s_hat_sampling;
 	    }
 
-	    /// Weight evaluation method.
+	    /// Weight evaluation method. Starts a new evaluation in all momentum
+	    /// channels, so the invariant mass densities memoised by the particle
+	    /// channels are recomputed once and shared by all branchings.
 
 	    bool evaluate_fs_weight()
 	    {
 		for(typename momentum_channel_container::iterator it=momentum_channels.begin();it!=momentum_channels.end();++it)
 		{
+		    (*it)->new_evaluation();
 		    if((*it)->get_status()==momentum_channel_type::p_set) continue;
 
 		    (*it)->p()=p_internal((*it)->bitstring);
@@ -236,6 +239,33 @@ namespace Camgen
 		}
 	    }
 	    
+	    /// Sets the number of worker threads accumulating updates of the
+	    /// weight sums, grids and multichannels.
+
+	    void set_update_workers(size_type n)
+	    {
+		this->base_type::set_update_workers(n);
+		particle_channel_set_update_workers set_callback(n);
+		apply_to_particle_channels(set_callback);
+		for(typename branching_container::iterator it=ps_branchings.begin();it!=ps_branchings.end();++it)
+		{
+		    static_cast<MC_integrator_base<value_type>*>(*it)->set_update_workers(n);
+		}
+	    }
+
+	    /// Merges the worker shadows of the weight sums, grids and
+	    /// multichannels.
+
+	    void merge_shadows()
+	    {
+		this->base_type::merge_shadows();
+		apply_to_particle_channels(particle_channel_merge_shadows);
+		for(typename branching_container::iterator it=ps_branchings.begin();it!=ps_branchings.end();++it)
+		{
+		    static_cast<MC_integrator_base<value_type>*>(*it)->merge_shadows();
+		}
+	    }
+
 	    /// Overrides the multichannel adaptation method.
 
 	    void adapt_channels()
@@ -274,6 +304,41 @@ namespace Camgen
 		}
 	    }
 
+	    /// Writes the weight sums, the initial state grids and the grids and
+	    /// multichannel weights of all particle channels to the binary
+	    /// output stream.
+
+	    void save_state(std::ostream& os) const
+	    {
+		this->base_type::save_state(os);
+		particle_channel_save save_callback(os);
+		apply_to_particle_channels(save_callback);
+	    }
+
+	    /// Reads the state written by save_state from the binary input
+	    /// stream. Branchings which were thrown out by the adaptation of the
+	    /// saved generator are removed.
+
+	    bool load_state(std::istream& is)
+	    {
+		if(!this->base_type::load_state(is))
+		{
+		    return false;
+		}
+		particle_channel_load load_callback(is);
+		apply_to_particle_channels(load_callback);
+		branching_container remaining;
+		for(typename branching_container::iterator it=ps_branchings.begin();it!=ps_branchings.end();++it)
+		{
+		    if((*it)->incoming_channel->contains_branching(*it))
+		    {
+			remaining.push_back(*it);
+		    }
+		}
+		ps_branchings.swap(remaining);
+		return load_callback.result;
+	    }
+
 	    /// Refreshes the minimal invariant masses.
 
 	    bool refresh_m_min()
@@ -781,6 +846,27 @@ namespace Camgen
 		}
 	    }
 
+	    /* Utility method, applies the functional to all particle channels: */
+
+	    template<class T>void apply_to_particle_channels(T& func) const
+	    {
+		for(size_type i=0;i<N_in;++i)
+		{
+		    func(incoming_particle_channels[i]);
+		}
+		for(typename momentum_channel_container::const_iterator it=momentum_channels.begin();it!=momentum_channels.end();++it)
+		{
+		    for(typename momentum_channel_type::const_particle_channel_iterator p_it=(*it)->begin_particle_channels();p_it!=(*it)->end_particle_channels();++p_it)
+		    {
+			func(*p_it);
+		    }
+		}
+		for(size_type i=0;i<N_out;++i)
+		{
+		    func(outgoing_particle_channels[i]);
+		}
+	    }
+
 	    /* Protected data members */
 	    /*----------------------*/
 
@@ -923,6 +1009,13 @@ namespace Camgen
 		p->adapt_channels();
 	    }
 
+	    /* Callback for merging the worker shadows: */
+
+	    static void particle_channel_merge_shadows(particle_channel_type* p)
+	    {
+		p->merge_shadows();
+	    }
+
 	    /* Callback for reset: */
 
 	    static void particle_channel_reset(particle_channel_type* p)
@@ -962,6 +1055,58 @@ namespace Camgen
 		    }
 	    };
 
+	    /* Functor for setting the number of update workers: */
+
+	    class particle_channel_set_update_workers
+	    {
+		public:
+
+		    size_type n;
+
+		    particle_channel_set_update_workers(size_type n_):n(n_){}
+
+		    void operator()(particle_channel_type* p)
+		    {
+			p->set_update_workers(n);
+		    }
+	    };
+
+	    /* Functor for writing the particle channel states: */
+
+	    class particle_channel_save
+	    {
+		public:
+
+		    std::ostream& os;
+
+		    particle_channel_save(std::ostream& os_):os(os_){}
+
+		    void operator()(const particle_channel_type* p)
+		    {
+			binary_io::write_string(os,p->name);
+			p->save_state(os);
+		    }
+	    };
+
+	    /* Functor for reading the particle channel states: */
+
+	    class particle_channel_load
+	    {
+		public:
+
+		    std::istream& is;
+
+		    bool result;
+
+		    particle_channel_load(std::istream& is_):is(is_),result(true){}
+
+		    void operator()(particle_channel_type* p)
+		    {
+			std::string s;
+			result=(result and binary_io::read_string(is,s) and s==p->name and p->load_state(is));
+		    }
+	    };
+
 	    /* Functor for cleaning branchings: */
 
 	    class particle_channel_clean_branchings
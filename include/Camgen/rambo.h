@@ -97,12 +97,14 @@ namespace Camgen
 
 		momentum_type k;
 		k.assign((value_type)0);
+		value_type r[N_out*(D-2)];
+		rn_stream::fill(r,N_out*(D-2));
 		for(size_type i=0;i<N_out;++i)
 		{
-		    value_type rho=rn_stream::throw_number();
-		    for(size_type n=0;n<D-3;++n)
+		    value_type rho=r[i*(D-2)];
+		    for(size_type n=1;n<D-2;++n)
 		    {
-			rho*=rn_stream::throw_number();
+			rho*=r[i*(D-2)+n];
 		    }
 		    phat=-std::log(rho);
 		    (this->p_out(i))[0]=phat;
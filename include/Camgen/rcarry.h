@@ -14,7 +14,9 @@
 
 namespace Camgen
 {
-    /// RCARRY random number stream, based on a 24-integer registry.
+    /// RCARRY random number stream, based on a 24-integer registry. Every
+    /// instance starts from the seed register and the generator has no
+    /// jump-ahead, so it provides no independent substreams.
 
     class rcarry
     {
@@ -14,6 +14,9 @@
 
 #include <iostream>
 #include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <Camgen/debug.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Wrapper class for random number generators. The first template parameter      *
@@ -21,12 +24,53 @@
  * template parameter denotes the random number generator class used. This class *
  * should contain the const static data members min_value and max_value,         *
  * denoting the minimum and maximum integers thrown and the operator (void) for  *
- * a throw.                                                                      *
+ * a throw. The engine and the call counter are thread-local, and every thread  *
+ * can install its own engine instance, e.g. an independent substream of a      *
+ * counter-based generator, to obtain reproducible parallel random numbers.      *
+ * A thread without an installed engine default-constructs one, which is        *
+ * deleted when the thread exits. Default-constructed engines of different      *
+ * threads start from the same seed, and the std::random wrapper draws from the *
+ * global rand() state, so only engines with substreams (see rn_substream) give *
+ * independent and thread-safe streams.                                         *
  *                                                                               *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 namespace Camgen
 {
+    /// Draws n integers from the engine into the argument array. Engines
+    /// providing a faster bulk generation overload this function.
+
+    template<class rng_t>void fill_integers(rng_t& rng,typename rng_t::result_type* r,std::size_t n)
+    {
+	for(std::size_t i=0;i<n;++i)
+	{
+	    r[i]=rng();
+	}
+    }
+
+    /// Factory of independent substreams of the engine rng_t, selected by an
+    /// index. Engines supporting substreams specialise this class; by
+    /// default no substream engines are available.
+
+    template<class rng_t>class rn_substream
+    {
+	public:
+
+	    /// Whether rng_t provides independent substreams.
+
+	    static const bool value=false;
+
+	    /// Returns a new engine for the substream with index n, or NULL if
+	    /// substreams are not supported.
+
+	    static rng_t* create(std::size_t n)
+	    {
+		return NULL;
+	    }
+    };
+
+    template<class rng_t>const bool rn_substream<rng_t>::value;
+
     /// Random number generator wrapper. Converts an integer random number
     /// generator rng_t to a stream of numerical type value_t.
 
@@ -61,12 +105,17 @@ namespace Camgen
 	    /// Range of values thrown by rng_t, as a value_type.
 	    
 	    static const value_type range;
+
+	    /// Number of integers drawn from the engine at once in the bulk
+	    /// fill methods.
+
+	    static const std::size_t block_size=64;
 	    
 	    /// Returns the number of calls to rng.
 
 	    static std::size_t number_of_throws()
 	    {
-		return counter;
+		return state.counter;
 	    }
 
 	    /// Returns a random integer between min- and max.
@@ -74,8 +123,8 @@ namespace Camgen
 	    static int_type throw_integer()
 	    {
 		init();
-		++counter;
-		return (*rng)();
+		++state.counter;
+		return (*state.rng)();
 	    }
 
 	    /// Returns randomly 0 or 1.
@@ -83,8 +132,8 @@ namespace Camgen
 	    static int_type throw_coin()
 	    {
 		init();
-		++counter;
-		return ((*rng)()%2);
+		++state.counter;
+		return ((*state.rng)()%2);
 	    }
 
 	    /// Returns a random integer from 0 to max.
@@ -92,14 +141,14 @@ namespace Camgen
 	    static int_type throw_dice(int_type max)
 	    {
 		init();
-		++counter;
+		++state.counter;
 		if(max>0)
 		{
-		    return (*rng)()%max;
+		    return (*state.rng)()%max;
 		}
 		else
 		{
-		    return -((*rng)()%(-max));
+		    return -((*state.rng)()%(-max));
 		}
 	    }
 
@@ -108,8 +157,8 @@ namespace Camgen
 	    static int_type throw_dice(int_type min,int_type max)
 	    {
 		init();
-		++counter;
-                return (*rng)()%std::abs(max-min)+std::min(min,max);
+		++state.counter;
+                return (*state.rng)()%std::abs(max-min)+std::min(min,max);
 	    }
 
 	    /// Returns a random floating-point number between 0 and 1.
@@ -117,8 +166,8 @@ namespace Camgen
 	    static value_type throw_number()
 	    {
 		init();
-		++counter;
-		return (value_type)((*rng)()-min_value)/range;
+		++state.counter;
+		return (value_type)((*state.rng)()-min_value)/range;
 	    }
 
 	    /// Returns a random floating-point number between 0 and the argument.
@@ -126,8 +175,8 @@ namespace Camgen
 	    static value_type throw_number(const value_type& max)
 	    {
 		init();
-		++counter;
-		return (value_type)((*rng)()-min_value)*max/range;
+		++state.counter;
+		return (value_type)((*state.rng)()-min_value)*max/range;
 	    }
 	    
 	    /// Returns a random floating-point number between min and max.
@@ -135,17 +184,115 @@ namespace Camgen
 	    static value_type throw_number(const value_type& min,const value_type& max)
 	    {
 		init();
-		++counter;
-		return (value_type)((*rng)()-min_value)*std::abs(max-min)/range+std::min(min,max);
+		++state.counter;
+		return (value_type)((*state.rng)()-min_value)*std::abs(max-min)/range+std::min(min,max);
+	    }
+
+	    /// Fills the argument array with n random floating-point numbers
+	    /// between 0 and 1. The numbers are converted with the same
+	    /// expression as in throw_number, so they are bitwise equal to n
+	    /// subsequent throws.
+
+	    static void fill(value_type* x,std::size_t n)
+	    {
+		init();
+		state.counter+=n;
+		int_type r[block_size];
+		for(std::size_t i=0;i<n;i+=block_size)
+		{
+		    std::size_t m=std::min(n-i,(std::size_t)block_size);
+		    fill_integers(*state.rng,r,m);
+		    for(std::size_t j=0;j<m;++j)
+		    {
+			x[i+j]=(value_type)(r[j]-min_value)/range;
+		    }
+		}
+	    }
+
+	    /// Fills the argument array with n random floating-point numbers
+	    /// between min and max, bitwise equal to n subsequent throws.
+
+	    static void fill(value_type* x,std::size_t n,const value_type& min,const value_type& max)
+	    {
+		init();
+		state.counter+=n;
+		value_type a=std::min(min,max);
+		value_type w=std::abs(max-min);
+		int_type r[block_size];
+		for(std::size_t i=0;i<n;i+=block_size)
+		{
+		    std::size_t m=std::min(n-i,(std::size_t)block_size);
+		    fill_integers(*state.rng,r,m);
+		    for(std::size_t j=0;j<m;++j)
+		    {
+			x[i+j]=(value_type)(r[j]-min_value)*w/range+a;
+		    }
+		}
 	    }
 
 	    /// Resets the engine.
 
 	    static void reset_engine()
 	    {
-		delete rng;
-		rng=new rn_engine;
-		counter=0;
+		state.install(new rn_engine,true);
+	    }
+
+	    /// Installs the argument engine for the random numbers thrown by
+	    /// the calling thread and resets the call counter. The engine is
+	    /// not owned by the stream and should outlive its use. Returns the
+	    /// previously installed engine, or NULL if the default engine was
+	    /// used, which is destroyed. Passing NULL reverts the thread to a
+	    /// default-constructed engine.
+
+	    static rn_engine* set_engine(rn_engine* e)
+	    {
+		return state.install(e,false);
+	    }
+
+	    /// Engine installation of a thread, saved by swap_engine.
+
+	    class saved_engine
+	    {
+		friend class random_number_stream<value_t,rng_t>;
+
+		rn_engine* rng;
+		bool owned;
+		std::size_t counter;
+	    };
+
+	    /// Installs the argument engine for the random numbers thrown by
+	    /// the calling thread, like set_engine, but keeps the previous
+	    /// engine and call counter alive, including a default engine owned
+	    /// by the stream. The returned state should be reinstalled by
+	    /// restore_engine.
+
+	    static saved_engine swap_engine(rn_engine* e)
+	    {
+		saved_engine result;
+		result.rng=state.rng;
+		result.owned=state.owned;
+		result.counter=state.counter;
+		state.rng=e;
+		state.owned=false;
+		state.counter=0;
+		return result;
+	    }
+
+	    /// Reinstalls the engine state saved by swap_engine, destroying the
+	    /// current engine if it is owned by the stream.
+
+	    static void restore_engine(const saved_engine& s)
+	    {
+		state.install(s.rng,s.owned);
+		state.counter=s.counter;
+	    }
+
+	    /// Returns the engine used by the calling thread.
+
+	    static rn_engine* get_engine()
+	    {
+		init();
+		return state.rng;
 	    }
 
 	    value_type operator()(const value_type& min,const value_type& max) const
@@ -167,27 +314,78 @@ namespace Camgen
 
 	    static void init()
 	    {
-		if(rng==NULL)
+		if(state.rng==NULL)
 		{
-		    rng=new rn_engine;
+		    state.install(new rn_engine,true);
 		}
 	    }
 
-	    /* Static random number generator instance: */
+	    /* Engine state of a thread, destroying the engine it allocated
+	     * when the thread exits: */
 
-	    static rn_engine* rng;
-	    
-	    /* Call counter: */
-	    
-	    static std::size_t counter;
+	    class engine_state
+	    {
+		public:
+
+		    /* Random number generator instance: */
+
+		    rn_engine* rng;
+
+		    /* Flag denoting whether the engine was allocated by the
+		     * stream: */
+
+		    bool owned;
+
+		    /* Call counter: */
+
+		    std::size_t counter;
+
+		    /* Constructor: */
+
+		    engine_state():rng(NULL),owned(false),counter(0){}
+
+		    /* Destructor: */
+
+		    ~engine_state()
+		    {
+			if(owned)
+			{
+			    delete rng;
+			}
+		    }
+
+		    /* Replaces the engine and resets the counter. Returns the
+		     * previous engine if it was not owned, NULL otherwise: */
+
+		    rn_engine* install(rn_engine* e,bool own)
+		    {
+			rn_engine* result=NULL;
+			if(owned)
+			{
+			    delete rng;
+			}
+			else
+			{
+			    result=rng;
+			}
+			rng=e;
+			owned=own;
+			counter=0;
+			return result;
+		    }
+	    };
+
+	    /* Engine state of the calling thread: */
+
+	    static CAMGEN_THREAD_LOCAL engine_state state;
     };
 
     template<class value_t,class rng_t>const typename random_number_stream<value_t,rng_t>::int_type random_number_stream<value_t,rng_t>::min_value;
     template<class value_t,class rng_t>const typename random_number_stream<value_t,rng_t>::int_type random_number_stream<value_t,rng_t>::max_value;
     template<class value_t,class rng_t>const typename random_number_stream<value_t,rng_t>::int_type random_number_stream<value_t,rng_t>::range_value;
-    template<class value_t,class rng_t>typename random_number_stream<value_t,rng_t>::rn_engine* random_number_stream<value_t,rng_t>::rng=NULL;
+    template<class value_t,class rng_t>CAMGEN_THREAD_LOCAL typename random_number_stream<value_t,rng_t>::engine_state random_number_stream<value_t,rng_t>::state;
     template<class value_t,class rng_t>const typename random_number_stream<value_t,rng_t>::value_type random_number_stream<value_t,rng_t>::range=random_number_stream<value_t,rng_t>::range_value;
-    template<class value_t,class rng_t>std::size_t random_number_stream<value_t,rng_t>::counter=0;
+    template<class value_t,class rng_t>const std::size_t random_number_stream<value_t,rng_t>::block_size;
 }
 
 #endif /*CAMGEN_RN_STRM_H_*/
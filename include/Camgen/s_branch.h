@@ -474,6 +474,50 @@ namespace Camgen
 		}
 	    }
 
+	    /* Sets the number of worker threads updating the polar angle grid: */
+
+	    void set_update_workers(size_type n)
+	    {
+		if(theta_grid!=NULL)
+		{
+		    theta_grid->set_update_workers(n);
+		}
+	    }
+
+	    /* Merges the worker shadows into the polar angle grid: */
+
+	    void merge_shadows()
+	    {
+		if(theta_grid!=NULL)
+		{
+		    theta_grid->merge_shadows();
+		}
+	    }
+
+	    /* Writes the polar angle grid to the binary output stream: */
+
+	    void save_state(std::ostream& os) const
+	    {
+		bool q=(theta_grid!=NULL);
+		binary_io::write(os,q);
+		if(q)
+		{
+		    theta_grid->save_state(os);
+		}
+	    }
+
+	    /* Reads the polar angle grid from the binary input stream: */
+
+	    bool load_state(std::istream& is)
+	    {
+		bool q;
+		if(!binary_io::read(is,q) or q!=(theta_grid!=NULL))
+		{
+		    return false;
+		}
+		return (theta_grid==NULL or theta_grid->load_state(is));
+	    }
+
 	    /* Returns whether the branchings are equivalent: */
 
 	    bool equiv(const ps_branching<model_t,N_in,N_out,rng_t>* other) const
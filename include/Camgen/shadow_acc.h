@@ -0,0 +1,131 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file shadow_acc.h
+    \brief Per-thread shadow accumulators for adaptive generators.
+ */
+
+#ifndef CAMGEN_SHADOW_ACC_H_
+#define CAMGEN_SHADOW_ACC_H_
+
+#include <cstddef>
+#include <vector>
+#include <Camgen/debug.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Support for the reduce-style update path of the adaptive generators. Every   *
+ * worker thread selects an index with update_worker::set_index, and the        *
+ * accumulate() methods of the grids, multichannels and integrators then add    *
+ * to the worker's private shadow of the statistics instead of the shared data. *
+ * The owning thread merges the shadows in worker order when adapting, so the   *
+ * result does not depend on the scheduling of the threads.                     *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+namespace Camgen
+{
+    /// Thread-local worker index selecting the shadow accumulators updated by
+    /// the calling thread. Index 0, the default, denotes the thread owning the
+    /// generators, which updates them in place.
+
+    class update_worker
+    {
+	public:
+
+	    /// Returns the worker index of the calling thread.
+
+	    static std::size_t index()
+	    {
+		return slot();
+	    }
+
+	    /// Sets the worker index of the calling thread. Workers should use
+	    /// distinct indices from 1 up to the number of workers set in the
+	    /// generators.
+
+	    static void set_index(std::size_t i)
+	    {
+		slot()=i;
+	    }
+
+	private:
+
+	    /* Storage of the index: */
+
+	    static std::size_t& slot()
+	    {
+		static CAMGEN_THREAD_LOCAL std::size_t i=0;
+		return i;
+	    }
+    };
+
+    /// Per-worker shadow copies of the accumulator type T. The owner of the
+    /// shadows merges them into its own statistics.
+
+    template<class T>class shadow_accumulator
+    {
+	public:
+
+	    typedef std::size_t size_type;
+
+	    /// Creates a shadow for each of the n workers, copied from the second
+	    /// argument.
+
+	    void resize(size_type n,const T& acc=T())
+	    {
+		slots.assign(n,slot(acc));
+	    }
+
+	    /// Returns the number of workers.
+
+	    size_type size() const
+	    {
+		return slots.size();
+	    }
+
+	    /// Returns the shadow of the calling thread, or NULL if it updates
+	    /// in place.
+
+	    T* local()
+	    {
+		size_type i=update_worker::index();
+		return (i==0 or i>slots.size())?NULL:&(slots[i-1].acc);
+	    }
+
+	    /// Returns the shadow of the i-th worker (no bound-checking).
+
+	    T& operator [] (size_type i)
+	    {
+		return slots[i].acc;
+	    }
+
+	    /// Returns the shadow of the i-th worker (no bound-checking).
+
+	    const T& operator [] (size_type i) const
+	    {
+		return slots[i].acc;
+	    }
+
+	private:
+
+	    /* Shadow storage, padded to keep the shadows of different workers on
+	     * different cache lines: */
+
+	    struct slot
+	    {
+		T acc;
+		char pad[64];
+
+		slot(const T& acc_):acc(acc_){}
+	    };
+
+	    std::vector<slot> slots;
+    };
+}
+
+#endif /*CAMGEN_SHADOW_ACC_H_*/
+
@@ -0,0 +1,307 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#ifndef CAMGEN_SIMD_SPINOR_H_
+#define CAMGEN_SIMD_SPINOR_H_
+
+#include <complex>
+#include <Camgen/debug.h>
+#include <Camgen/c_utils.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Declaration and definition of the spinor_simd class template, providing the   *
+ * fermion-vector vertex recursion relations in the Weyl basis with separate     *
+ * left- and right-handed couplings L and R, on four contiguous complex          *
+ * components per spinor or vector. The generic version is the scalar complex   *
+ * arithmetic of the Weyl basis relations. The specialisation for double        *
+ * precision complex numbers keeps two interleaved complex components per AVX   *
+ * register, loads the operands directly into the lanes and forms the          *
+ * permuted and i-rotated combinations with in-register shuffles. The           *
+ * vectorised code is only compiled if CAMGEN_USE_SIMD is defined and the       *
+ * compiler targets AVX (for instance by configuring with --enable-simd). The   *
+ * second template parameter selects the scalar version for any type, which    *
+ * the simd_spinor test uses as reference and benchmark.                         *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#if defined(CAMGEN_USE_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define CAMGEN_SIMD_AVX
+#endif
+
+namespace Camgen
+{
+    /* Returns the address of the four components at the tensor iterator,
+     * which the kernels require to be stored contiguously: */
+
+    template<class iterator_t>typename iterator_t::pointer spinor_components(iterator_t it)
+    {
+	CAMGEN_ERROR_IF((&it[3]-&it[0]!=3),"spinor components are not stored contiguously");
+	return &it[0];
+    }
+
+    /* Generic scalar implementation: */
+
+    template<class value_t,bool vectorise=true>class spinor_simd
+    {
+	public:
+
+	    /* Flag denoting whether the kernels are vectorised: */
+
+	    static const bool vectorised=false;
+
+	    /* Vector current V(mu) += bar{a}.g(mu).(L*PL+R*PR).b, with PL and PR
+	     * the chiral projectors: */
+
+	    static void VA_first(const value_t& L,const value_t& R,const value_t* a,const value_t* b,value_t* V)
+	    {
+		V[0]+=(L*(a[0]*b[2]+a[1]*b[3])+R*(a[2]*b[0]+a[3]*b[1]));
+		V[1]+=(L*(a[1]*b[2]+a[0]*b[3])-R*(a[2]*b[1]+a[3]*b[0]));
+		V[2]+=times_i(L*(a[1]*b[2]-a[0]*b[3])+R*(a[2]*b[1]-a[3]*b[0]));
+		V[3]+=(L*(a[0]*b[2]-a[1]*b[3])+R*(-a[2]*b[0]+a[3]*b[1]));
+	    }
+
+	    /* Left-handed vector current V(mu) += L*bar{a}.g(mu).PL.b: */
+
+	    static void L_first(const value_t& L,const value_t* a,const value_t* b,value_t* V)
+	    {
+		V[0]+=L*(a[0]*b[2]+a[1]*b[3]);
+		V[1]+=L*(a[0]*b[3]+a[1]*b[2]);
+		V[2]+=L*times_i(a[1]*b[2]-a[0]*b[3]);
+		V[3]+=L*(a[0]*b[2]-a[1]*b[3]);
+	    }
+
+	    /* Right-handed vector current V(mu) += R*bar{a}.g(mu).PR.b: */
+
+	    static void R_first(const value_t& R,const value_t* a,const value_t* b,value_t* V)
+	    {
+		V[0]+=R*(a[3]*b[1]+a[2]*b[0]);
+		V[1]-=R*(a[2]*b[1]+a[3]*b[0]);
+		V[2]+=R*times_i(a[2]*b[1]-a[3]*b[0]);
+		V[3]+=R*(a[3]*b[1]-a[2]*b[0]);
+	    }
+
+	    /* Spinor psi += Vslash.(L*PL+R*PR).b: */
+
+	    static void VA_second(const value_t& L,const value_t& R,const value_t* V,const value_t* b,value_t* psi)
+	    {
+		value_t Qp=V[1]+times_i(V[2]);
+		value_t Qm=V[1]-times_i(V[2]);
+		psi[0]+=L*((V[0]-V[3])*b[2]-Qm*b[3]);
+		psi[1]+=L*(-Qp*b[2]+(V[0]+V[3])*b[3]);
+		psi[2]+=R*((V[0]+V[3])*b[0]+Qm*b[1]);
+		psi[3]+=R*(Qp*b[0]+(V[0]-V[3])*b[1]);
+	    }
+
+	    /* Conjugate spinor bar{psi} += bar{a}.Vslash.(L*PL+R*PR): */
+
+	    static void VA_third(const value_t& L,const value_t& R,const value_t* V,const value_t* a,value_t* psi)
+	    {
+		value_t Qp=V[1]+times_i(V[2]);
+		value_t Qm=V[1]-times_i(V[2]);
+		psi[0]+=R*((V[0]+V[3])*a[2]+Qp*a[3]);
+		psi[1]+=R*(Qm*a[2]+(V[0]-V[3])*a[3]);
+		psi[2]+=L*((V[0]-V[3])*a[0]-Qp*a[1]);
+		psi[3]+=L*(-Qm*a[0]+(V[0]+V[3])*a[1]);
+	    }
+    };
+    template<class value_t,bool vectorise>const bool spinor_simd<value_t,vectorise>::vectorised;
+
+#ifdef CAMGEN_SIMD_AVX
+
+    /* AVX implementation for double-precision complex numbers. A register
+     * holds the components (0,1) or (2,3) of a spinor or vector, as
+     * interleaved real and imaginary parts: */
+
+    template<>class spinor_simd<std::complex<double>,true>
+    {
+	public:
+
+	    typedef std::complex<double> value_type;
+
+	    /* Flag denoting whether the kernels are vectorised: */
+
+	    static const bool vectorised=true;
+
+	    /* Vector current V(mu) += bar{a}.g(mu).(L*PL+R*PR).b: */
+
+	    static void VA_first(const value_type& L,const value_type& R,const value_type* a,const value_type* b,value_type* V)
+	    {
+		__m256d Ll,Lh,Rl,Rh;
+		left_first(a,b,Ll,Lh);
+		right_first(a,b,Rl,Rh);
+		__m256d l=broadcast(&L);
+		__m256d r=broadcast(&R);
+		add(V,_mm256_add_pd(mul(l,Ll),mul(r,Rl)));
+		add(V+2,times_i_lo(_mm256_add_pd(mul(l,Lh),mul(r,Rh))));
+	    }
+
+	    /* Left-handed vector current V(mu) += L*bar{a}.g(mu).PL.b: */
+
+	    static void L_first(const value_type& L,const value_type* a,const value_type* b,value_type* V)
+	    {
+		__m256d Ll,Lh;
+		left_first(a,b,Ll,Lh);
+		__m256d l=broadcast(&L);
+		add(V,mul(l,Ll));
+		add(V+2,times_i_lo(mul(l,Lh)));
+	    }
+
+	    /* Right-handed vector current V(mu) += R*bar{a}.g(mu).PR.b: */
+
+	    static void R_first(const value_type& R,const value_type* a,const value_type* b,value_type* V)
+	    {
+		__m256d Rl,Rh;
+		right_first(a,b,Rl,Rh);
+		__m256d r=broadcast(&R);
+		add(V,mul(r,Rl));
+		add(V+2,times_i_lo(mul(r,Rh)));
+	    }
+
+	    /* Spinor psi += Vslash.(L*PL+R*PR).b: */
+
+	    static void VA_second(const value_type& L,const value_type& R,const value_type* V,const value_type* b,value_type* psi)
+	    {
+		__m256d S,D;
+		slash(V,S,D);
+		__m256d Sw=swap(S);
+		__m256d Dw=swap(D);
+		__m256d lo=_mm256_add_pd(mul(blend(D,negate(S)),broadcast(b+2)),mul(blend(negate(Dw),Sw),broadcast(b+3)));
+		__m256d hi=_mm256_add_pd(mul(S,broadcast(b)),mul(Dw,broadcast(b+1)));
+		add(psi,mul(broadcast(&L),lo));
+		add(psi+2,mul(broadcast(&R),hi));
+	    }
+
+	    /* Conjugate spinor bar{psi} += bar{a}.Vslash.(L*PL+R*PR): */
+
+	    static void VA_third(const value_type& L,const value_type& R,const value_type* V,const value_type* a,value_type* psi)
+	    {
+		__m256d S,D;
+		slash(V,S,D);
+		__m256d Sw=swap(S);
+		__m256d Dw=swap(D);
+		__m256d lo=_mm256_add_pd(mul(blend(S,D),broadcast(a+2)),mul(blend(Sw,Dw),broadcast(a+3)));
+		__m256d hi=_mm256_add_pd(mul(blend(D,negate(D)),broadcast(a)),mul(blend(negate(Sw),Sw),broadcast(a+1)));
+		add(psi,mul(broadcast(&R),lo));
+		add(psi+2,mul(broadcast(&L),hi));
+	    }
+
+	private:
+
+	    /* Loads two complex numbers: */
+
+	    static __m256d load(const value_type* a)
+	    {
+		return _mm256_loadu_pd(reinterpret_cast<const double*>(a));
+	    }
+
+	    /* Loads one complex number into both lanes: */
+
+	    static __m256d broadcast(const value_type* a)
+	    {
+		return _mm256_broadcast_pd(reinterpret_cast<const __m128d*>(a));
+	    }
+
+	    /* Adds x to the two complex numbers at A: */
+
+	    static void add(value_type* A,const __m256d& x)
+	    {
+		double* d=reinterpret_cast<double*>(A);
+		_mm256_storeu_pd(d,_mm256_add_pd(_mm256_loadu_pd(d),x));
+	    }
+
+	    /* Lane-wise complex product: */
+
+	    static __m256d mul(const __m256d& a,const __m256d& b)
+	    {
+		__m256d br=_mm256_movedup_pd(b);
+		__m256d bi=_mm256_permute_pd(b,0xF);
+		return _mm256_addsub_pd(_mm256_mul_pd(a,br),_mm256_mul_pd(_mm256_permute_pd(a,0x5),bi));
+	    }
+
+	    /* Exchanges the two lanes: */
+
+	    static __m256d swap(const __m256d& a)
+	    {
+		return _mm256_permute2f128_pd(a,a,0x01);
+	    }
+
+	    /* Lane 0 of a and lane 1 of b: */
+
+	    static __m256d blend(const __m256d& a,const __m256d& b)
+	    {
+		return _mm256_blend_pd(a,b,0xC);
+	    }
+
+	    /* Negation: */
+
+	    static __m256d negate(const __m256d& a)
+	    {
+		return _mm256_xor_pd(a,_mm256_set1_pd(-0.0));
+	    }
+
+	    /* Multiplies lane 0 by the imaginary unit: */
+
+	    static __m256d times_i_lo(const __m256d& a)
+	    {
+		return _mm256_xor_pd(_mm256_permute_pd(a,0x9),_mm256_set_pd(0.0,0.0,0.0,-0.0));
+	    }
+
+	    /* Multiplies lane 1 by the imaginary unit: */
+
+	    static __m256d times_i_hi(const __m256d& a)
+	    {
+		return _mm256_xor_pd(_mm256_permute_pd(a,0x6),_mm256_set_pd(0.0,-0.0,0.0,0.0));
+	    }
+
+	    /* Left-handed current components (0,1) and (-i*2,3) from the
+	     * products (a0*b2,a1*b3) and (a0*b3,a1*b2): */
+
+	    static void left_first(const value_type* a,const value_type* b,__m256d& lo,__m256d& hi)
+	    {
+		__m256d a01=load(a);
+		__m256d b23=load(b+2);
+		__m256d P=mul(a01,b23);
+		__m256d Q=mul(a01,swap(b23));
+		__m256d Pw=swap(P);
+		__m256d Qw=swap(Q);
+		lo=blend(_mm256_add_pd(P,Pw),_mm256_add_pd(Q,Qw));
+		hi=blend(_mm256_sub_pd(Qw,Q),_mm256_sub_pd(Pw,P));
+	    }
+
+	    /* Right-handed current components (0,1) and (-i*2,3) from the
+	     * products (a2*b0,a3*b1) and (a2*b1,a3*b0): */
+
+	    static void right_first(const value_type* a,const value_type* b,__m256d& lo,__m256d& hi)
+	    {
+		__m256d a23=load(a+2);
+		__m256d b01=load(b);
+		__m256d P=mul(a23,b01);
+		__m256d Q=mul(a23,swap(b01));
+		__m256d Pw=swap(P);
+		__m256d Qw=swap(Q);
+		lo=blend(_mm256_add_pd(P,Pw),negate(_mm256_add_pd(Q,Qw)));
+		hi=blend(_mm256_sub_pd(Q,Qw),_mm256_sub_pd(P,Pw));
+	    }
+
+	    /* Loads the vector V and forms S=(V0+V3,V1+i*V2) and
+	     * D=(V0-V3,V1-i*V2): */
+
+	    static void slash(const value_type* V,__m256d& S,__m256d& D)
+	    {
+		__m256d l=load(V);
+		__m256d r=times_i_hi(swap(load(V+2)));
+		S=_mm256_add_pd(l,r);
+		D=_mm256_sub_pd(l,r);
+	    }
+    };
+
+#endif /*CAMGEN_SIMD_AVX*/
+}
+
+#endif /*CAMGEN_SIMD_SPINOR_H_*/
+
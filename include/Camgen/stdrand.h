@@ -21,7 +21,9 @@
 
 namespace std
 {
-    /// Wrapper class for the standard library random number stream.
+    /// Wrapper class for the standard library random number stream. All
+    /// instances share the global rand() state, so the engine is neither
+    /// per-thread nor thread-safe.
 
     class random
     {
@@ -298,6 +298,19 @@ namespace Camgen
 		value_type m=stot_channel->m();
 		value_type s2=s2_channel->s();
 
+		/* Branchings sharing the t-channel and the invariants, e.g. with
+		 * different incoming spacelike particles, reuse the density: */
+
+		value_type invariants[5]={sa,sb,s1,s2,s};
+		value_type factor;
+		bool valid;
+		if(t_channel->find_t_density(invariants,factor,valid))
+		{
+		    tweight=t_channel->s_weight();
+		    this->branching_weight=valid?(factor*sweight):(value_type)0;
+		    return (valid and this->branching_weight>(value_type)0);
+		}
+
 		value_type A=0.5*(sa+sb+s1+s2-s-(sa-sb)*(s1-s2)/s);
 		value_type lab=std::sqrt(Kallen(s,sa,sb));
 		value_type l12=std::sqrt(Kallen(s,s1,s2));
@@ -309,16 +322,20 @@ namespace Camgen
 		{
 		    tweight=(value_type)0;
 		    this->branching_weight=(value_type)0;
+		    t_channel->memoise_t_density(invariants,(value_type)0,false);
 		    return false;
 		}
 		if(!t_channel->evaluate_s_weight())
 		{
 		    tweight=(value_type)0;
 		    this->branching_weight=(value_type)0;
+		    t_channel->memoise_t_density(invariants,(value_type)0,false);
 		    return false;
 		}
 		tweight=t_channel->s_weight();
-		this->branching_weight=massless_ps<value_type,2,model_t::dimension>::volume(m)*std::pow(l12/s,int(model_t::dimension-4))*sweight*tweight/lab;
+		factor=massless_ps<value_type,2,model_t::dimension>::volume(m)*std::pow(l12/s,int(model_t::dimension-4))*tweight/lab;
+		t_channel->memoise_t_density(invariants,factor,true);
+		this->branching_weight=factor*sweight;
 		return (this->branching_weight>(value_type)0);
             }
 
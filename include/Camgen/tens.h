@@ -17,16 +17,17 @@
 #include <cstddef>
 #include <stdexcept>
 #include <Camgen/rn_strm.h>
+#include <Camgen/tens_data.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Tensor class declaration and definition. The is the main data container type  *
  * in Camgen, since all internal polarisation vectors and spinors are in the    *
  * tensor format. This implementation has only one template parameter: the       *
  * numerical type. The implementation is essentially that of <valarray>: the     *
- * data is stored in a linear sequence (stl vector), but the access members      *
- * emulate a tensorial shape. Traversing the tensor in all directions is         *
- * optimised because the block sizes are stored in the class. However, this      *
- * makes the creation of tensors rather slow.                                    *
+ * data is stored in a linear sequence (inline for small tensors, see            *
+ * tens_data.h), but the access members emulate a tensorial shape. Traversing    *
+ * the tensor in all directions is optimised because the block sizes are stored  *
+ * in the class. However, this makes the creation of tensors rather slow.        *
  *                                                                               *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -218,6 +219,15 @@ namespace Camgen
 		return *this;
 	    }
 
+	    /* Moves the components to the external storage at the argument
+	     * address, which holds size() entries (see tens_data.h): */
+
+	    tensor<T>& bind_data(value_type* p)
+	    {
+		data.bind(p);
+		return *this;
+	    }
+
 	    /* Reset all entries to zero: */
 
 	    tensor<T>& reset()
@@ -622,7 +632,7 @@ namespace Camgen
 	    
 	    /* Linearly stored tensor components: */
 
-	    std::vector<value_type>data;
+	    tensor_data<value_type,CAMGEN_TENSOR_INLINE_SIZE>data;
 	    
 	    /* Number of indices: */
 	    
@@ -878,6 +888,15 @@ namespace Camgen
 		return *this;
 	    }
 
+	    /* Moves the components to the external storage at the argument
+	     * address, which holds size() entries (see tens_data.h): */
+
+	    tensor<std::complex<T> >& bind_data(value_type* p)
+	    {
+		data.bind(p);
+		return *this;
+	    }
+
 	    /* Reset all entries to zero: */
 
 	    tensor<std::complex<T> >& reset()
@@ -1298,7 +1317,7 @@ namespace Camgen
 	    
 	    /* Linearly stored tensor components: */
 
-	    std::vector<value_type>data;
+	    tensor_data<value_type,CAMGEN_TENSOR_INLINE_SIZE>data;
 	    
 	    /* Number of indices: */
 	    
@@ -0,0 +1,281 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#ifndef CAMGEN_TENS_DATA_H_
+#define CAMGEN_TENS_DATA_H_
+
+#include <vector>
+#include <cstddef>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Declaration and definition of the tensor_data class, the linear component     *
+ * container of the tensor class. Up to N components are stored inline in the    *
+ * object itself, larger sizes fall back to a heap-allocated stl vector. The     *
+ * container can also be bound to external storage of exactly its size, which   *
+ * the current tree uses to lay out all subamplitudes in one contiguous block,  *
+ * each current taking the size of its particle type (see current_tree.h). The  *
+ * inline capacity can be set by defining CAMGEN_TENSOR_INLINE_SIZE and covers  *
+ * the Lorentz vectors and spinors by default.                                   *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef CAMGEN_TENSOR_INLINE_SIZE
+#define CAMGEN_TENSOR_INLINE_SIZE 4
+#endif
+
+namespace Camgen
+{
+    template<class T,std::size_t N>class tensor_data
+    {
+	public:
+
+	    /* The usual container type definitions: */
+
+	    typedef T value_type;
+	    typedef typename std::vector<T>::size_type size_type;
+	    typedef typename std::vector<T>::difference_type difference_type;
+
+	    /* Inline capacity: */
+
+	    static const size_type inline_size=N;
+
+	    /* Trivial constructor, yielding an empty container: */
+
+	    tensor_data():n(0),p(buf),bound(false){}
+
+	    /* Constructor of a container with m value-initialised elements: */
+
+	    explicit tensor_data(size_type m):n(0),p(buf),bound(false)
+	    {
+		resize(m);
+	    }
+
+	    /* Copy constructor: */
+
+	    tensor_data(const tensor_data<T,N>& other):n(0),p(buf),bound(false)
+	    {
+		assign(other);
+	    }
+
+	    /* Assignment operator: */
+
+	    tensor_data<T,N>& operator = (const tensor_data<T,N>& other)
+	    {
+		if(this!=&other)
+		{
+		    assign(other);
+		}
+		return *this;
+	    }
+
+	    /* Size readout: */
+
+	    size_type size() const
+	    {
+		return n;
+	    }
+
+	    /* Returns whether the components are stored inline: */
+
+	    bool is_inline() const
+	    {
+		return p==buf;
+	    }
+
+	    /* Returns whether the components live in external storage: */
+
+	    bool is_bound() const
+	    {
+		return bound;
+	    }
+
+	    /* Moves the elements to the external storage at the argument
+	     * address, which should hold size() elements and outlive the
+	     * binding. The container keeps the external storage until it is
+	     * resized or assigned to with a different size: */
+
+	    void bind(T* q)
+	    {
+		for(size_type i=0;i<n;++i)
+		{
+		    q[i]=p[i];
+		}
+		std::vector<T>().swap(heap);
+		p=q;
+		bound=true;
+	    }
+
+	    /* Resizes the container, preserving the first elements and
+	     * value-initialising the new ones: */
+
+	    void resize(size_type m)
+	    {
+		if(bound)
+		{
+		    if(m==n)
+		    {
+			return;
+		    }
+		    unbind();
+		}
+		if(m<=N)
+		{
+		    if(p!=buf)
+		    {
+			for(size_type i=0;i<m;++i)
+			{
+			    buf[i]=heap[i];
+			}
+			std::vector<T>().swap(heap);
+			p=buf;
+		    }
+		    for(size_type i=n;i<m;++i)
+		    {
+			buf[i]=T();
+		    }
+		}
+		else
+		{
+		    if(p==buf)
+		    {
+			heap.assign(buf,buf+n);
+		    }
+		    heap.resize(m);
+		    p=&heap[0];
+		}
+		n=m;
+	    }
+
+	    /* Element access: */
+
+	    T& operator [] (size_type i)
+	    {
+		return p[i];
+	    }
+	    const T& operator [] (size_type i) const
+	    {
+		return p[i];
+	    }
+
+	    /* Last element access: */
+
+	    T& back()
+	    {
+		return p[n-1];
+	    }
+	    const T& back() const
+	    {
+		return p[n-1];
+	    }
+
+	    /* Comparison operator: */
+
+	    bool operator == (const tensor_data<T,N>& other) const
+	    {
+		if(n!=other.n)
+		{
+		    return false;
+		}
+		for(size_type i=0;i<n;++i)
+		{
+		    if(!(p[i]==other.p[i]))
+		    {
+			return false;
+		    }
+		}
+		return true;
+	    }
+	    bool operator != (const tensor_data<T,N>& other) const
+	    {
+		return !(this->operator==(other));
+	    }
+
+	private:
+
+	    /* Number of elements: */
+
+	    size_type n;
+
+	    /* Address of the first element, either the inline buffer or the
+	     * heap vector data: */
+
+	    T* p;
+
+	    /* Inline buffer: */
+
+	    T buf[N];
+
+	    /* Heap storage for sizes beyond the inline capacity: */
+
+	    std::vector<T>heap;
+
+	    /* Flag denoting whether p addresses external storage: */
+
+	    bool bound;
+
+	    /* Moves the elements from the external storage to the inline
+	     * buffer or the heap: */
+
+	    void unbind()
+	    {
+		if(n<=N)
+		{
+		    for(size_type i=0;i<n;++i)
+		    {
+			buf[i]=p[i];
+		    }
+		    p=buf;
+		}
+		else
+		{
+		    heap.assign(p,p+n);
+		    p=&heap[0];
+		}
+		bound=false;
+	    }
+
+	    /* Copies the elements of another container: */
+
+	    void assign(const tensor_data<T,N>& other)
+	    {
+		if(bound)
+		{
+		    if(other.n==n)
+		    {
+			for(size_type i=0;i<n;++i)
+			{
+			    p[i]=other.p[i];
+			}
+			return;
+		    }
+		    unbind();
+		}
+		if(other.n<=N)
+		{
+		    if(p!=buf)
+		    {
+			std::vector<T>().swap(heap);
+			p=buf;
+		    }
+		    for(size_type i=0;i<other.n;++i)
+		    {
+			buf[i]=other.p[i];
+		    }
+		}
+		else
+		{
+		    heap.assign(other.p,other.p+other.n);
+		    p=&heap[0];
+		}
+		n=other.n;
+	    }
+    };
+    template<class T,std::size_t N>const typename tensor_data<T,N>::size_type tensor_data<T,N>::inline_size;
+}
+
+#endif /*CAMGEN_TENS_DATA_H_*/
+
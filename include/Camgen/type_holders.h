@@ -10,6 +10,7 @@
 
 #include <set>
 #include <Camgen/unused.h>
+#include <Camgen/iter_mask.h>
 #include <Camgen/tensor.h>
 #include <Camgen/forward_decs.h>
 #include <Camgen/phase_space.h>
@@ -128,7 +129,7 @@ namespace Camgen
 	    typedef typename tensor<value_type>::iterator iterator;
 	    typedef vector<r_value_type,model_t::dimension> momentum_type;
 	public:
-	    typedef void(*vert_func)(const value_type&,const std::vector<const value_type*>&,std::vector<iterator>&,const std::vector<const momentum_type*>&);
+	    typedef void(*vert_func)(const value_type&,const value_type* const*,iterator*,const momentum_type* const*);
 	    
 	    template<class Feynrule_t>class apply
 	    {
@@ -147,7 +148,7 @@ namespace Camgen
 	    typedef typename tensor<value_type>::iterator iterator;
 	    typedef vector<r_value_type,model_t::dimension> momentum_type;
 	public:
-	    typedef void(*vert_func)(const value_type&,const std::vector<const value_type*>&,std::vector<iterator>&,const std::vector<const momentum_type*>&,std::set<iterator>&);	    
+	    typedef void(*vert_func)(const value_type&,const value_type* const*,iterator*,const momentum_type* const*,iterator_mask<iterator>&);	    
 	    template<class Feynrule_t>class apply
 	    {
 		public:
@@ -181,11 +181,12 @@ namespace Camgen
 
 	    bool generate()
 	    {
-		value_type w,x0,x1;
+		value_type w,x0,x1,x[2];
 		do
 		{
-		    x0=rn_stream::throw_number(-(value_type)1,(value_type)1);
-		    x1=rn_stream::throw_number(-(value_type)1,(value_type)1);
+		    rn_stream::fill(x,2,-(value_type)1,(value_type)1);
+		    x0=x[0];
+		    x1=x[1];
 		    w=x0*x0+x1*x1;
 		}
 		while(w>=(value_type)1);
@@ -273,11 +274,12 @@ namespace Camgen
 
 	    bool generate()
 	    {
-		value_type w,x0,x1;
+		value_type w,x0,x1,x[2];
 		do
 		{
-		    x0=rn_stream::throw_number(-(value_type)1,(value_type)1);
-		    x1=rn_stream::throw_number(-(value_type)1,(value_type)1);
+		    rn_stream::fill(x,2,-(value_type)1,(value_type)1);
+		    x0=x[0];
+		    x1=x[1];
 		    w=x0*x0+x1*x1;
 		}
 		while(w>=(value_type)1);
@@ -367,13 +369,14 @@ namespace Camgen
 
 	    bool generate()
 	    {
-		value_type w0,w1,x0,x1,x2,x3;
+		value_type w0,w1,x0,x1,x2,x3,x[4];
 		do
 		{
-		    x0=rn_stream::throw_number(-(value_type)1,(value_type)1);
-		    x1=rn_stream::throw_number(-(value_type)1,(value_type)1);
-		    x2=rn_stream::throw_number(-(value_type)1,(value_type)1);
-		    x3=rn_stream::throw_number(-(value_type)1,(value_type)1);
+		    rn_stream::fill(x,4,-(value_type)1,(value_type)1);
+		    x0=x[0];
+		    x1=x[1];
+		    x2=x[2];
+		    x3=x[3];
 		    w0=x0*x0+x1*x1;
 		    w1=x2*x2+x3*x3;
 		}
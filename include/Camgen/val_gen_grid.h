@@ -235,6 +235,33 @@ namespace Camgen
 		}
 	    }
 
+	    /* Thread-safe grid update by the integrand f of an event with value
+	     * s, adding to the worker's shadow of the grid (see shadow_acc.h): */
+
+	    void accumulate(const value_type& s,const value_type& f)
+	    {
+		value_type x=mapping->inverse_map(s);
+		value_type w=grid->point_weight(x);
+		if(w!=(value_type)0)
+		{
+		    grid->accumulate(x,f/w);
+		}
+	    }
+
+	    /* Sets the number of worker threads updating the grid: */
+
+	    void set_update_workers(size_type n)
+	    {
+		grid->set_update_workers(n);
+	    }
+
+	    /* Merges the worker shadows into the grid: */
+
+	    void merge_shadows()
+	    {
+		grid->merge_shadows();
+	    }
+
 	    /* Adaptive method: */
 
 	    void adapt()
@@ -249,6 +276,20 @@ namespace Camgen
 		grid->reset();
 	    }
 
+	    /* Writes the adaptive grid to the binary output stream: */
+
+	    void save_state(std::ostream& os) const
+	    {
+		grid->save_state(os);
+	    }
+
+	    /* Reads the adaptive grid from the binary input stream: */
+
+	    bool load_state(std::istream& is)
+	    {
+		return grid->load_state(is);
+	    }
+
 	    /* Overridden cross section resetting method */
 
 	    void reset_cross_section()
@@ -355,6 +355,14 @@ namespace Camgen
 		return couplings;
 	    }
 
+	    /* Coupling address array passed to the Feynman rules, NULL if the
+	     * vertex has no couplings: */
+
+	    const value_type* const* get_coupling_addresses() const
+	    {
+		return couplings.empty()?NULL:&couplings[0];
+	    }
+
 	    /* Majorana-type readout: */
 	    
 	    size_type get_Majorana_type() const
@@ -8,6 +8,7 @@
 #ifndef CAMGEN_WIDTH_SCHEME_H_
 #define CAMGEN_WIDTH_SCHEME_H_
 
+#include <Camgen/debug.h>
 #include <Camgen/def_args.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -158,39 +159,39 @@ namespace Camgen
 
 	    /* Momentum flowing through the propagator: */
 
-	    static const momentum_type* momentum;
+	    static CAMGEN_THREAD_LOCAL const momentum_type* momentum;
 
 	    /* Mass of the propagator: */
 
-	    static const r_value_type* mass;
+	    static CAMGEN_THREAD_LOCAL const r_value_type* mass;
 
 	    /* Width of the propagator: */
 
-	    static const r_value_type* width;
+	    static CAMGEN_THREAD_LOCAL const r_value_type* width;
 
 	    /* Invariant mass-squared flowing through the propagator: */
 
-	    static r_value_type s;
+	    static CAMGEN_THREAD_LOCAL r_value_type s;
 
 	    /* Denominator result from the evaluate() method: */
 
-	    static value_type denominator;
+	    static CAMGEN_THREAD_LOCAL value_type denominator;
 
 	    /* Complex fermion mass result from the evaluate() method: */
 
-	    static value_type fermion_mass;
+	    static CAMGEN_THREAD_LOCAL value_type fermion_mass;
 
 	    /* Complex gauge boson mass result from the evaluate() method: */
 
-	    static value_type gauge_mass2;
+	    static CAMGEN_THREAD_LOCAL value_type gauge_mass2;
     };
-    template<class model_t>const typename width_scheme<model_t>::momentum_type* width_scheme<model_t>::momentum(NULL);
-    template<class model_t>const typename width_scheme<model_t>::r_value_type* width_scheme<model_t>::mass(NULL);
-    template<class model_t>const typename width_scheme<model_t>::r_value_type* width_scheme<model_t>::width(NULL);
-    template<class model_t>typename width_scheme<model_t>::r_value_type width_scheme<model_t>::s(0);
-    template<class model_t>typename width_scheme<model_t>::value_type width_scheme<model_t>::denominator(0,0);
-    template<class model_t>typename width_scheme<model_t>::value_type width_scheme<model_t>::fermion_mass(0,0);
-    template<class model_t>typename width_scheme<model_t>::value_type width_scheme<model_t>::gauge_mass2(0,0);
+    template<class model_t>CAMGEN_THREAD_LOCAL const typename width_scheme<model_t>::momentum_type* width_scheme<model_t>::momentum(NULL);
+    template<class model_t>CAMGEN_THREAD_LOCAL const typename width_scheme<model_t>::r_value_type* width_scheme<model_t>::mass(NULL);
+    template<class model_t>CAMGEN_THREAD_LOCAL const typename width_scheme<model_t>::r_value_type* width_scheme<model_t>::width(NULL);
+    template<class model_t>CAMGEN_THREAD_LOCAL typename width_scheme<model_t>::r_value_type width_scheme<model_t>::s(0);
+    template<class model_t>CAMGEN_THREAD_LOCAL typename width_scheme<model_t>::value_type width_scheme<model_t>::denominator(0,0);
+    template<class model_t>CAMGEN_THREAD_LOCAL typename width_scheme<model_t>::value_type width_scheme<model_t>::fermion_mass(0,0);
+    template<class model_t>CAMGEN_THREAD_LOCAL typename width_scheme<model_t>::value_type width_scheme<model_t>::gauge_mass2(0,0);
     template<class model_t>bool width_scheme<model_t>::switched_on=true;
     template<class model_t>bool width_scheme<model_t>::complex_masses=true;
     template<class model_t>bool width_scheme<model_t>::running_widths=false;
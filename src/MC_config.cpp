@@ -491,6 +491,22 @@ namespace Camgen
 	MC_config::init_evts=n;
     }
 
+    /* Sets the number of subprocess initialisation threads. */
+
+    bool set_init_threads(std::size_t n)
+    {
+	return MC_config::set_init_threads(n);
+    }
+    bool MC_config::set_init_threads(std::size_t n)
+    {
+	if(n==0)
+	{
+	    return false;
+	}
+	MC_config::init_thrds=n;
+	return true;
+    }
+
     /* Returns the helicity generator type. */
 
     helicity_generators::type helicity_generator_type()
@@ -976,6 +992,17 @@ namespace Camgen
 	return MC_config::init_evts;
     }
 
+    /* Returns the number of subprocess initialisation threads: */
+
+    std::size_t init_threads()
+    {
+	return MC_config::init_threads();
+    }
+    std::size_t MC_config::init_threads()
+    {
+	return MC_config::init_thrds;
+    }
+
     /* Returns the s-pair generation mode: */
 
     s_pair_generation_modes::type s_pair_generation_mode()
@@ -1089,6 +1116,7 @@ namespace Camgen
     std::size_t MC_config::NR_iters=10;
     bool MC_config::pdf_alpha_s=true;
     std::size_t MC_config::init_evts=10000;
+    std::size_t MC_config::init_thrds=1;
     s_pair_generation_modes::type MC_config::s_pair_genmode=s_pair_generation_modes::hit_and_miss;
     
     std::map<std::pair<int,int>,double> MC_config::mmin;
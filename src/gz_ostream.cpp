@@ -0,0 +1,259 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+/*! \file gz_ostream.cpp
+    \brief Compressing output file stream implementation.
+ */
+
+#include <Camgen/gz_ostream.h>
+#include <Camgen/debug.h>
+#include <Camgen/logstream.h>
+#include <config.h>
+
+#if HAVE_ZLIB_H
+#include <cstdio>
+#include <vector>
+#include <zlib.h>
+#endif
+
+namespace Camgen
+{
+#if HAVE_ZLIB_H
+
+    /* Stream buffer deflating its contents into a gzip file: */
+
+    class gz_streambuf: public std::streambuf
+    {
+	public:
+
+	    /* Constructor: */
+
+	    gz_streambuf():file(NULL),in_buf(1<<16),out_buf(1<<16){}
+
+	    /* Destructor: */
+
+	    ~gz_streambuf()
+	    {
+		close();
+	    }
+
+	    /* Opens the argument file with the argument compression level: */
+
+	    bool open(const std::string& fname,int level)
+	    {
+		close();
+		file=std::fopen(fname.c_str(),"wb");
+		if(file==NULL)
+		{
+		    return false;
+		}
+		zs.zalloc=Z_NULL;
+		zs.zfree=Z_NULL;
+		zs.opaque=Z_NULL;
+		if(deflateInit2(&zs,level,Z_DEFLATED,15+16,8,Z_DEFAULT_STRATEGY)!=Z_OK)
+		{
+		    std::fclose(file);
+		    file=NULL;
+		    return false;
+		}
+		setp(&in_buf[0],&in_buf[0]+in_buf.size());
+		return true;
+	    }
+
+	    /* Compresses the pending data, writes the gzip trailer and closes
+	     * the file: */
+
+	    bool close()
+	    {
+		if(file==NULL)
+		{
+		    return true;
+		}
+		bool q=deflate_buffer(Z_FINISH);
+		deflateEnd(&zs);
+		q=(std::fclose(file)==0) and q;
+		file=NULL;
+		setp(NULL,NULL);
+		return q;
+	    }
+
+	    /* Returns whether a file is open: */
+
+	    bool is_open() const
+	    {
+		return (file!=NULL);
+	    }
+
+	protected:
+
+	    /* Compresses the full input buffer and appends the character: */
+
+	    int overflow(int c)
+	    {
+		if(file==NULL or !deflate_buffer(Z_NO_FLUSH))
+		{
+		    return traits_type::eof();
+		}
+		if(c!=traits_type::eof())
+		{
+		    *pptr()=(char)c;
+		    pbump(1);
+		}
+		return traits_type::not_eof(c);
+	    }
+
+	    /* Flushing only hands the buffered data to the compressor, since
+	     * forcing compressed output on every line would spoil the
+	     * compression ratio: */
+
+	    int sync()
+	    {
+		return (file!=NULL and deflate_buffer(Z_NO_FLUSH))?0:-1;
+	    }
+
+	private:
+
+	    /* Output file: */
+
+	    std::FILE* file;
+
+	    /* Compression state: */
+
+	    z_stream zs;
+
+	    /* Uncompressed and compressed buffers: */
+
+	    std::vector<char> in_buf,out_buf;
+
+	    /* Deflates the buffered data with the argument flush mode and
+	     * writes the compressed output: */
+
+	    bool deflate_buffer(int flush)
+	    {
+		zs.next_in=reinterpret_cast<Bytef*>(pbase());
+		zs.avail_in=(uInt)(pptr()-pbase());
+		int status;
+		do
+		{
+		    zs.next_out=reinterpret_cast<Bytef*>(&out_buf[0]);
+		    zs.avail_out=(uInt)out_buf.size();
+		    status=deflate(&zs,flush);
+		    if(status==Z_STREAM_ERROR)
+		    {
+			return false;
+		    }
+		    std::size_t n=out_buf.size()-zs.avail_out;
+		    if(n>0 and std::fwrite(&out_buf[0],1,n,file)!=n)
+		    {
+			return false;
+		    }
+		}
+		while(zs.avail_out==0 or (flush==Z_FINISH and status!=Z_STREAM_END));
+		setp(&in_buf[0],&in_buf[0]+in_buf.size());
+		return true;
+	    }
+    };
+
+#endif /*HAVE_ZLIB_H*/
+
+    /* Destructor: */
+
+    gz_ofstream::~gz_ofstream()
+    {
+	close();
+#if HAVE_ZLIB_H
+	delete static_cast<gz_streambuf*>(gz_buf);
+#endif
+    }
+
+    /* Zlib support flag: */
+
+    bool gz_ofstream::zlib_support()
+    {
+#if HAVE_ZLIB_H
+	return true;
+#else
+	return false;
+#endif
+    }
+
+    /* Opens the argument file: */
+
+    bool gz_ofstream::open(const std::string& fname)
+    {
+	close();
+	clear();
+	compressed=is_compressed(fname);
+	if(compressed)
+	{
+#if HAVE_ZLIB_H
+	    if(gz_buf==NULL)
+	    {
+		gz_buf=new gz_streambuf;
+	    }
+	    rdbuf(gz_buf);
+	    if(!static_cast<gz_streambuf*>(gz_buf)->open(fname,level()))
+	    {
+		setstate(std::ios::failbit);
+		return false;
+	    }
+	    return true;
+#else
+	    log(log_level::warning)<<CAMGEN_STREAMLOC<<"Camgen was built without zlib--writing "<<base_name(fname)<<" uncompressed"<<endlog;
+	    compressed=false;
+#endif
+	}
+	rdbuf(&file_buf);
+	if(file_buf.open(base_name(fname).c_str(),std::ios::out|std::ios::trunc)==NULL)
+	{
+	    setstate(std::ios::failbit);
+	    return false;
+	}
+	return true;
+    }
+
+    /* Returns whether a file is open: */
+
+    bool gz_ofstream::is_open() const
+    {
+#if HAVE_ZLIB_H
+	if(compressed)
+	{
+	    return static_cast<const gz_streambuf*>(gz_buf)->is_open();
+	}
+#endif
+	return file_buf.is_open();
+    }
+
+    /* Flushes and closes the file: */
+
+    bool gz_ofstream::close()
+    {
+	if(!is_open())
+	{
+	    return true;
+	}
+	flush();
+	bool q;
+#if HAVE_ZLIB_H
+	if(compressed)
+	{
+	    q=static_cast<gz_streambuf*>(gz_buf)->close();
+	}
+	else
+#endif
+	{
+	    q=(file_buf.close()!=NULL);
+	}
+	if(!q)
+	{
+	    setstate(std::ios::failbit);
+	}
+	return q;
+    }
+}
+
@@ -0,0 +1,279 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <Camgen/philox.h>
+
+/* The multi-block kernel uses AVX2 integer multiplications if CAMGEN_USE_SIMD
+ * is defined and the compiler targets AVX2 (configure with --enable-simd): */
+
+#if defined(CAMGEN_USE_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define CAMGEN_PHILOX_AVX2
+#endif
+
+namespace Camgen
+{
+    /* Minimal and maximal thrown values: */
+
+    const philox::result_type philox::min_value;
+    const philox::result_type philox::max_value;
+    const std::size_t philox::lanes;
+
+    /* Substream support flag: */
+
+    const bool rn_substream<philox>::value;
+
+    /* Default key: */
+
+    philox::counter_type philox::seed=290881;
+
+    /* Constructors: */
+
+    philox::philox():stream(0),next_block(0),index(4)
+    {
+	key[0]=(word_type)(seed&0xFFFFFFFF);
+	key[1]=(word_type)(seed>>32);
+    }
+
+    philox::philox(counter_type k,counter_type n):stream(n),next_block(0),index(4)
+    {
+	key[0]=(word_type)(k&0xFFFFFFFF);
+	key[1]=(word_type)(k>>32);
+    }
+
+    /* Throwing operator: */
+
+    philox::result_type philox::operator()(void)
+    {
+	if(index==4)
+	{
+	    fill_buffer(next_block);
+	    ++next_block;
+	    index=0;
+	}
+	return (result_type)(buffer[index++]>>1);
+    }
+
+    /* Bulk throwing method: */
+
+    void philox::fill(result_type* r,std::size_t n)
+    {
+	std::size_t i=0;
+
+	/* Drain the current buffer: */
+
+	while(index<4 and i<n)
+	{
+	    r[i++]=(result_type)(buffer[index++]>>1);
+	}
+
+	/* Compute full blocks in groups: */
+
+	word_type out[4*lanes];
+	while(n-i>=4*lanes)
+	{
+	    fill_blocks(next_block,out);
+	    next_block+=lanes;
+	    for(std::size_t j=0;j<4*lanes;++j)
+	    {
+		r[i+j]=(result_type)(out[j]>>1);
+	    }
+	    i+=4*lanes;
+	}
+
+	/* Throw the remainder: */
+
+	while(i<n)
+	{
+	    r[i++]=(*this)();
+	}
+    }
+
+    /* Stream selection: */
+
+    void philox::set_stream(counter_type n)
+    {
+	stream=n;
+	next_block=0;
+	index=4;
+    }
+
+    philox::counter_type philox::get_stream() const
+    {
+	return stream;
+    }
+
+    /* Jump-ahead: */
+
+    void philox::jump(counter_type n)
+    {
+	counter_type pos=position()+n;
+	next_block=pos/4;
+	index=4;
+	if(pos%4!=0)
+	{
+	    fill_buffer(next_block);
+	    ++next_block;
+	    index=pos%4;
+	}
+    }
+
+    philox::counter_type philox::position() const
+    {
+	return (index==4)?(4*next_block):(4*(next_block-1)+index);
+    }
+
+    /* Philox4x32-10 block function: */
+
+    void philox::block(const word_type c[4],const word_type k[2],word_type out[4])
+    {
+	static const word_type M0=0xD2511F53;
+	static const word_type M1=0xCD9E8D57;
+	static const word_type W0=0x9E3779B9;
+	static const word_type W1=0xBB67AE85;
+
+	word_type x[4]={c[0],c[1],c[2],c[3]};
+	word_type k0=k[0];
+	word_type k1=k[1];
+	for(int r=0;r<10;++r)
+	{
+	    counter_type p0=(counter_type)M0*x[0];
+	    counter_type p1=(counter_type)M1*x[2];
+	    word_type y0=(word_type)(p1>>32)^x[1]^k0;
+	    word_type y1=(word_type)p1;
+	    word_type y2=(word_type)(p0>>32)^x[3]^k1;
+	    word_type y3=(word_type)p0;
+	    x[0]=y0;
+	    x[1]=y1;
+	    x[2]=y2;
+	    x[3]=y3;
+	    k0+=W0;
+	    k1+=W1;
+	}
+	for(int i=0;i<4;++i)
+	{
+	    out[i]=x[i];
+	}
+    }
+
+    /* Block computation into the buffer: */
+
+    void philox::fill_buffer(counter_type n)
+    {
+	word_type c[4];
+	c[0]=(word_type)(n&0xFFFFFFFF);
+	c[1]=(word_type)(n>>32);
+	c[2]=(word_type)(stream&0xFFFFFFFF);
+	c[3]=(word_type)(stream>>32);
+	block(c,key,buffer);
+    }
+
+    /* Multi-block computation, with the lanes in separate arrays to allow
+     * vectorisation of the rounds: */
+
+#ifdef CAMGEN_PHILOX_AVX2
+
+    /* Computes the high and low words of the products of the eight 32-bit
+     * lanes of x with the multiplier m: */
+
+    static inline void mulhilo(__m256i x,__m256i m,__m256i& hi,__m256i& lo)
+    {
+	__m256i pe=_mm256_mul_epu32(x,m);
+	__m256i po=_mm256_mul_epu32(_mm256_srli_epi64(x,32),m);
+	lo=_mm256_blend_epi32(pe,_mm256_slli_epi64(po,32),0xAA);
+	hi=_mm256_blend_epi32(_mm256_srli_epi64(pe,32),po,0xAA);
+    }
+
+    void philox::fill_blocks(counter_type n,word_type out[4*lanes]) const
+    {
+	word_type c0[lanes],c1[lanes];
+	for(std::size_t j=0;j<lanes;++j)
+	{
+	    c0[j]=(word_type)((n+j)&0xFFFFFFFF);
+	    c1[j]=(word_type)((n+j)>>32);
+	}
+	__m256i x0=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0));
+	__m256i x1=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1));
+	__m256i x2=_mm256_set1_epi32((int)(stream&0xFFFFFFFF));
+	__m256i x3=_mm256_set1_epi32((int)(stream>>32));
+	__m256i M0=_mm256_set1_epi32((int)0xD2511F53);
+	__m256i M1=_mm256_set1_epi32((int)0xCD9E8D57);
+	word_type k0=key[0];
+	word_type k1=key[1];
+	__m256i hi0,lo0,hi1,lo1;
+	for(int r=0;r<10;++r)
+	{
+	    mulhilo(x0,M0,hi0,lo0);
+	    mulhilo(x2,M1,hi1,lo1);
+	    x0=_mm256_xor_si256(_mm256_xor_si256(hi1,x1),_mm256_set1_epi32((int)k0));
+	    x1=lo1;
+	    x2=_mm256_xor_si256(_mm256_xor_si256(hi0,x3),_mm256_set1_epi32((int)k1));
+	    x3=lo0;
+	    k0+=0x9E3779B9;
+	    k1+=0xBB67AE85;
+	}
+	word_type y0[lanes],y1[lanes],y2[lanes],y3[lanes];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(y0),x0);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(y1),x1);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(y2),x2);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(y3),x3);
+	for(std::size_t j=0;j<lanes;++j)
+	{
+	    out[4*j]=y0[j];
+	    out[4*j+1]=y1[j];
+	    out[4*j+2]=y2[j];
+	    out[4*j+3]=y3[j];
+	}
+    }
+
+#else
+
+    void philox::fill_blocks(counter_type n,word_type out[4*lanes]) const
+    {
+	static const word_type M0=0xD2511F53;
+	static const word_type M1=0xCD9E8D57;
+	static const word_type W0=0x9E3779B9;
+	static const word_type W1=0xBB67AE85;
+
+	word_type x0[lanes],x1[lanes],x2[lanes],x3[lanes];
+	for(std::size_t j=0;j<lanes;++j)
+	{
+	    x0[j]=(word_type)((n+j)&0xFFFFFFFF);
+	    x1[j]=(word_type)((n+j)>>32);
+	    x2[j]=(word_type)(stream&0xFFFFFFFF);
+	    x3[j]=(word_type)(stream>>32);
+	}
+	word_type k0=key[0];
+	word_type k1=key[1];
+	for(int r=0;r<10;++r)
+	{
+	    for(std::size_t j=0;j<lanes;++j)
+	    {
+		counter_type p0=(counter_type)x0[j]*M0;
+		counter_type p1=(counter_type)x2[j]*M1;
+		word_type y0=(word_type)(p1>>32)^x1[j]^k0;
+		word_type y2=(word_type)(p0>>32)^x3[j]^k1;
+		x1[j]=(word_type)p1;
+		x3[j]=(word_type)p0;
+		x0[j]=y0;
+		x2[j]=y2;
+	    }
+	    k0+=W0;
+	    k1+=W1;
+	}
+	for(std::size_t j=0;j<lanes;++j)
+	{
+	    out[4*j]=x0[j];
+	    out[4*j+1]=x1[j];
+	    out[4*j+2]=x2[j];
+	    out[4*j+3]=x3[j];
+	}
+    }
+
+#endif
+}
+
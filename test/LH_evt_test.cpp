@@ -5,10 +5,17 @@
 // see COPYING for details.
 //
 
+#include <config.h>
 #include <Camgen/SM.h>
 #include <Camgen/stdrand.h>
 #include <Camgen/evtgen_fac.h>
+#include <fstream>
+#include <sstream>
+#include <locale>
 #include <Camgen/LH_evt_stream.h>
+#if HAVE_ZLIB_H
+#include <zlib.h>
+#endif
 
 /* * * * * * * * * * * * * * * * * * * *
  * Tests for Les-Houches event record. *
@@ -17,6 +24,49 @@
 
 using namespace Camgen;
 
+/* Reads the argument file into a string, decompressing it if the name ends
+ * with '.gz': */
+
+std::string file_contents(const std::string& fname)
+{
+#if HAVE_ZLIB_H
+    if(gz_ofstream::is_compressed(fname))
+    {
+        std::string result;
+        gzFile f=gzopen(fname.c_str(),"rb");
+        if(f==NULL)
+        {
+            return result;
+        }
+        char buffer[4096];
+        int n;
+        while((n=gzread(f,buffer,sizeof(buffer)))>0)
+        {
+            result.append(buffer,n);
+        }
+        gzclose(f);
+        return result;
+    }
+#endif
+    std::ifstream ifs(gz_ofstream::base_name(fname).c_str());
+    std::stringstream ss;
+    ss<<ifs.rdbuf();
+    return ss.str();
+}
+
+/* Numeric punctuation with a decimal comma, to check that the event files do
+ * not depend on the global locale: */
+
+class comma_numpunct: public std::numpunct<char>
+{
+    protected:
+
+	char do_decimal_point() const
+	{
+	    return ',';
+	}
+};
+
 int main()
 {
     typedef SM model_type;
@@ -144,6 +194,65 @@ int main()
         delete evt_gen;
         Camgen::log.enable_level=log_level::warning;
     }
+    {
+	Camgen::log.enable_level=log_level::error;
+        set_initial_state_type(initial_states::partonic);
+        set_phase_space_generator_type(phase_space_generators::recursive);
+	std::string process("e+,e- > q,qbar,Z");
+	std::string fname("test_output/LH_evt_test/ee_qqZ_sync");
+	std::string fname_async("test_output/LH_evt_test/ee_qqZ_async");
+	std::string fname_gz("test_output/LH_evt_test/ee_qqZ_gz.gz");
+        value_type E1=100;
+        value_type E2=100;
+	std::cerr<<"Checking asynchronous Les Houches event record for "<<process<<"............";
+	std::cerr.flush();
+	CM_algorithm<model_type,2,3>algo(process);
+	algo.load();
+	algo.construct_trees();
+        set_beam_energy(-1,E1);
+        set_beam_energy(-2,E2);
+        event_generator_factory<model_type,2,3,rn_engine> factory;
+        event_generator<model_type,2,3,rn_engine>* evt_gen=factory.create_generator(algo);
+        std::locale global_locale=std::locale::global(std::locale(std::locale::classic(),new comma_numpunct));
+        LH_event_stream<model_type,2,3>* lh_if=new LH_event_stream<model_type,2,3>(fname,2);
+        LH_event_stream<model_type,2,3>* lh_if_async=new LH_event_stream<model_type,2,3>(fname_async,2);
+        lh_if_async->set_asynchronous(16);
+        LH_event_stream<model_type,2,3>* lh_if_gz=new LH_event_stream<model_type,2,3>(fname_gz,2);
+        lh_if_gz->set_asynchronous();
+        for(size_type i=0;i<10*n_evts;++i)
+        {
+            evt_gen->generate();
+            lh_if->fill(evt_gen->get_event());
+            lh_if_async->fill(evt_gen->get_event());
+            lh_if_gz->fill(evt_gen->get_event());
+        }
+        lh_if->write();
+        lh_if_async->write();
+        lh_if_gz->write();
+        std::locale::global(global_locale);
+        if(file_contents(fname+".LHE").find(',')!=std::string::npos or file_contents(fname_async+".LHE").find(',')!=std::string::npos)
+        {
+            std::cerr<<"Event files written under a decimal-comma locale contain commas."<<std::endl;
+            return 1;
+        }
+        if(lh_if_async->output_events()!=lh_if->output_events() or file_contents(fname+".LHE")!=file_contents(fname_async+".LHE"))
+        {
+            std::cerr<<"Asynchronous output "<<fname_async<<".LHE differs from "<<fname<<".LHE."<<std::endl;
+            return 1;
+        }
+        std::string fname_lhe_gz=gz_ofstream::file_name(fname_gz,".LHE");
+        if(file_contents(fname+".LHE")!=file_contents(fname_lhe_gz))
+        {
+            std::cerr<<"Compressed output "<<fname_lhe_gz<<" differs from "<<fname<<".LHE."<<std::endl;
+            return 1;
+        }
+        std::cerr<<"done, files "<<fname<<".LHE, "<<fname_async<<".LHE and "<<fname_lhe_gz<<" written."<<std::endl;
+        delete lh_if;
+        delete lh_if_async;
+        delete lh_if_gz;
+        delete evt_gen;
+        Camgen::log.enable_level=log_level::warning;
+    }
 }
 
 
@@ -0,0 +1,21 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <QCDPbchcfdc_Nc6.h>
+
+namespace Camgen
+{
+    const std::size_t QCDPbchcfdc_Nc6::dimension;
+    const bool QCDPbchcfdc_Nc6::coloured;
+    const std::size_t QCDPbchcfdc_Nc6::N_c;
+    const bool QCDPbchcfdc_Nc6::continuous_helicities;
+    const bool QCDPbchcfdc_Nc6::continuous_colours;
+    const int QCDPbchcfdc_Nc6::beam_direction;
+
+    QCDPbchcfdc_Nc6::QCDPbchcfdc_Nc6(){}
+}
+
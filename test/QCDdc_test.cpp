@@ -5,10 +5,12 @@
 // see COPYING for details.
 //
 
+#include <cstdio>
 #include <QCDPbchabcc.h>
 #include <QCDPbchcfcc.h>
 #include <QCDPbchcfdc.h>
 #include <QCDPbchcfdc_clone.h>
+#include <Camgen/file_utils.h>
 #include <test_gen.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -1774,5 +1776,136 @@ int main()
 	}
 	std::cerr<<".........done."<<std::endl;
     }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+
+    process="p,p > j,j,j";
+
+    {
+	CM_algorithm<QCDPbchcfdc,2,3>algo(process);
+	algo.load();
+	algo.construct_trees();
+	process_generator<QCDPbchcfdc,2,3,std::random>* gen=test_utils::test_generator_builder<QCDPbchcfdc,2,3>::create_generator(algo.get_tree_iterator(),Ecm);
+	std::vector< std::complex<value_type> >amps;
+	std::cerr<<"Checking shared-current evaluation for "<<process<<"..........";
+	std::cerr.flush();
+	for(unsigned i=0;i<N_events/10;++i)
+	{
+	    algo.reset_process();
+	    gen->generate();
+	    std::vector< vector<value_type,4> >p(algo.N_external);
+	    for(unsigned k=0;k<algo.N_external;++k)
+	    {
+		p[k]=algo.get_phase_space(k)->momentum();
+	    }
+	    do
+	    {
+		for(unsigned k=0;k<algo.N_external;++k)
+		{
+		    algo.get_phase_space(k)->momentum()=p[k];
+		    for(unsigned c=0;c<algo.get_phase_space(k)->colour_rank();++c)
+		    {
+			algo.get_phase_space(k)->colour(c)=(i+k+c)%QCDPbchcfdc::N_c;
+		    }
+		}
+	    }
+	    while(algo.next_process());
+	    algo.evaluate_all(amps);
+	    unsigned n=0;
+	    algo.reset_process();
+	    do
+	    {
+		std::complex<value_type>amp=algo.evaluate();
+		if(!equals(amp.real(),amps[n].real()) or !equals(amp.imag(),amps[n].imag()))
+		{
+		    std::cerr<<"event "<<i<<": shared-current evaluation yields "<<amps[n]<<" instead of "<<amp<<" for subprocess "<<n<<std::endl;
+		    return 1;
+		}
+		++n;
+	    }
+	    while(algo.next_process());
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+
+    process="p,p > j,j";
+
+    {
+	file_utils::create_directory("test_output/QCDdc_test");
+	std::string filename("test_output/QCDdc_test/ppjj_trees.dat");
+	std::remove(filename.c_str());
+	CM_algorithm<QCDPbchcfdc,2,2>algo(process);
+	algo.load();
+	algo.construct_trees(filename);
+	CM_algorithm<QCDPbchcfdc,2,2>algocheck(process);
+	algocheck.load();
+	std::cerr<<"Checking process trees read from cache file for "<<process<<"..........";
+	std::cerr.flush();
+	if(!algocheck.load_trees(filename))
+	{
+	    std::cerr<<"process trees could not be read from "<<filename<<std::endl;
+	    return 1;
+	}
+	if(algo.count_all_diagrams()!=algocheck.count_all_diagrams())
+	{
+	    std::cerr<<"cached trees contain "<<algocheck.count_all_diagrams()<<" diagrams instead of "<<algo.count_all_diagrams()<<std::endl;
+	    return 1;
+	}
+	process_generator<QCDPbchcfdc,2,2,std::random>* gen=test_utils::test_generator_builder<QCDPbchcfdc,2,2>::create_generator(algo.get_tree_iterator(),Ecm);
+	for(unsigned i=0;i<N_events/10;++i)
+	{
+	    algo.reset_process();
+	    algocheck.reset_process();
+	    gen->generate();
+	    std::vector< vector<value_type,4> >p(algo.N_external);
+	    for(unsigned k=0;k<algo.N_external;++k)
+	    {
+		p[k]=algo.get_phase_space(k)->momentum();
+	    }
+	    unsigned n=0;
+	    do
+	    {
+		for(unsigned k=0;k<algo.N_external;++k)
+		{
+		    algo.get_phase_space(k)->momentum()=p[k];
+		    algocheck.get_phase_space(k)->momentum()=p[k];
+		    algocheck.get_phase_space(k)->helicity_phase(-1)=algo.get_phase_space(k)->helicity_phase(-1);
+		    algocheck.get_phase_space(k)->helicity_phase(1)=algo.get_phase_space(k)->helicity_phase(1);
+		    for(unsigned c=0;c<algo.get_phase_space(k)->colour_rank();++c)
+		    {
+			algo.get_phase_space(k)->colour(c)=(i+k+c)%QCDPbchcfdc::N_c;
+			algocheck.get_phase_space(k)->colour(c)=(i+k+c)%QCDPbchcfdc::N_c;
+		    }
+		}
+		std::complex<value_type>amp=algo.evaluate();
+		std::complex<value_type>ampcheck=algocheck.evaluate();
+		if(!equals(amp.real(),ampcheck.real()) or !equals(amp.imag(),ampcheck.imag()))
+		{
+		    std::cerr<<"event "<<i<<": cached trees yield "<<ampcheck<<" instead of "<<amp<<" for subprocess "<<n<<std::endl;
+		    return 1;
+		}
+		++n;
+		algocheck.next_process();
+	    }
+	    while(algo.next_process());
+	}
+	std::cerr<<".........done."<<std::endl;
+	delete gen;
+
+	std::cerr<<"Checking tree cache rejection after a model parameter change..........";
+	std::cerr.flush();
+	value_type alpha_s=QCDPbchcfdc::alpha_s;
+	QCDPbchcfdc::set_alpha_s((value_type)2*alpha_s);
+	bool loaded=algocheck.load_trees(filename);
+	QCDPbchcfdc::set_alpha_s(alpha_s);
+	if(loaded)
+	{
+	    std::cerr<<"tree cache file "<<filename<<" was accepted for a model with different couplings"<<std::endl;
+	    return 1;
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
 }
 
@@ -8,6 +8,9 @@
 #include <QEDPbch.h>
 #include <QEDWbch.h>
 #include <test_gen.h>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Testing facility for the computations of QED-amplitudes with Camgen. The     *
@@ -193,6 +196,86 @@ int main()
 
     random_number_stream<value_type,std::random>::reset_engine();
 
+    {
+	CM_algorithm<QEDPbch,2,2>algo(process);
+	algo.load();
+	algo.construct();
+	CM_algorithm<QEDPbch,2,2>copy(algo);
+	process_generator<QEDPbch,2,2,std::random>* gen=test_utils::test_generator_builder<QEDPbch,2,2>::create_generator(algo.get_tree_iterator(),Ecm);
+	std::cerr<<"Checking copied algorithm instance for "<<process<<"..........";
+	std::cerr.flush();
+	for(unsigned i=0;i<N_events;++i)
+	{
+	    gen->generate();
+	    copy=algo;
+	    algo.get_tree_iterator()->reset();
+	    std::complex<value_type>ampcp=copy.evaluate();
+	    if(!equals(ampcp.real(),matrix_els[i].real()))
+	    {
+		std::cerr<<"event "<<i<<": copied algorithm yields different real part of amplitude"<<std::endl;
+		return 1;
+	    }
+	    if(!equals(ampcp.imag(),matrix_els[i].imag()))
+	    {
+		std::cerr<<"event "<<i<<": copied algorithm yields different imaginary part of amplitude"<<std::endl;
+		return 1;
+	    }
+	}
+	delete gen;
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+
+#if __cplusplus >= 201103L
+    {
+	const unsigned N_threads=4;
+	CM_algorithm<QEDPbch,2,2>algo(process);
+	algo.load();
+	algo.construct();
+	std::vector< CM_algorithm<QEDPbch,2,2> >copies(N_threads,algo);
+	std::vector< std::complex<value_type> >amps(N_threads);
+	process_generator<QEDPbch,2,2,std::random>* gen=test_utils::test_generator_builder<QEDPbch,2,2>::create_generator(algo.get_tree_iterator(),Ecm);
+	std::cerr<<"Checking concurrently evaluated copies for "<<process<<"..........";
+	std::cerr.flush();
+	for(unsigned i=0;i<N_events;i+=N_threads)
+	{
+	    unsigned n=std::min(N_threads,N_events-i);
+	    for(unsigned j=0;j<n;++j)
+	    {
+		gen->generate();
+		copies[j]=algo;
+	    }
+	    std::vector<std::thread>workers;
+	    for(unsigned j=0;j<n;++j)
+	    {
+		workers.push_back(std::thread([&copies,&amps,j](){amps[j]=copies[j].evaluate();}));
+	    }
+	    for(unsigned j=0;j<n;++j)
+	    {
+		workers[j].join();
+	    }
+	    for(unsigned j=0;j<n;++j)
+	    {
+		if(!equals(amps[j].real(),matrix_els[i+j].real()))
+		{
+		    std::cerr<<"event "<<i+j<<": concurrently evaluated copy yields different real part of amplitude"<<std::endl;
+		    return 1;
+		}
+		if(!equals(amps[j].imag(),matrix_els[i+j].imag()))
+		{
+		    std::cerr<<"event "<<i+j<<": concurrently evaluated copy yields different imaginary part of amplitude"<<std::endl;
+		    return 1;
+		}
+	    }
+	}
+	delete gen;
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+#endif
+
     process="e+,e- > gamma,gamma";
 
     {
@@ -3458,6 +3458,53 @@ int main()
 	}
 	std::cerr<<".........done."<<std::endl;
     }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+
+    process="l-,l+ > l-,l+,l-,l+";
+
+    {
+	CM_algorithm<model_type,2,4>algo(process);
+	algo.load();
+	algo.construct_trees();
+	process_generator<model_type,2,4,std::random>* gen=test_utils::test_generator_builder<model_type,2,4>::create_generator(algo.get_tree_iterator(),Ecm);
+	std::vector< std::complex<value_type> >amps;
+	std::cerr<<"Checking shared-current evaluation for "<<process<<"..........";
+	std::cerr.flush();
+	for(unsigned i=0;i<N_events/10;++i)
+	{
+	    algo.reset_process();
+	    gen->generate();
+	    std::vector< vector<value_type,4> >p(algo.N_external);
+	    for(unsigned k=0;k<algo.N_external;++k)
+	    {
+		p[k]=algo.get_phase_space(k)->momentum();
+	    }
+	    do
+	    {
+		for(unsigned k=0;k<algo.N_external;++k)
+		{
+		    algo.get_phase_space(k)->momentum()=p[k];
+		}
+	    }
+	    while(algo.next_process());
+	    algo.evaluate_all(amps);
+	    unsigned n=0;
+	    algo.reset_process();
+	    do
+	    {
+		std::complex<value_type>amp=algo.evaluate();
+		if(!equals(amp.real(),amps[n].real()) or !equals(amp.imag(),amps[n].imag()))
+		{
+		    std::cerr<<"event "<<i<<": shared-current evaluation yields "<<amps[n]<<" instead of "<<amp<<" for subprocess "<<n<<std::endl;
+		    return 1;
+		}
+		++n;
+	    }
+	    while(algo.next_process());
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
     
     return 0;
 }
@@ -0,0 +1,211 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <Camgen/SM.h>
+#include <Camgen/stdrand.h>
+#include <Camgen/evtgen_fac.h>
+#include <Camgen/bin_evt_file.h>
+#include <Camgen/bin_evt_reader.h>
+#include <Camgen/evt_ostream.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Tests for binary event file output and memory-mapped reading. *
+ *                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+using namespace Camgen;
+
+template<class model_t,std::size_t N_in,std::size_t N_out>class test_output: public event_output_configuration<model_t,N_in,N_out>
+{
+    public:
+
+        typedef event_output_configuration<model_t,N_in,N_out> base_type;
+        typedef typename base_type::event_type event_type;
+
+        event_output_configuration<model_t,N_in,N_out>* clone() const
+        {
+            return new test_output(*this);
+        }
+
+        void fill(const event_type& evt){}
+
+    protected:
+
+        void add_variables(){}
+};
+
+/* Streamed event data: */
+
+template<class model_t,std::size_t N_in,std::size_t N_out>class expected_event
+{
+    public:
+
+        typedef event<model_t,N_in,N_out> event_type;
+        typedef typename event_type::value_type value_type;
+        typedef typename event_type::momentum_type momentum_type;
+
+        value_type w;
+        int proc_id;
+        momentum_type p[N_out];
+        int id[N_out];
+
+        expected_event(const event_type& evt):w(evt.w()),proc_id(evt.process_id())
+        {
+            for(std::size_t i=0;i<N_out;++i)
+            {
+                p[i]=evt.p_out(i);
+                id[i]=evt.id_out(i);
+            }
+        }
+};
+
+/* Compares the records in the argument file with the streamed events: */
+
+template<class model_t,std::size_t N_in,std::size_t N_out>bool check_file(const std::string& fname,const std::vector<expected_event<model_t,N_in,N_out> >& evts,const MC_integral<typename model_t::value_type>& xsec)
+{
+    typedef binary_event_reader<model_t,N_in,N_out> reader_type;
+    reader_type reader(fname);
+    if(!reader.is_open())
+    {
+        std::cerr<<"Failed to map file "<<fname<<'.'<<std::endl;
+        return false;
+    }
+    if(reader.size()!=evts.size())
+    {
+        std::cerr<<"File "<<fname<<" contains "<<reader.size()<<" records instead of "<<evts.size()<<'.'<<std::endl;
+        return false;
+    }
+    if(reader.cross_section().value!=xsec.value or reader.cross_section().error!=xsec.error)
+    {
+        std::cerr<<"File cross section "<<reader.cross_section()<<" not equal to "<<xsec<<'.'<<std::endl;
+        return false;
+    }
+    std::size_t n=0;
+    for(typename reader_type::const_iterator it=reader.begin();it!=reader.end();++it,++n)
+    {
+        const expected_event<model_t,N_in,N_out>& evt=evts[n];
+        if(it->w!=evt.w or it->proc_id!=evt.proc_id)
+        {
+            std::cerr<<"Record "<<n<<" has weight "<<it->w<<" and process "<<it->proc_id<<" instead of "<<evt.w<<" and "<<evt.proc_id<<'.'<<std::endl;
+            return false;
+        }
+        for(int i=1;i<=(int)N_out;++i)
+        {
+            if(it->momentum(i)!=evt.p[i-1] or it->pdg_id(i)!=evt.id[i-1])
+            {
+                std::cerr<<"Record "<<n<<" has particle "<<i<<" momentum "<<it->momentum(i)<<" instead of "<<evt.p[i-1]<<'.'<<std::endl;
+                return false;
+            }
+        }
+        if(reader.process(it->proc_id)==NULL)
+        {
+            std::cerr<<"Process "<<it->proc_id<<" of record "<<n<<" missing in process table."<<std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    typedef SM model_type;
+    typedef std::random rn_engine;
+    typedef std::size_t size_type;
+
+    license_print::disable();
+
+    file_utils::create_directory("test_output/binary_test");
+    size_type n_evts=1000;
+
+    {
+	Camgen::log.enable_level=log_level::error;
+        set_initial_state_type(initial_states::partonic);
+        set_phase_space_generator_type(phase_space_generators::recursive);
+	model_type::value_type M_h0=model_type::M_h0;
+	model_type::M_h0=200;
+	model_type::refresh_widths();
+	std::string process("h0 > e-,nu_ebar,mu+,nu_mu");
+	std::string fname("test_output/binary_test/h_WW_2l2n");
+	std::cerr<<"Checking binary event file for "<<process<<"............";
+	std::cerr.flush();
+	CM_algorithm<model_type,1,4>algo(process);
+	algo.load();
+	algo.construct();
+        process_generator_factory<model_type,1,4,rn_engine> factory;
+        process_generator<model_type,1,4,rn_engine>* proc_gen=factory.create_generator(algo.get_tree_iterator());
+        event_output_stream<model_type,1,4>* evt_os=new event_output_stream<model_type,1,4>(new binary_event_file<model_type,1,4>(fname,"test file"),new test_output<model_type,1,4>());
+        std::vector<expected_event<model_type,1,4> >evts;
+        for(size_type i=0;i<n_evts;++i)
+        {
+            proc_gen->generate();
+            if(evt_os->fill(proc_gen->get_event()))
+            {
+                evts.push_back(expected_event<model_type,1,4>(proc_gen->get_event()));
+            }
+        }
+        MC_integral<model_type::value_type>xsec=proc_gen->get_event().xsec();
+        evt_os->write();
+        delete evt_os;
+        if(!check_file(fname+".evt",evts,xsec))
+        {
+            return 1;
+        }
+        std::cerr<<"done, file "<<fname<<".evt written."<<std::endl;
+        delete proc_gen;
+	model_type::M_h0=M_h0;
+	model_type::refresh_widths();
+        Camgen::log.enable_level=log_level::warning;
+    }
+
+    {
+	Camgen::log.enable_level=log_level::error;
+        set_initial_state_type(initial_states::partonic);
+        set_phase_space_generator_type(phase_space_generators::recursive);
+	std::string process("e+,e- > l+,l-");
+	std::string fname("test_output/binary_test/ee_ll");
+	std::cerr<<"Checking binary event file for "<<process<<"............";
+	std::cerr.flush();
+	CM_algorithm<model_type,2,2>algo(process);
+	algo.load();
+	algo.construct_trees();
+        double E1_default=first_beam_energy();
+        double E2_default=second_beam_energy();
+        set_beam_energy(-1,100);
+        set_beam_energy(-2,100);
+        event_generator_factory<model_type,2,2,rn_engine> factory;
+        event_generator<model_type,2,2,rn_engine>* evt_gen=factory.create_generator(algo);
+        event_output_stream<model_type,2,2>* evt_os=new event_output_stream<model_type,2,2>(new binary_event_file<model_type,2,2>(fname,"test file"),new test_output<model_type,2,2>());
+        std::vector<expected_event<model_type,2,2> >evts;
+        for(size_type i=0;i<n_evts;++i)
+        {
+            evt_gen->generate();
+            if(evt_os->fill(evt_gen->get_event()))
+            {
+                evts.push_back(expected_event<model_type,2,2>(evt_gen->get_event()));
+            }
+        }
+        MC_integral<model_type::value_type>xsec=evt_gen->get_event().xsec();
+        evt_os->write();
+        delete evt_os;
+        if(!check_file(fname+".evt",evts,xsec))
+        {
+            return 1;
+        }
+        binary_event_reader<model_type,2,2> reader(fname+".evt");
+        if(reader.processes()<2)
+        {
+            std::cerr<<"Process table contains "<<reader.processes()<<" subprocesses."<<std::endl;
+            return 1;
+        }
+        std::cerr<<"done, file "<<fname<<".evt written."<<std::endl;
+        delete evt_gen;
+        set_beam_energy(-1,E1_default);
+        set_beam_energy(-2,E2_default);
+        Camgen::log.enable_level=log_level::warning;
+    }
+}
+
@@ -0,0 +1,285 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <cstdio>
+#include <ctime>
+#include <QCDPbchcfdc.h>
+#include <QCDPbchabdc.h>
+#include <Camgen/col_matrix.h>
+#include <Camgen/QCD_cols.h>
+#include <Camgen/file_utils.h>
+#include <test_gen.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Testing facility for the colour-ordered evaluation of multi-gluon amplitudes. *
+ * The colour matrix entries and the cache file are checked, the colour-summed  *
+ * squared amplitudes of the Berends-Giele recursion are compared to the        *
+ * explicit colour summation in the colour-flow and adjoint QCD models, and the *
+ * colour_ordered process generator mode is checked and timed against colour    *
+ * flow sampling.                                                                *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+using namespace Camgen;
+
+int main()
+{
+    typedef QCDPbchcfdc::value_type value_type;
+
+    license_print::disable();
+    Camgen::log.enable_level=log_level::error;
+
+    unsigned N_events=100;
+    value_type Ecm=100;
+    value_type N=QCDPbchcfdc::N_c;
+
+    std::cout<<"----------------------------------------------------------"<<std::endl;
+    std::cout<<"testing colour-matrix summation of gluon amplitudes......."<<std::endl;
+    std::cout<<"----------------------------------------------------------"<<std::endl;
+
+    file_utils::create_directory("test_output/col_matrix_test");
+
+    {
+	std::cerr<<"Checking colour matrix for 3 gluons..........";
+	std::cerr.flush();
+	colour_matrix<value_type>C(3,N);
+	if(C.size()!=2)
+	{
+	    std::cerr<<"colour matrix has dimension "<<C.size()<<" instead of 2"<<std::endl;
+	    return 1;
+	}
+	if(!equals(C(0,0),N*N*N) or !equals(C(1,1),N*N*N) or !equals(C(0,1),N) or !equals(C(1,0),N))
+	{
+	    std::cerr<<"invalid colour matrix entries encountered"<<std::endl;
+	    return 1;
+	}
+	if(C.basis_size()!=1 or !equals(C.basis_entry(0,0),2*N*(N*N-1)))
+	{
+	    std::cerr<<"invalid Kleiss-Kuijf basis colour matrix encountered"<<std::endl;
+	    return 1;
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    {
+	std::cerr<<"Checking colour matrix cache file for 5 gluons..........";
+	std::cerr.flush();
+	std::string filename("test_output/col_matrix_test/ggggg.dat");
+	std::remove(filename.c_str());
+	colour_matrix<value_type>C1(5,N,filename);
+	colour_matrix<value_type>C2(5,N);
+	if(!C2.load(filename))
+	{
+	    std::cerr<<"colour matrix could not be read from "<<filename<<std::endl;
+	    return 1;
+	}
+	if(C2.size()!=24 or C2.basis_size()!=6)
+	{
+	    std::cerr<<"colour matrix has dimensions "<<C2.size()<<","<<C2.basis_size()<<" instead of 24,6"<<std::endl;
+	    return 1;
+	}
+	for(unsigned i=0;i<C1.size();++i)
+	{
+	    for(unsigned j=0;j<C1.size();++j)
+	    {
+		if(!equals(C1(i,j),C2(i,j)))
+		{
+		    std::cerr<<"colour matrix entry ("<<i<<","<<j<<") differs after reading from file"<<std::endl;
+		    return 1;
+		}
+	    }
+	}
+	for(unsigned i=0;i<C1.basis_size();++i)
+	{
+	    for(unsigned j=0;j<C1.basis_size();++j)
+	    {
+		if(!equals(C1.basis_entry(i,j),C2.basis_entry(i,j)))
+		{
+		    std::cerr<<"basis colour matrix entry ("<<i<<","<<j<<") differs after reading from file"<<std::endl;
+		    return 1;
+		}
+	    }
+	}
+	colour_matrix<value_type>C3(5,N+1);
+	if(C3.load(filename))
+	{
+	    std::cerr<<"colour matrix with different number of colours read from "<<filename<<std::endl;
+	    return 1;
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
+
+
+    std::string process="g,g > g,g";
+    {
+	CM_algorithm<QCDPbchcfdc,2,2>algo(process);
+	algo.load();
+	algo.construct();
+	process_generator<QCDPbchcfdc,2,2,std::random>* gen=test_utils::test_generator_builder<QCDPbchcfdc,2,2>::create_generator(algo.get_tree_iterator(),Ecm);
+	colour_matrix_algorithm<QCDPbchcfdc,2,2>cmalgo(algo,N);
+
+	std::cerr<<"Checking colour-ordered recursion against explicit colour sum for "<<process<<"..........";
+	std::cerr.flush();
+	for(unsigned i=0;i<N_events;++i)
+	{
+	    gen->generate();
+	    value_type M2=algo.evaluate_colour_sum();
+	    value_type M2check=cmalgo.evaluate();
+	    if(!equals(M2,M2check))
+	    {
+		std::cerr<<"event "<<i<<": colour-ordered recursion yields "<<M2check<<" instead of "<<M2<<std::endl;
+		return 1;
+	    }
+	}
+	std::cerr<<".........done."<<std::endl;
+	delete gen;
+
+	std::cerr<<"Checking gluon number limit for "<<process<<"..........";
+	std::cerr.flush();
+	colour_matrix_algorithm<QCDPbchcfdc,2,2>::max_gluons=3;
+	colour_matrix_algorithm<QCDPbchcfdc,2,2>cmalgo2(algo,N);
+	colour_matrix_algorithm<QCDPbchcfdc,2,2>::max_gluons=7;
+	if(cmalgo2.valid())
+	{
+	    std::cerr<<"colour matrix constructed beyond the maximal number of gluons"<<std::endl;
+	    return 1;
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+
+    process="g,g > g,g,g";
+    {
+	CM_algorithm<QCDPbchcfdc,2,3>algo(process);
+	algo.load();
+	algo.construct();
+	process_generator<QCDPbchcfdc,2,3,std::random>* gen=test_utils::test_generator_builder<QCDPbchcfdc,2,3>::create_generator(algo.get_tree_iterator(),Ecm);
+	colour_matrix_algorithm<QCDPbchcfdc,2,3>cmalgo(algo,N,"test_output/col_matrix_test/ggggg.dat");
+
+	std::cerr<<"Checking colour-ordered recursion against explicit colour sum for "<<process<<"..........";
+	std::cerr.flush();
+	for(unsigned i=0;i<N_events;++i)
+	{
+	    gen->generate();
+	    value_type M2=algo.evaluate_colour_sum();
+	    value_type M2check=cmalgo.evaluate();
+	    if(!equals(M2,M2check))
+	    {
+		std::cerr<<"event "<<i<<": colour-ordered recursion yields "<<M2check<<" instead of "<<M2<<std::endl;
+		return 1;
+	    }
+	}
+	std::cerr<<".........done."<<std::endl;
+	delete gen;
+    }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+
+    process="g,g > g,g,g";
+    {
+	CM_algorithm<QCDPbchabdc,2,3>algo(process);
+	algo.load();
+	algo.construct();
+	process_generator<QCDPbchabdc,2,3,std::random>* gen=test_utils::test_generator_builder<QCDPbchabdc,2,3>::create_generator(algo.get_tree_iterator(),Ecm);
+	colour_matrix_algorithm<QCDPbchabdc,2,3>cmalgo(algo.get_tree_iterator(),N);
+
+	std::cerr<<"Checking colour-ordered recursion against adjoint colour and helicity sum for "<<process<<"..........";
+	std::cerr.flush();
+	std::bitset<5>summed_spins;
+	summed_spins.set();
+	for(unsigned i=0;i<N_events/10;++i)
+	{
+	    gen->generate();
+	    value_type M2=algo.evaluate_colour_sum();
+	    value_type M2check=cmalgo.evaluate();
+	    if(!equals(M2,M2check))
+	    {
+		std::cerr<<"event "<<i<<": colour-ordered recursion yields "<<M2check<<" instead of "<<M2<<std::endl;
+		return 1;
+	    }
+	    algo.sum_spins();
+	    algo.sum_colours();
+	    M2=algo.evaluate_sum();
+	    M2check=cmalgo.evaluate(summed_spins);
+	    algo.nsum_spins();
+	    algo.nsum_colours();
+	    if(!equals(M2,M2check))
+	    {
+		std::cerr<<"event "<<i<<": helicity-summed colour-ordered recursion yields "<<M2check<<" instead of "<<M2<<std::endl;
+		return 1;
+	    }
+	}
+	std::cerr<<".........done."<<std::endl;
+	delete gen;
+    }
+
+    random_number_stream<value_type,std::random>::reset_engine();
+
+    process="g,g > g,g,g";
+    {
+	CM_algorithm<QCDPbchcfdc,2,3>algo(process);
+	algo.load();
+	algo.construct();
+	process_generator<QCDPbchcfdc,2,3,std::random>* gen=test_utils::test_generator_builder<QCDPbchcfdc,2,3>::create_generator(algo.get_tree_iterator(),Ecm,colour_generators::colour_ordered);
+
+	std::cerr<<"Checking colour-ordered process generator mode for "<<process<<"..........";
+	std::cerr.flush();
+	if(gen->get_colour_generator()->type()!="colour-ordered sum")
+	{
+	    std::cerr<<"colour generator type "<<gen->get_colour_generator()->type()<<" encountered"<<std::endl;
+	    return 1;
+	}
+	for(unsigned i=0;i<N_events;++i)
+	{
+	    gen->generate();
+	    value_type M2=algo.evaluate_colour_sum();
+	    if(!equals(M2,gen->matrix_element()))
+	    {
+		std::cerr<<"event "<<i<<": colour-ordered generator yields "<<gen->matrix_element()<<" instead of "<<M2<<std::endl;
+		return 1;
+	    }
+	}
+	std::cerr<<".........done."<<std::endl;
+
+	/* Cost of the exact colour sum against the cost of reaching a 1%
+	 * colour-sum estimate by colour flow sampling at a fixed point: */
+
+	std::cerr<<"Timing colour-ordered recursion against colour flow sampling for "<<process<<"..........";
+	std::cerr.flush();
+	colour_matrix_algorithm<QCDPbchcfdc,2,3>cmalgo(algo,N);
+	value_type M2=cmalgo.evaluate();
+	unsigned N_rep=1000;
+	std::clock_t t0=std::clock();
+	for(unsigned n=0;n<N_rep;++n)
+	{
+	    cmalgo.evaluate();
+	}
+	std::clock_t t1=std::clock();
+	MC_integrator<value_type>* colgen=new MC_generator_wrapper<value_type>(colour_flow_QCD<value_type,2,3,3,std::random,false>::create_instance<QCDPbchcfdc>(algo.get_tree_iterator()));
+	unsigned N_samples=10000;
+	for(unsigned n=0;n<N_samples;++n)
+	{
+	    colgen->generate();
+	    colgen->integrand()=algo.evaluate2();
+	    colgen->refresh_cross_section();
+	}
+	std::clock_t t2=std::clock();
+	value_type x=colgen->cross_section().value;
+	value_type dx=colgen->cross_section().error;
+	if(std::abs(x-M2)>5*dx)
+	{
+	    std::cerr<<"colour flow sampling estimate "<<x<<" +/- "<<dx<<" incompatible with colour sum "<<M2<<std::endl;
+	    return 1;
+	}
+	value_type t_ordered=(value_type)(t1-t0)/CLOCKS_PER_SEC/N_rep;
+	value_type t_flow=(value_type)(t2-t1)/CLOCKS_PER_SEC*(dx/(0.01*M2))*(dx/(0.01*M2));
+	std::cerr<<t_ordered<<" s exact vs. "<<t_flow<<" s for 1% sampled"<<std::endl;
+	delete colgen;
+	delete gen;
+    }
+}
@@ -0,0 +1,151 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <Camgen/SM.h>
+#include <Camgen/stdrand.h>
+#include <Camgen/evtgen_fac.h>
+#include <Camgen/col_file.h>
+#include <Camgen/col_reader.h>
+#include <Camgen/evt_ostream.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Tests for columnar event output and column-wise reading.  *
+ *                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+using namespace Camgen;
+
+template<class model_t,std::size_t N_in,std::size_t N_out>class test_output: public event_output_configuration<model_t,N_in,N_out>
+{
+    public:
+
+        typedef event_output_configuration<model_t,N_in,N_out> base_type;
+        typedef typename base_type::event_type event_type;
+        typedef typename base_type::value_type value_type;
+        typedef typename base_type::momentum_type momentum_type;
+
+        momentum_type p2;
+        value_type alpha12;
+        bool hard;
+
+        event_output_configuration<model_t,N_in,N_out>* clone() const
+        {
+            return new test_output(*this);
+        }
+
+        void fill(const event_type& evt)
+        {
+            p2=evt.p(2);
+            alpha12=evt.alpha(1,2);
+            hard=(p2[0]>50);
+        }
+
+    protected:
+
+        void add_variables()
+        {
+            this->add_variable(p2,"p2");
+            this->add_variable(alpha12,"alpha12");
+            this->add_variable(hard,"hard");
+        }
+};
+
+int main()
+{
+    typedef SM model_type;
+    typedef std::random rn_engine;
+    typedef std::size_t size_type;
+    typedef model_type::value_type value_type;
+
+    license_print::disable();
+
+    file_utils::create_directory("test_output/column_test");
+    size_type n_evts=1000;
+
+    {
+	Camgen::log.enable_level=log_level::error;
+        set_initial_state_type(initial_states::partonic);
+        set_phase_space_generator_type(phase_space_generators::recursive);
+	value_type M_h0=model_type::M_h0;
+	model_type::M_h0=200;
+	model_type::refresh_widths();
+	std::string process("h0 > e-,nu_ebar,mu+,nu_mu");
+	std::string fname("test_output/column_test/h_WW_2l2n");
+	std::cerr<<"Checking column file for "<<process<<"............";
+	std::cerr.flush();
+	CM_algorithm<model_type,1,4>algo(process);
+	algo.load();
+	algo.construct();
+        process_generator_factory<model_type,1,4,rn_engine> factory;
+        process_generator<model_type,1,4,rn_engine>* proc_gen=factory.create_generator(algo.get_tree_iterator());
+        column_file<model_type,1,4>* output=new column_file<model_type,1,4>(fname,"test file");
+        output->set_row_group_size(100);
+        event_output_stream<model_type,1,4>* evt_os=new event_output_stream<model_type,1,4>(output,new test_output<model_type,1,4>());
+        std::vector<value_type>w,p2_0,p2_3,alpha12;
+        std::vector<int>proc_id;
+        std::vector<unsigned char>hard;
+        for(size_type i=0;i<n_evts;++i)
+        {
+            proc_gen->generate();
+            const event<model_type,1,4>& evt=proc_gen->get_event();
+            if(evt_os->fill(evt))
+            {
+                w.push_back(evt.w());
+                p2_0.push_back(evt.p(2)[0]);
+                p2_3.push_back(evt.p(2)[3]);
+                alpha12.push_back(evt.alpha(1,2));
+                proc_id.push_back(evt.process_id());
+                hard.push_back(evt.p(2)[0]>50);
+            }
+        }
+        evt_os->write();
+        delete evt_os;
+
+        column_reader<value_type> reader(fname+".col");
+        std::vector<value_type>col_w,col_p2_0,col_p2_3,col_alpha12,group;
+        std::vector<int>col_proc_id;
+        std::vector<unsigned char>col_hard;
+        if(!reader.is_open() or reader.rows()!=w.size() or reader.row_groups()!=(w.size()+99)/100 or reader.description()!="test file")
+        {
+            std::cerr<<"File "<<fname<<".col holds "<<reader.rows()<<" rows in "<<reader.row_groups()<<" groups instead of "<<w.size()<<'.'<<std::endl;
+            return 1;
+        }
+        if(reader.column_index("p2[0]")<0 or reader.column_index("p2")>=0 or reader.read("weight",col_proc_id) or reader.read("missing",col_w))
+        {
+            std::cerr<<"Column lookup in "<<fname<<".col failed."<<std::endl;
+            return 1;
+        }
+        reader.read("weight",col_w);
+        reader.read("p2[0]",col_p2_0);
+        reader.read("p2[3]",col_p2_3);
+        reader.read("alpha12",col_alpha12);
+        reader.read("proc_id",col_proc_id);
+        reader.read("hard",col_hard);
+        if(col_w!=w or col_p2_0!=p2_0 or col_p2_3!=p2_3 or col_alpha12!=alpha12 or col_proc_id!=proc_id or col_hard!=hard)
+        {
+            std::cerr<<"Columns in "<<fname<<".col differ from the streamed events."<<std::endl;
+            return 1;
+        }
+        size_type n=0;
+        for(size_type g=0;g<reader.row_groups();++g)
+        {
+            reader.read("alpha12",g,group);
+            if(group.size()!=reader.row_group_size(g) or !std::equal(group.begin(),group.end(),alpha12.begin()+n))
+            {
+                std::cerr<<"Row group "<<g<<" of "<<fname<<".col differs from the streamed events."<<std::endl;
+                return 1;
+            }
+            n+=group.size();
+        }
+        std::cerr<<"done, file "<<fname<<".col written."<<std::endl;
+        delete proc_gen;
+	model_type::M_h0=M_h0;
+	model_type::refresh_widths();
+        Camgen::log.enable_level=log_level::warning;
+    }
+}
+
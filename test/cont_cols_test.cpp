@@ -274,8 +274,8 @@ namespace Camgen
 
 		    reset(0);
 		    check=cf_tens[0];
-		    adj_eval_type::first((const adj_value_type&)factor,(const std::vector<const adj_value_type*>&)couplings,(std::vector<adj_iterator>&)adj_iters,(const std::vector<const adj_momentum_type*>&)momenta);
-		    cf_eval_type::first((const cf_value_type&)factor,(const std::vector<const cf_value_type*>&)couplings,(std::vector<cf_iterator>&)cf_iters,(const std::vector<const cf_momentum_type*>&)momenta);
+		    adj_eval_type::first((const adj_value_type&)factor,(const adj_value_type* const*)&couplings[0],(adj_iterator*)&adj_iters[0],(const adj_momentum_type* const*)&momenta[0]);
+		    cf_eval_type::first((const cf_value_type&)factor,(const cf_value_type* const*)&couplings[0],(cf_iterator*)&cf_iters[0],(const cf_momentum_type* const*)&momenta[0]);
 		    cf_convert(check.begin(),0);
 		    if(!equal_sequences(check,cf_tens[0]))
 		    {
@@ -287,8 +287,8 @@ namespace Camgen
 
 		    reset(1);
 		    check=cf_tens[1];
-		    adj_eval_type::second((const adj_value_type&)factor,(const std::vector<const adj_value_type*>&)couplings,(std::vector<adj_iterator>&)adj_iters,(const std::vector<const adj_momentum_type*>&)momenta);
-		    cf_eval_type::second((const cf_value_type&)factor,(const std::vector<const cf_value_type*>&)couplings,(std::vector<cf_iterator>&)cf_iters,(const std::vector<const cf_momentum_type*>&)momenta);
+		    adj_eval_type::second((const adj_value_type&)factor,(const adj_value_type* const*)&couplings[0],(adj_iterator*)&adj_iters[0],(const adj_momentum_type* const*)&momenta[0]);
+		    cf_eval_type::second((const cf_value_type&)factor,(const cf_value_type* const*)&couplings[0],(cf_iterator*)&cf_iters[0],(const cf_momentum_type* const*)&momenta[0]);
 		    cf_convert(check.begin(),1);
 		    if(!equal_sequences(check,cf_tens[1]))
 		    {
@@ -300,8 +300,8 @@ namespace Camgen
 
 		    reset(2);
 		    check=cf_tens[2];
-		    adj_eval_type::third((const adj_value_type&)factor,(const std::vector<const adj_value_type*>&)couplings,(std::vector<adj_iterator>&)adj_iters,(const std::vector<const adj_momentum_type*>&)momenta);
-		    cf_eval_type::third((const cf_value_type&)factor,(const std::vector<const cf_value_type*>&)couplings,(std::vector<cf_iterator>&)cf_iters,(const std::vector<const cf_momentum_type*>&)momenta);
+		    adj_eval_type::third((const adj_value_type&)factor,(const adj_value_type* const*)&couplings[0],(adj_iterator*)&adj_iters[0],(const adj_momentum_type* const*)&momenta[0]);
+		    cf_eval_type::third((const cf_value_type&)factor,(const cf_value_type* const*)&couplings[0],(cf_iterator*)&cf_iters[0],(const cf_momentum_type* const*)&momenta[0]);
 		    cf_convert(check.begin(),2);
 		    if(!equal_sequences(check,cf_tens[2]))
 		    {
@@ -313,8 +313,8 @@ namespace Camgen
 
 		    reset(3);
 		    check=cf_tens[3];
-		    adj_eval_type::fourth((const adj_value_type&)factor,(const std::vector<const adj_value_type*>&)couplings,(std::vector<adj_iterator>&)adj_iters,(const std::vector<const adj_momentum_type*>&)momenta);
-		    cf_eval_type::fourth((const cf_value_type&)factor,(const std::vector<const cf_value_type*>&)couplings,(std::vector<cf_iterator>&)cf_iters,(const std::vector<const cf_momentum_type*>&)momenta);
+		    adj_eval_type::fourth((const adj_value_type&)factor,(const adj_value_type* const*)&couplings[0],(adj_iterator*)&adj_iters[0],(const adj_momentum_type* const*)&momenta[0]);
+		    cf_eval_type::fourth((const cf_value_type&)factor,(const cf_value_type* const*)&couplings[0],(cf_iterator*)&cf_iters[0],(const cf_momentum_type* const*)&momenta[0]);
 		    cf_convert(check.begin(),3);
 		    if(!equal_sequences(check,cf_tens[3]))
 		    {
@@ -354,32 +354,32 @@ namespace Camgen
 		    value_type factor(gen(0,1),gen(0,1));
 
 		    reset(0);
-		    eval_type::first(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)adj_iters,(const std::vector<const momentum_type*>&)momenta);
-		    check_eval_type::first(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)cf_iters,(const std::vector<const momentum_type*>&)momenta);
+		    eval_type::first(factor,(const value_type* const*)&couplings[0],(iterator*)&adj_iters[0],(const momentum_type* const*)&momenta[0]);
+		    check_eval_type::first(factor,(const value_type* const*)&couplings[0],(iterator*)&cf_iters[0],(const momentum_type* const*)&momenta[0]);
 		    if(!equal_sequences(adj_tens[0],cf_tens[0]))
 		    {
 			std::cerr<<"Incorrectly specialised 1st recursive relation."<<std::endl;
 			return false;
 		    }
 		    reset(1);
-		    eval_type::second(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)adj_iters,(const std::vector<const momentum_type*>&)momenta);
-		    check_eval_type::second(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)cf_iters,(const std::vector<const momentum_type*>&)momenta);
+		    eval_type::second(factor,(const value_type* const*)&couplings[0],(iterator*)&adj_iters[0],(const momentum_type* const*)&momenta[0]);
+		    check_eval_type::second(factor,(const value_type* const*)&couplings[0],(iterator*)&cf_iters[0],(const momentum_type* const*)&momenta[0]);
 		    if(!equal_sequences(adj_tens[1],cf_tens[1]))
 		    {
 			std::cerr<<"Incorrectly specialised 2nd recursive relation."<<std::endl;
 			return false;
 		    }
 		    reset(2);
-		    eval_type::third(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)adj_iters,(const std::vector<const momentum_type*>&)momenta);
-		    check_eval_type::third(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)cf_iters,(const std::vector<const momentum_type*>&)momenta);
+		    eval_type::third(factor,(const value_type* const*)&couplings[0],(iterator*)&adj_iters[0],(const momentum_type* const*)&momenta[0]);
+		    check_eval_type::third(factor,(const value_type* const*)&couplings[0],(iterator*)&cf_iters[0],(const momentum_type* const*)&momenta[0]);
 		    if(!equal_sequences(adj_tens[2],cf_tens[2]))
 		    {
 			std::cerr<<"Incorrectly specialised 3rd recursive relation."<<std::endl;
 			return false;
 		    }
 		    reset(3);
-		    eval_type::fourth(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)adj_iters,(const std::vector<const momentum_type*>&)momenta);
-		    check_eval_type::fourth(factor,(const std::vector<const value_type*>&)couplings,(std::vector<iterator>&)cf_iters,(const std::vector<const momentum_type*>&)momenta);
+		    eval_type::fourth(factor,(const value_type* const*)&couplings[0],(iterator*)&adj_iters[0],(const momentum_type* const*)&momenta[0]);
+		    check_eval_type::fourth(factor,(const value_type* const*)&couplings[0],(iterator*)&cf_iters[0],(const momentum_type* const*)&momenta[0]);
 		    if(!equal_sequences(adj_tens[3],cf_tens[3]))
 		    {
 			std::cerr<<"Incorrectly specialised 4th recursive relation."<<std::endl;
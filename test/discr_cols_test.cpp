@@ -13,6 +13,7 @@
 #include <Camgen/Minkowski.h>
 #include <Camgen/adjoint.h>
 #include <Camgen/col_flow.h>
+#include <Camgen/iter_mask.h>
 #include <Camgen/ssss.h>
 #include <Camgen/vvv.h>
 #include <Camgen/vvvv.h>
@@ -276,15 +277,15 @@ namespace Camgen
 
 			/* First recursive relation check: */
 
-			std::set<typename discr_eval_type::iterator>iterset;
+			iterator_mask<typename discr_eval_type::iterator>iterset;
 			for(;discr_iters[1]!=discr_tens[1].end();discr_iters[1]+=st_sizes[1])
 			{
 			    fill(1);
 			    for(;discr_iters[2]!=discr_tens[2].end();discr_iters[2]+=st_sizes[2])
 			    {
 				fill(2);
-				cont_eval_type::first((const typename cont_eval_type::value_type)factor,(const std::vector<const typename cont_eval_type::value_type*>&)couplings,(std::vector<typename cont_eval_type::iterator>&)cont_iters,(const std::vector<const typename cont_eval_type::momentum_type*>&)momenta);
-				discr_eval_type::first((const typename discr_eval_type::value_type)factor,(const std::vector<const typename discr_eval_type::value_type*>&)couplings,(std::vector<typename discr_eval_type::iterator>&)discr_iters,(const std::vector<const typename discr_eval_type::momentum_type*>&)momenta,iterset);
+				cont_eval_type::first((const typename cont_eval_type::value_type)factor,(const typename cont_eval_type::value_type* const*)&couplings[0],(typename cont_eval_type::iterator*)&cont_iters[0],(const typename cont_eval_type::momentum_type* const*)&momenta[0]);
+				discr_eval_type::first((const typename discr_eval_type::value_type)factor,(const typename discr_eval_type::value_type* const*)&couplings[0],(typename discr_eval_type::iterator*)&discr_iters[0],(const typename discr_eval_type::momentum_type* const*)&momenta[0],iterset);
 				if(!equal_sequences(cont_tens[0],discr_tens[0]))
 				{
 				    std::cerr<<"Mismatch continuous<->discrete colour flow vertices in 1st recursive relation."<<std::endl;
@@ -309,8 +310,8 @@ namespace Camgen
 			    for(;discr_iters[2]!=discr_tens[2].end();discr_iters[2]+=st_sizes[2])
 			    {
 				fill(2);
-				cont_eval_type::second((const typename cont_eval_type::value_type)factor,(const std::vector<const typename cont_eval_type::value_type*>&)couplings,(std::vector<typename cont_eval_type::iterator>&)cont_iters,(const std::vector<const typename cont_eval_type::momentum_type*>&)momenta);
-				discr_eval_type::second((const typename discr_eval_type::value_type)factor,(const std::vector<const typename discr_eval_type::value_type*>&)couplings,(std::vector<typename discr_eval_type::iterator>&)discr_iters,(const std::vector<const typename discr_eval_type::momentum_type*>&)momenta,iterset);
+				cont_eval_type::second((const typename cont_eval_type::value_type)factor,(const typename cont_eval_type::value_type* const*)&couplings[0],(typename cont_eval_type::iterator*)&cont_iters[0],(const typename cont_eval_type::momentum_type* const*)&momenta[0]);
+				discr_eval_type::second((const typename discr_eval_type::value_type)factor,(const typename discr_eval_type::value_type* const*)&couplings[0],(typename discr_eval_type::iterator*)&discr_iters[0],(const typename discr_eval_type::momentum_type* const*)&momenta[0],iterset);
 				if(!equal_sequences(cont_tens[1],discr_tens[1]))
 				{
 				    std::cerr<<"Mismatch continuous<->discrete colour flow vertices in 2nd recursive relation."<<std::endl;
@@ -335,8 +336,8 @@ namespace Camgen
 			    for(;discr_iters[1]!=discr_tens[1].end();discr_iters[1]+=st_sizes[1])
 			    {
 				fill(1);
-				cont_eval_type::third((const typename cont_eval_type::value_type)factor,(const std::vector<const typename cont_eval_type::value_type*>&)couplings,(std::vector<typename cont_eval_type::iterator>&)cont_iters,(const std::vector<const typename cont_eval_type::momentum_type*>&)momenta);
-				discr_eval_type::third((const typename discr_eval_type::value_type)factor,(const std::vector<const typename discr_eval_type::value_type*>&)couplings,(std::vector<typename discr_eval_type::iterator>&)discr_iters,(const std::vector<const typename discr_eval_type::momentum_type*>&)momenta,iterset);
+				cont_eval_type::third((const typename cont_eval_type::value_type)factor,(const typename cont_eval_type::value_type* const*)&couplings[0],(typename cont_eval_type::iterator*)&cont_iters[0],(const typename cont_eval_type::momentum_type* const*)&momenta[0]);
+				discr_eval_type::third((const typename discr_eval_type::value_type)factor,(const typename discr_eval_type::value_type* const*)&couplings[0],(typename discr_eval_type::iterator*)&discr_iters[0],(const typename discr_eval_type::momentum_type* const*)&momenta[0],iterset);
 				if(!equal_sequences(cont_tens[2],discr_tens[2]))
 				{
 				    std::cerr<<"Mismatch continuous<->discrete colour flow vertices in 3rd recursive relation."<<std::endl;
@@ -369,7 +370,7 @@ namespace Camgen
 
 			/* First recursive relation check: */
 
-			std::set<typename discr_eval_type::iterator>iterset;
+			iterator_mask<typename discr_eval_type::iterator>iterset;
 			for(;discr_iters[1]!=discr_tens[1].end();discr_iters[1]+=st_sizes[1])
 			{
 			    fill(1);
@@ -379,8 +380,8 @@ namespace Camgen
 				for(;discr_iters[3]!=discr_tens[3].end();discr_iters[3]+=st_sizes[3])
 				{
 				    fill(3);
-				    cont_eval_type::first((const typename cont_eval_type::value_type)factor,(const std::vector<const typename cont_eval_type::value_type*>&)couplings,(std::vector<typename cont_eval_type::iterator>&)cont_iters,(const std::vector<const typename cont_eval_type::momentum_type*>&)momenta);
-				    discr_eval_type::first((const typename discr_eval_type::value_type)factor,(const std::vector<const typename discr_eval_type::value_type*>&)couplings,(std::vector<typename discr_eval_type::iterator>&)discr_iters,(const std::vector<const typename discr_eval_type::momentum_type*>&)momenta,iterset);
+				    cont_eval_type::first((const typename cont_eval_type::value_type)factor,(const typename cont_eval_type::value_type* const*)&couplings[0],(typename cont_eval_type::iterator*)&cont_iters[0],(const typename cont_eval_type::momentum_type* const*)&momenta[0]);
+				    discr_eval_type::first((const typename discr_eval_type::value_type)factor,(const typename discr_eval_type::value_type* const*)&couplings[0],(typename discr_eval_type::iterator*)&discr_iters[0],(const typename discr_eval_type::momentum_type* const*)&momenta[0],iterset);
 				    if(!equal_sequences(cont_tens[0],discr_tens[0]))
 				    {
 					std::cerr<<"Mismatch continuous<->discrete colour flow vertices in 1st recursive relation."<<std::endl;
@@ -412,8 +413,8 @@ namespace Camgen
 				for(;discr_iters[3]!=discr_tens[3].end();discr_iters[3]+=st_sizes[3])
 				{
 				    fill(3);
-				    cont_eval_type::second((const typename cont_eval_type::value_type)factor,(const std::vector<const typename cont_eval_type::value_type*>&)couplings,(std::vector<typename cont_eval_type::iterator>&)cont_iters,(const std::vector<const typename cont_eval_type::momentum_type*>&)momenta);
-				    discr_eval_type::second((const typename discr_eval_type::value_type)factor,(const std::vector<const typename discr_eval_type::value_type*>&)couplings,(std::vector<typename discr_eval_type::iterator>&)discr_iters,(const std::vector<const typename discr_eval_type::momentum_type*>&)momenta,iterset);
+				    cont_eval_type::second((const typename cont_eval_type::value_type)factor,(const typename cont_eval_type::value_type* const*)&couplings[0],(typename cont_eval_type::iterator*)&cont_iters[0],(const typename cont_eval_type::momentum_type* const*)&momenta[0]);
+				    discr_eval_type::second((const typename discr_eval_type::value_type)factor,(const typename discr_eval_type::value_type* const*)&couplings[0],(typename discr_eval_type::iterator*)&discr_iters[0],(const typename discr_eval_type::momentum_type* const*)&momenta[0],iterset);
 				    if(!equal_sequences(cont_tens[1],discr_tens[1]))
 				    {
 					std::cerr<<"Mismatch continuous<->discrete colour flow vertices in 2nd recursive relation."<<std::endl;
@@ -445,8 +446,8 @@ namespace Camgen
 				for(;discr_iters[3]!=discr_tens[3].end();discr_iters[3]+=st_sizes[3])
 				{
 				    fill(3);
-				    cont_eval_type::third((const typename cont_eval_type::value_type)factor,(const std::vector<const typename cont_eval_type::value_type*>&)couplings,(std::vector<typename cont_eval_type::iterator>&)cont_iters,(const std::vector<const typename cont_eval_type::momentum_type*>&)momenta);
-				    discr_eval_type::third((const typename discr_eval_type::value_type)factor,(const std::vector<const typename discr_eval_type::value_type*>&)couplings,(std::vector<typename discr_eval_type::iterator>&)discr_iters,(const std::vector<const typename discr_eval_type::momentum_type*>&)momenta,iterset);
+				    cont_eval_type::third((const typename cont_eval_type::value_type)factor,(const typename cont_eval_type::value_type* const*)&couplings[0],(typename cont_eval_type::iterator*)&cont_iters[0],(const typename cont_eval_type::momentum_type* const*)&momenta[0]);
+				    discr_eval_type::third((const typename discr_eval_type::value_type)factor,(const typename discr_eval_type::value_type* const*)&couplings[0],(typename discr_eval_type::iterator*)&discr_iters[0],(const typename discr_eval_type::momentum_type* const*)&momenta[0],iterset);
 				    if(!equal_sequences(cont_tens[2],discr_tens[2]))
 				    {
 					std::cerr<<"Mismatch continuous<->discrete colour flow vertices in 3rd recursive relation."<<std::endl;
@@ -478,8 +479,8 @@ namespace Camgen
 				for(;discr_iters[2]!=discr_tens[2].end();discr_iters[2]+=st_sizes[2])
 				{
 				    fill(2);
-				    cont_eval_type::fourth((const typename cont_eval_type::value_type)factor,(const std::vector<const typename cont_eval_type::value_type*>&)couplings,(std::vector<typename cont_eval_type::iterator>&)cont_iters,(const std::vector<const typename cont_eval_type::momentum_type*>&)momenta);
-				    discr_eval_type::fourth((const typename discr_eval_type::value_type)factor,(const std::vector<const typename discr_eval_type::value_type*>&)couplings,(std::vector<typename discr_eval_type::iterator>&)discr_iters,(const std::vector<const typename discr_eval_type::momentum_type*>&)momenta,iterset);
+				    cont_eval_type::fourth((const typename cont_eval_type::value_type)factor,(const typename cont_eval_type::value_type* const*)&couplings[0],(typename cont_eval_type::iterator*)&cont_iters[0],(const typename cont_eval_type::momentum_type* const*)&momenta[0]);
+				    discr_eval_type::fourth((const typename discr_eval_type::value_type)factor,(const typename discr_eval_type::value_type* const*)&couplings[0],(typename discr_eval_type::iterator*)&discr_iters[0],(const typename discr_eval_type::momentum_type* const*)&momenta[0],iterset);
 				    if(!equal_sequences(cont_tens[3],discr_tens[3]))
 				    {
 					std::cerr<<"Mismatch continuous<->discrete colour flow vertices in 4th recursive relation."<<std::endl;
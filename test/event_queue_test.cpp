@@ -0,0 +1,190 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <thread>
+#include <Camgen/SM.h>
+#include <Camgen/evt_queue.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Tests for the ring-buffer event queue, in growing and concurrent    *
+ * single-producer/single-consumer mode.                               *
+ *                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+using namespace Camgen;
+
+typedef SM model_type;
+typedef event_data<model_type,2,2> event_type;
+typedef event_queue<model_type,2,2> queue_type;
+
+/* Fills the argument event with weight and momentum components derived from
+ * the argument number: */
+
+void make_event(event_type& evt,std::size_t n)
+{
+    event_type::momentum_type p;
+    p.assign((double)n);
+    evt.set_p_out(0,p);
+    evt.set_w((double)(n+1));
+    evt.set_mu_F((double)(2*n));
+}
+
+/* Checks whether the argument event was made from the argument number: */
+
+bool check_event(const event<model_type,2,2>* evt,std::size_t n)
+{
+    return evt->w()==(double)(n+1) and evt->p_out(0)[3]==(double)n and evt->mu_F()==(double)(2*n);
+}
+
+/* Producer thread body: */
+
+void produce(queue_type* q,std::size_t n_evts)
+{
+    event_type evt;
+    for(std::size_t i=0;i<n_evts;++i)
+    {
+        make_event(evt,i);
+        q->fill(evt);
+    }
+}
+
+int main()
+{
+    license_print::disable();
+
+    {
+        std::cerr<<"Checking event queue with growing ring............";
+        std::cerr.flush();
+        queue_type q(4);
+        event_type evt;
+        std::size_t n=0,m=0;
+        for(;n<10;++n)
+        {
+            make_event(evt,n);
+            q.fill(evt);
+        }
+        if(q.size()!=10 or q.capacity()<10 or !check_event(q.front(),0) or !check_event(q.back(),9))
+        {
+            std::cerr<<"Queue holds "<<q.size()<<" events in "<<q.capacity()<<" slots, expected 10."<<std::endl;
+            return 1;
+        }
+        for(;m<3;++m)
+        {
+            q.pop();
+        }
+        for(;n<15;++n)
+        {
+            make_event(evt,n);
+            q.fill(evt);
+        }
+        for(;m<15;++m)
+        {
+            if(q.empty() or !check_event(q.front(),m))
+            {
+                std::cerr<<"Event "<<m<<" not found at the front of the queue."<<std::endl;
+                return 1;
+            }
+            q.pop();
+        }
+        if(!q.empty() or q.pop())
+        {
+            std::cerr<<"Queue not empty after popping all events."<<std::endl;
+            return 1;
+        }
+        std::cerr<<"done."<<std::endl;
+    }
+
+    {
+        std::cerr<<"Checking subprocesses of queued events............";
+        std::cerr.flush();
+        model_type::initialise();
+        typedef sub_process<model_type,2,2> sub_process_type;
+        vector<const particle<model_type>*,2> phi_in,phi_mu,phi_u;
+        phi_in[0]=model_wrapper<model_type>::get_particle("e+");
+        phi_in[1]=model_wrapper<model_type>::get_particle("e-");
+        phi_mu[0]=model_wrapper<model_type>::get_particle("mu-");
+        phi_mu[1]=model_wrapper<model_type>::get_particle("mu+");
+        phi_u[0]=model_wrapper<model_type>::get_particle("u");
+        phi_u[1]=model_wrapper<model_type>::get_particle("ubar");
+        queue_type q(2);
+        event_type evt;
+
+        /* The source event refers to a descriptor owned elsewhere, which is
+         * deleted and replaced after queueing, as for subprocesses removed
+         * by the event generator adaptation: */
+
+        sub_process_type* proc=new sub_process_type(phi_in,phi_mu);
+        evt.set_process_reference(proc,1);
+        make_event(evt,0);
+        q.fill(evt);
+        delete proc;
+        proc=new sub_process_type(phi_in,phi_u);
+        evt.set_process_reference(proc,2);
+        for(std::size_t n=1;n<8;++n)
+        {
+            make_event(evt,n);
+            q.fill(evt);
+            if(q.back()->process_id()!=2 or q.back()->get_particle_out(0)!=phi_u[0] or q.back()->get_particle_out(1)!=phi_u[1] or q.back()->get_process_ptr()==proc)
+            {
+                std::cerr<<"Queued event "<<n<<" does not own a copy of subprocess 2."<<std::endl;
+                return 1;
+            }
+            if(q.front()->process_id()!=1 or q.front()->get_particle_out(0)!=phi_mu[0] or q.front()->get_particle_out(1)!=phi_mu[1])
+            {
+                std::cerr<<"Queued event refers to subprocess "<<q.front()->process_id()<<", expected 1 with mu-,mu+."<<std::endl;
+                return 1;
+            }
+        }
+        while(q.pop());
+        for(std::size_t n=0;n<8;++n)
+        {
+            make_event(evt,n);
+            q.fill(evt);
+        }
+        while(!q.empty())
+        {
+            if(q.front()->process_id()!=2 or q.front()->get_particle_out(0)!=phi_u[0])
+            {
+                std::cerr<<"Reused event slot refers to subprocess "<<q.front()->process_id()<<", expected 2 with u,ubar."<<std::endl;
+                return 1;
+            }
+            q.pop();
+        }
+        delete proc;
+        evt.set_process_reference(NULL);
+        std::cerr<<"done."<<std::endl;
+    }
+
+    {
+        std::cerr<<"Checking concurrent event queue............";
+        std::cerr.flush();
+        std::size_t n_evts=100000;
+        queue_type q(8,true);
+        std::thread producer(produce,&q,n_evts);
+        std::size_t m=0;
+        bool ok=true;
+        while(m<n_evts)
+        {
+            if(q.empty())
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            ok=ok and check_event(q.front(),m);
+            q.pop();
+            ++m;
+        }
+        producer.join();
+        if(!ok or !q.empty() or q.capacity()!=8)
+        {
+            std::cerr<<"Concurrent queue delivered events out of order or resized."<<std::endl;
+            return 1;
+        }
+        std::cerr<<"done."<<std::endl;
+    }
+}
+
@@ -7,6 +7,7 @@
 
 #include <Camgen/SM.h>
 #include <Camgen/stdrand.h>
+#include <Camgen/philox.h>
 #include <Camgen/evtgen_fac.h>
 
 /* * * * * * * * * * * * * * * *
@@ -18,6 +19,74 @@
 
 using namespace Camgen;
 
+/* Initialises event generators with one and three initialisation threads
+ * from the same random number state and checks that they retain the same
+ * subprocesses with identical cross sections. With substream engines, the
+ * engine and position of the main random number stream should be left
+ * untouched by the initialisation: */
+
+template<class rng_t>bool check_concurrent_init(CM_algorithm<SM,2,4>& algo,std::size_t n_init_evts)
+{
+    typedef SM model_type;
+    typedef std::size_t size_type;
+
+    event_generator_factory<model_type,2,4,rng_t> factory;
+    set_init_threads(1);
+    event_generator<model_type,2,4,rng_t>* evt_gen1=factory.create_generator(algo);
+    set_init_threads(3);
+    event_generator<model_type,2,4,rng_t>* evt_gen2=factory.create_generator(algo);
+    set_init_threads(1);
+    event_generator<model_type,2,4,rng_t>* evt_gens[2]={evt_gen1,evt_gen2};
+    typedef random_number_stream<model_type::value_type,rng_t> rn_stream;
+    bool q=true;
+    for(int i=0;i<2;++i)
+    {
+        rn_stream::reset_engine();
+        rn_stream::throw_number();
+        rng_t* engine=rn_stream::get_engine();
+        evt_gens[i]->pre_initialise(n_init_evts);
+        evt_gens[i]->initialise(2,n_init_evts,2,n_init_evts,n_init_evts);
+        if(rn_stream::get_engine()!=engine or (rn_substream<rng_t>::value and rn_stream::number_of_throws()!=1))
+        {
+            std::cerr<<"main random number stream was replaced or advanced by the subprocess initialisation"<<std::endl;
+            q=false;
+        }
+    }
+    if(q and evt_gen1->processes()!=evt_gen2->processes())
+    {
+        std::cerr<<"concurrent initialisation retained "<<evt_gen2->processes()<<" subprocesses instead of "<<evt_gen1->processes()<<std::endl;
+        q=false;
+    }
+    for(size_type i=0;q and i<evt_gen1->processes();++i)
+    {
+        int id=evt_gen1->process_id(i);
+        const event_generator_base<model_type,2,4>* gen2=evt_gen2->get_sub_generator(id);
+        if(gen2==NULL)
+        {
+            std::cerr<<"subprocess "<<id<<" missing after concurrent initialisation"<<std::endl;
+            q=false;
+        }
+        else if(evt_gen1->xsec(i).value!=static_cast<const process_generator<model_type,2,4,rng_t>*>(gen2)->cross_section().value)
+        {
+            std::cerr<<"subprocess "<<id<<" cross section differs after concurrent initialisation"<<std::endl;
+            q=false;
+        }
+    }
+    if(q and (evt_gen1->cross_section().value!=evt_gen2->cross_section().value or evt_gen1->cross_section().value==0))
+    {
+        std::cerr<<"total cross section "<<evt_gen2->cross_section()<<" after concurrent initialisation differs from "<<evt_gen1->cross_section()<<std::endl;
+        q=false;
+    }
+    if(q and (evt_gen1->integrand()!=evt_gen2->integrand() or evt_gen1->weight()!=evt_gen2->weight()))
+    {
+        std::cerr<<"last initialisation event differs after concurrent initialisation"<<std::endl;
+        q=false;
+    }
+    delete evt_gen1;
+    delete evt_gen2;
+    return q;
+}
+
 int main()
 {
     typedef SM model_type;
@@ -415,6 +484,62 @@ int main()
         Camgen::log.enable_level=log_level::warning;
     }
 
+    {
+        Camgen::log.enable_level=log_level::error;
+        std::string process("e+,e- > l+,l-,nu,nubar");
+        value_type E1=250;
+        value_type E2=250;
+        std::cerr<<"Checking subprocess selection for "<<process<<"..........";
+        std::cerr.flush();
+        CM_algorithm<model_type,2,4>algo(process);
+        algo.load();
+        algo.construct_trees();
+        double E1_default=first_beam_energy();
+        double E2_default=second_beam_energy();
+        set_beam_energy(-1,E1);
+        set_beam_energy(-2,E2);
+        event_generator_factory<model_type,2,4,philox> factory;
+        event_generator<model_type,2,4,philox>* evt_gen=factory.create_generator(algo);
+        evt_gen->pre_initialise(n_init_evts);
+        std::vector<value_type>alpha_sums;
+        value_type alpha_sum(0);
+        for(event_generator<model_type,2,4,philox>::const_process_iterator it=evt_gen->begin_processes();it!=evt_gen->end_processes();++it)
+        {
+            alpha_sum+=it->alpha;
+            alpha_sums.push_back(alpha_sum);
+        }
+        typedef random_number_stream<value_type,philox> rn_stream;
+        for(size_type i=0;i<n_init_evts;++i)
+        {
+            philox e1(2013,i),e2(2013,i);
+            rn_stream::set_engine(&e1);
+            value_type rho=rn_stream::throw_number();
+            size_type n=0;
+            while(n+1<alpha_sums.size() and alpha_sums[n]<=rho)
+            {
+                ++n;
+            }
+            rn_stream::set_engine(&e2);
+            evt_gen->generate();
+            if(evt_gen->process_id()!=evt_gen->process_id(n))
+            {
+                std::cerr<<"subprocess "<<evt_gen->process_id()<<" selected instead of "<<evt_gen->process_id(n)<<std::endl;
+                return 1;
+            }
+            if(&(evt_gen->get_event().get_process())!=&(evt_gen->process()->get_process()))
+            {
+                std::cerr<<"event does not refer to the subprocess descriptor of the generator"<<std::endl;
+                return 1;
+            }
+        }
+        rn_stream::set_engine(NULL);
+        delete evt_gen;
+        set_beam_energy(-1,E1_default);
+        set_beam_energy(-2,E2_default);
+        std::cerr<<"done."<<std::endl;
+        Camgen::log.enable_level=log_level::warning;
+    }
+
     {
         Camgen::log.enable_level=log_level::error;
         std::string process("e+,e- > l+,l-,nu,nubar");
@@ -449,5 +574,37 @@ int main()
         Camgen::log.enable_level=log_level::warning;
     }
 
+    {
+        Camgen::log.enable_level=log_level::error;
+        std::string process("e+,e- > l+,l-,nu,nubar");
+        value_type E1=250;
+        value_type E2=250;
+        CM_algorithm<model_type,2,4>algo(process);
+        algo.load();
+        algo.construct_trees();
+        double E1_default=first_beam_energy();
+        double E2_default=second_beam_energy();
+        set_beam_energy(-1,E1);
+        set_beam_energy(-2,E2);
+        std::cerr<<"Checking concurrent subprocess initialisation for "<<process<<"..........";
+        std::cerr.flush();
+        bool q=check_concurrent_init<philox>(algo,n_init_evts);
+        if(q)
+        {
+            std::cerr<<"done."<<std::endl;
+            std::cerr<<"Checking sequential fallback of the subprocess initialisation for "<<process<<"..........";
+            std::cerr.flush();
+            q=check_concurrent_init<rn_engine>(algo,n_init_evts);
+        }
+        set_beam_energy(-1,E1_default);
+        set_beam_energy(-2,E2_default);
+        if(!q)
+        {
+            return 1;
+        }
+        std::cerr<<"done."<<std::endl;
+        Camgen::log.enable_level=log_level::warning;
+    }
+
     return 0;
 }
@@ -15,6 +15,10 @@
 #include <Camgen/parni_int.h>
 #include <Camgen/file_utils.h>
 
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Facility testing adaptive grids in parni for various intgrands in various *
  * dimensions.                                                               *
@@ -23,6 +27,25 @@
 
 using namespace Camgen;
 
+/* Worker thread accumulating a range of points into a 2D parni grid: */
+
+struct parni_worker
+{
+    parni_generator<double,2,std::random>* grid;
+    const std::vector< vector<double,2> >* points;
+    const std::vector<double>* values;
+    std::size_t index,begin,end;
+
+    void operator()() const
+    {
+	update_worker::set_index(index);
+	for(std::size_t i=begin;i<end;++i)
+	{
+	    grid->accumulate((*points)[i],(*values)[i]);
+	}
+    }
+};
+
 int main()
 {
     std::cout<<"-------------------------------------------------------------------------"<<std::endl;
@@ -902,5 +925,87 @@ int main()
 	delete gen;
 	std::cerr<<"...........done, file "<<filename+fext<<" written."<<std::endl;
     }
+#if __cplusplus >= 201103L
+    {
+	N_events=20000;
+	N_bins=200;
+	size_type N_workers=4;
+	vector<value_type,2>x;
+	vector<value_type,2>xmin;
+	xmin.assign(-1);
+	vector<value_type,2>xmax;
+	xmax.assign(1);
+	value_type w2=0.01,mu2=0.25;
+	std::cerr<<"Checking 2D parni grid updates by "<<N_workers<<" worker threads..........";
+        std::cerr.flush();
+	typedef parni_generator<value_type,2,std::random> grid_type;
+	typedef random_number_stream<value_type,std::random> rn_stream;
+	std::vector< vector<value_type,2> >points(N_batch);
+	std::vector<value_type>values(N_batch);
+	std::vector<value_type>weights[2];
+	size_type bins[2];
+	for(int pass=0;pass<2;++pass)
+	{
+	    rn_stream::reset_engine();
+	    grid_type* gen=new grid_type(&x,xmin,xmax,N_bins,mode);
+	    if(pass==1)
+	    {
+		gen->set_update_workers(N_workers);
+	    }
+	    for(size_type n=0;n<N_events;n+=N_batch)
+	    {
+		for(size_type i=0;i<N_batch;++i)
+		{
+		    gen->generate();
+		    points[i]=x;
+		    value_type r2=x[0]*x[0]+x[1]*x[1];
+		    values[i]=(value_type)1/(std::pow(r2-mu2,(int)2)+w2);
+		}
+		if(pass==0)
+		{
+		    for(size_type i=0;i<N_batch;++i)
+		    {
+			gen->accumulate(points[i],values[i]);
+		    }
+		}
+		else
+		{
+		    std::vector<std::thread>workers;
+		    for(size_type k=0;k<N_workers;++k)
+		    {
+			parni_worker worker={gen,&points,&values,k+1,(k*N_batch)/N_workers,((k+1)*N_batch)/N_workers};
+			workers.push_back(std::thread(worker));
+		    }
+		    for(size_type k=0;k<N_workers;++k)
+		    {
+			workers[k].join();
+		    }
+		}
+		gen->adapt();
+	    }
+	    bins[pass]=gen->count_bins();
+	    for(int i=0;i<100;++i)
+	    {
+		gen->generate();
+		weights[pass].push_back(gen->weight());
+	    }
+	    delete gen;
+	}
+	if(bins[0]!=bins[1])
+	{
+	    std::cerr<<"Grid updated by worker threads has "<<bins[1]<<" bins instead of "<<bins[0]<<'.'<<std::endl;
+	    return 1;
+	}
+	for(int i=0;i<100;++i)
+	{
+	    if(weights[0][i]!=weights[1][i])
+	    {
+		std::cerr<<"Weight "<<weights[1][i]<<" from grid updated by worker threads not equal to sequential result "<<weights[0][i]<<'.'<<std::endl;
+		return 1;
+	    }
+	}
+	std::cerr<<"...........done."<<std::endl;
+    }
+#endif
 }
 
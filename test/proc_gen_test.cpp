@@ -5,8 +5,10 @@
 // see COPYING for details.
 //
 
+#include <thread>
 #include <Camgen/SM.h>
 #include <Camgen/stdrand.h>
+#include <Camgen/philox.h>
 #include <proc_gen_tester.h>
 
 /* * * * * * * * * * * * * * * * *
@@ -16,6 +18,26 @@
 
 using namespace Camgen;
 
+typedef process_generator<SM,1,4,philox> philox_generator;
+
+/* Worker thread body, generating events with the worker's own generator and
+ * adding their weights to the worker's shadow of the shared generator: */
+
+void feed_worker(philox_generator* shared,philox_generator* gen,std::size_t index,std::size_t n_evts)
+{
+    typedef random_number_stream<SM::value_type,philox> rn_stream;
+    philox engine(2013,index);
+    rn_stream::set_engine(&engine);
+    update_worker::set_index(index);
+    for(std::size_t n=0;n<n_evts;++n)
+    {
+	gen->generate();
+	shared->accumulate(gen->validate_integrand()?gen->weighted_integrand():(SM::value_type)0);
+    }
+    update_worker::set_index(0);
+    rn_stream::set_engine(NULL);
+}
+
 int main()
 {
     typedef SM model_type;
@@ -127,6 +149,228 @@ int main()
 	Camgen::log.enable_level=log_level::warning;
     }
 
+    {
+	Camgen::log.enable_level=log_level::error;
+	std::string process("h0 > e-,nu_ebar,mu+,nu_mu");
+	std::cerr<<"Checking two-stage unweighting for "<<process<<"............";
+	std::cerr.flush();
+	CM_algorithm<model_type,1,4>algo(process);
+	algo.load();
+	algo.construct();
+	process_generator_factory<model_type,1,4,rn_engine> proc_gen_fac;
+	process_generator<model_type,1,4,rn_engine>* proc_gen=proc_gen_fac.create_generator(algo.get_tree_iterator());
+	proc_gen->pre_initialise(1000);
+	proc_gen->initialise(2,1000,2,1000);
+	proc_gen->set_auto_update(false);
+	proc_gen->generate_unweighted();
+	std::size_t n_unw=100;
+	std::vector<vector<model_type::value_type,model_type::dimension> >p1(n_unw);
+	random_number_stream<model_type::value_type,rn_engine>::reset_engine();
+	for(std::size_t n=0;n<n_unw;++n)
+	{
+	    proc_gen->generate_unweighted();
+	    p1[n]=proc_gen->get_event().p_out(0);
+	}
+	proc_gen->set_two_stage_unweighting(true);
+	proc_gen->set_me_bound_factor(10);
+	random_number_stream<model_type::value_type,rn_engine>::reset_engine();
+	for(std::size_t n=0;n<n_unw;++n)
+	{
+	    proc_gen->generate_unweighted();
+	    if(proc_gen->get_event().p_out(0)!=p1[n])
+	    {
+		std::cerr<<"Two-stage unweighting generated event "<<n<<" differently."<<std::endl;
+		return 1;
+	    }
+	}
+	delete proc_gen;
+	std::cerr<<"done."<<std::endl;
+	Camgen::log.enable_level=log_level::warning;
+    }
+
+    {
+	Camgen::log.enable_level=log_level::error;
+	std::string process("h0 > e-,nu_ebar,mu+,nu_mu");
+	std::cerr<<"Checking two-stage unweighting with a too small bound for "<<process<<"............";
+	std::cerr.flush();
+	CM_algorithm<model_type,1,4>algo(process);
+	algo.load();
+	algo.construct();
+	process_generator_factory<model_type,1,4,rn_engine> proc_gen_fac;
+	process_generator<model_type,1,4,rn_engine>* proc_gen=proc_gen_fac.create_generator(algo.get_tree_iterator());
+	proc_gen->pre_initialise(1000);
+	proc_gen->initialise(2,1000,2,1000);
+	proc_gen->set_auto_update(false);
+	std::size_t n_unw=5000;
+	model_type::value_type dm=2*model_type::W_W;
+	model_type::value_type n_peak=0;
+	for(std::size_t n=0;n<n_unw;++n)
+	{
+	    proc_gen->generate_unweighted();
+	    if(std::abs(proc_gen->get_event().m(1,2)-model_type::M_W)<dm)
+	    {
+		++n_peak;
+	    }
+	}
+	model_type::value_type f1=n_peak/n_unw;
+	proc_gen->set_two_stage_unweighting(true);
+	proc_gen->set_me_bound_factor(0.05);
+	std::vector<model_type::value_type>w(n_unw),x(n_unw);
+	model_type::value_type wsum=0,wpeak=0;
+	for(std::size_t n=0;n<n_unw;++n)
+	{
+	    proc_gen->generate_unweighted();
+	    w[n]=proc_gen->weight()/proc_gen->cross_section().value;
+	    x[n]=(std::abs(proc_gen->get_event().m(1,2)-model_type::M_W)<dm)?1:0;
+	    wsum+=w[n];
+	    wpeak+=w[n]*x[n];
+	}
+	model_type::value_type f2=wpeak/wsum,var2=0;
+	for(std::size_t n=0;n<n_unw;++n)
+	{
+	    var2+=(w[n]*w[n]*(x[n]-f2)*(x[n]-f2));
+	}
+	var2/=(wsum*wsum);
+	model_type::value_type sigma=std::sqrt(f1*(1-f1)/n_unw+var2);
+	if(proc_gen->me_bound_violation_count()==0 or !(wsum>n_unw))
+	{
+	    std::cerr<<"Matrix element bound was not exceeded."<<std::endl;
+	    return 1;
+	}
+	if(std::abs(f1-f2)>4*sigma)
+	{
+	    std::cerr<<"Two-stage unweighted peak fraction "<<f2<<" differs from "<<f1<<" by more than 4 sigma = "<<4*sigma<<'.'<<std::endl;
+	    return 1;
+	}
+	delete proc_gen;
+	std::cerr<<"done."<<std::endl;
+	Camgen::log.enable_level=log_level::warning;
+    }
+
+    {
+	Camgen::log.enable_level=log_level::error;
+	std::string process("h0 > e-,nu_ebar,mu+,nu_mu");
+	std::cerr<<"Checking partial unweighting for "<<process<<"............";
+	std::cerr.flush();
+	CM_algorithm<model_type,1,4>algo(process);
+	algo.load();
+	algo.construct();
+	process_generator_factory<model_type,1,4,rn_engine> proc_gen_fac;
+	process_generator<model_type,1,4,rn_engine>* proc_gen=proc_gen_fac.create_generator(algo.get_tree_iterator());
+	proc_gen->pre_initialise(1000);
+	proc_gen->initialise(2,1000,2,1000);
+	proc_gen->set_auto_update(false);
+	proc_gen->bin_weights(100);
+	proc_gen->reduce_max_weight(0.05);
+	proc_gen->set_partial_unweighting(true);
+	std::size_t n_unw=200,n_over=0;
+	model_type::value_type rsum=0;
+	for(std::size_t n=0;n<n_unw;++n)
+	{
+	    proc_gen->generate_unweighted();
+	    model_type::value_type r=proc_gen->weight()/proc_gen->cross_section().value;
+	    if(r<(model_type::value_type)1 or proc_gen->get_event().w()!=proc_gen->weight())
+	    {
+		std::cerr<<"Invalid partially unweighted event weight "<<proc_gen->weight()<<" for cross section "<<proc_gen->cross_section().value<<'.'<<std::endl;
+		return 1;
+	    }
+	    if(r>(model_type::value_type)1)
+	    {
+		++n_over;
+	    }
+	    rsum+=r;
+	}
+	if(n_over==0 or n_over!=proc_gen->overweight_event_count() or proc_gen->unweighted_event_count()!=n_unw)
+	{
+	    std::cerr<<"Overweight event count "<<proc_gen->overweight_event_count()<<" does not match "<<n_over<<'.'<<std::endl;
+	    return 1;
+	}
+	if(!equals(proc_gen->average_weight_factor(),rsum/n_unw))
+	{
+	    std::cerr<<"Average weight factor "<<proc_gen->average_weight_factor()<<" does not match "<<rsum/n_unw<<'.'<<std::endl;
+	    return 1;
+	}
+	delete proc_gen;
+	std::cerr<<"done."<<std::endl;
+	Camgen::log.enable_level=log_level::warning;
+    }
+
+    {
+	Camgen::log.enable_level=log_level::error;
+	std::string process("Z > e-,e+,mu-,mu+");
+	std::cerr<<"Checking concurrent worker updates for "<<process<<"............";
+	std::cerr.flush();
+	const std::size_t n_workers=4;
+	std::size_t n_worker_evts=500;
+	CM_algorithm<model_type,1,4>* algos[n_workers+1];
+	for(std::size_t i=0;i<=n_workers;++i)
+	{
+	    algos[i]=new CM_algorithm<model_type,1,4>(process);
+	    algos[i]->load();
+	    algos[i]->construct();
+	}
+	process_generator_factory<model_type,1,4,philox> proc_gen_fac;
+	philox_generator* shared=proc_gen_fac.create_generator(algos[0]->get_tree_iterator());
+	shared->set_update_workers(n_workers);
+	MC_integral<model_type::value_type>xsecs[2];
+	for(int run=0;run<2;++run)
+	{
+	    philox_generator* workers[n_workers];
+	    for(std::size_t i=0;i<n_workers;++i)
+	    {
+		workers[i]=proc_gen_fac.create_generator(algos[i+1]->get_tree_iterator());
+	    }
+	    if(run==0)
+	    {
+		std::vector<std::thread>threads;
+		for(std::size_t i=0;i<n_workers;++i)
+		{
+		    threads.push_back(std::thread(feed_worker,shared,workers[i],i+1,n_worker_evts));
+		}
+		for(std::size_t i=0;i<n_workers;++i)
+		{
+		    threads[i].join();
+		}
+	    }
+	    else
+	    {
+		for(std::size_t i=0;i<n_workers;++i)
+		{
+		    feed_worker(shared,workers[i],i+1,n_worker_evts);
+		}
+	    }
+	    if(shared->calls()!=0)
+	    {
+		std::cerr<<"Worker updates entered the cross section before adaptation."<<std::endl;
+		return 1;
+	    }
+	    shared->adapt();
+	    xsecs[run]=shared->cross_section();
+	    if(shared->calls()!=n_workers*n_worker_evts)
+	    {
+		std::cerr<<"Cross section counts "<<shared->calls()<<" calls after merging instead of "<<n_workers*n_worker_evts<<'.'<<std::endl;
+		return 1;
+	    }
+	    shared->reset_cross_section();
+	    for(std::size_t i=0;i<n_workers;++i)
+	    {
+		delete workers[i];
+	    }
+	}
+	if(xsecs[0].value!=xsecs[1].value or xsecs[0].error!=xsecs[1].error or !(xsecs[0].value>0))
+	{
+	    std::cerr<<"Cross section "<<xsecs[0]<<" accumulated by concurrent workers differs from sequential result "<<xsecs[1]<<'.'<<std::endl;
+	    return 1;
+	}
+	delete shared;
+	for(std::size_t i=0;i<=n_workers;++i)
+	{
+	    delete algos[i];
+	}
+	std::cerr<<"done."<<std::endl;
+	Camgen::log.enable_level=log_level::warning;
+    }
+
     {
 	Camgen::log.enable_level=log_level::error;
 	std::string process("W- > mu-,nu_mubar");
@@ -0,0 +1,216 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <vector>
+#include <Camgen/philox.h>
+#include <Camgen/rn_strm.h>
+#include <Camgen/stdrand.h>
+#include <Camgen/num_utils.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Testing facility for the random number streams. The Philox generator is     *
+ * checked against the known-answer vectors of the reference implementation,  *
+ * jumping ahead and bulk filling are compared to throwing, and the            *
+ * installation of per-thread engines in the random number stream is checked   *
+ * to be reproducible.                                                          *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+using namespace Camgen;
+
+int main()
+{
+    typedef double value_type;
+    typedef random_number_stream<value_type,philox> rn_stream;
+
+    std::cout<<"----------------------------------------------------------"<<std::endl;
+    std::cout<<"testing random number streams............................."<<std::endl;
+    std::cout<<"----------------------------------------------------------"<<std::endl;
+
+    {
+	std::cerr<<"Checking Philox4x32-10 known-answer vectors..........";
+	std::cerr.flush();
+	philox::word_type c1[4]={0,0,0,0};
+	philox::word_type k1[2]={0,0};
+	philox::word_type r1[4]={0x6627e8d5,0xe169c58d,0xbc57ac4c,0x9b00dbd8};
+	philox::word_type c2[4]={0xffffffff,0xffffffff,0xffffffff,0xffffffff};
+	philox::word_type k2[2]={0xffffffff,0xffffffff};
+	philox::word_type r2[4]={0x408f276d,0x41c83b0e,0xa20bc7c6,0x6d5451fd};
+	philox::word_type out[4];
+	philox::block(c1,k1,out);
+	for(int i=0;i<4;++i)
+	{
+	    if(out[i]!=r1[i])
+	    {
+		std::cerr<<"output word "<<i<<" of zero counter and key is "<<std::hex<<out[i]<<" instead of "<<r1[i]<<std::endl;
+		return 1;
+	    }
+	}
+	philox::block(c2,k2,out);
+	for(int i=0;i<4;++i)
+	{
+	    if(out[i]!=r2[i])
+	    {
+		std::cerr<<"output word "<<i<<" of maximal counter and key is "<<std::hex<<out[i]<<" instead of "<<r2[i]<<std::endl;
+		return 1;
+	    }
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    {
+	std::cerr<<"Checking Philox jump-ahead..........";
+	std::cerr.flush();
+	for(unsigned n=0;n<10;++n)
+	{
+	    philox a(12345,7),b(12345,7);
+	    for(unsigned i=0;i<n;++i)
+	    {
+		a();
+	    }
+	    b.jump(n);
+	    if(a.position()!=n or b.position()!=n)
+	    {
+		std::cerr<<"stream position is "<<b.position()<<" instead of "<<n<<std::endl;
+		return 1;
+	    }
+	    for(unsigned i=0;i<10;++i)
+	    {
+		if(a()!=b())
+		{
+		    std::cerr<<"jumping "<<n<<" throws ahead yields different random numbers"<<std::endl;
+		    return 1;
+		}
+	    }
+	}
+	philox a(12345,7),b(12345,8);
+	unsigned equal=0;
+	for(unsigned i=0;i<100;++i)
+	{
+	    if(a()==b())
+	    {
+		++equal;
+	    }
+	}
+	if(equal>1)
+	{
+	    std::cerr<<"streams 7 and 8 yield "<<equal<<" equal numbers out of 100"<<std::endl;
+	    return 1;
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    {
+	std::cerr<<"Checking bulk random number generation..........";
+	std::cerr.flush();
+	for(unsigned n=0;n<100;n+=7)
+	{
+	    philox a(2013,1),b(2013,1);
+	    a.jump(n%5);
+	    b.jump(n%5);
+	    std::vector<philox::result_type>r(n+1);
+	    b.fill(&r[0],n);
+	    for(unsigned i=0;i<n;++i)
+	    {
+		if(a()!=r[i])
+		{
+		    std::cerr<<"bulk-filled integer "<<i<<" out of "<<n<<" differs from thrown integer"<<std::endl;
+		    return 1;
+		}
+	    }
+	    if(a()!=b())
+	    {
+		std::cerr<<"stream position after bulk filling "<<n<<" integers differs from throwing"<<std::endl;
+		return 1;
+	    }
+	}
+	philox e1(2013,2),e2(2013,2);
+	std::vector<value_type>x(150),y(150);
+	rn_stream::set_engine(&e1);
+	for(unsigned i=0;i<x.size();++i)
+	{
+	    x[i]=rn_stream::throw_number(-2,3);
+	}
+	rn_stream::set_engine(&e2);
+	rn_stream::fill(&y[0],y.size(),-2,3);
+	if(rn_stream::number_of_throws()!=y.size())
+	{
+	    std::cerr<<"stream counted "<<rn_stream::number_of_throws()<<" throws instead of "<<y.size()<<std::endl;
+	    return 1;
+	}
+	for(unsigned i=0;i<x.size();++i)
+	{
+	    if(x[i]!=y[i])
+	    {
+		std::cerr<<"bulk-filled number "<<y[i]<<" differs from thrown number "<<x[i]<<std::endl;
+		return 1;
+	    }
+	}
+	typedef random_number_stream<value_type,std::random> std_rn_stream;
+	std_rn_stream::reset_engine();
+	for(unsigned i=0;i<x.size();++i)
+	{
+	    x[i]=std_rn_stream::throw_number();
+	}
+	std_rn_stream::reset_engine();
+	std_rn_stream::fill(&y[0],y.size());
+	for(unsigned i=0;i<x.size();++i)
+	{
+	    if(x[i]!=y[i])
+	    {
+		std::cerr<<"bulk-filled number "<<y[i]<<" differs from thrown number "<<x[i]<<" for the standard library generator"<<std::endl;
+		return 1;
+	    }
+	}
+	rn_stream::set_engine(NULL);
+	std::cerr<<".........done."<<std::endl;
+    }
+
+    {
+	std::cerr<<"Checking installation of engines in random number stream..........";
+	std::cerr.flush();
+	philox e1(2013,3);
+	rn_stream::set_engine(&e1);
+	std::vector<value_type>x(100);
+	for(unsigned i=0;i<x.size();++i)
+	{
+	    x[i]=rn_stream::throw_number();
+	    if(x[i]<0 or x[i]>1)
+	    {
+		std::cerr<<"random number "<<x[i]<<" out of range"<<std::endl;
+		return 1;
+	    }
+	}
+	if(rn_stream::number_of_throws()!=x.size())
+	{
+	    std::cerr<<"stream counted "<<rn_stream::number_of_throws()<<" throws instead of "<<x.size()<<std::endl;
+	    return 1;
+	}
+	philox e2(2013,3);
+	if(rn_stream::set_engine(&e2)!=&e1)
+	{
+	    std::cerr<<"previously installed engine not returned"<<std::endl;
+	    return 1;
+	}
+	for(unsigned i=0;i<x.size();++i)
+	{
+	    if(rn_stream::throw_number()!=x[i])
+	    {
+		std::cerr<<"random number "<<i<<" not reproduced by engine with equal key and stream"<<std::endl;
+		return 1;
+	    }
+	}
+	rn_stream::set_engine(NULL);
+	if(rn_stream::get_engine()==&e2 or rn_stream::get_engine()==NULL)
+	{
+	    std::cerr<<"default engine not restored"<<std::endl;
+	    return 1;
+	}
+	std::cerr<<".........done."<<std::endl;
+    }
+}
+
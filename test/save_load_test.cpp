@@ -5,10 +5,12 @@
 // see COPYING for details.
 //
 
+#include <cstdio>
 #include <Camgen/parni_gen.h>
 #include <Camgen/stdrand.h>
+#include <Camgen/philox.h>
 #include <Camgen/SM.h>
-#include <Camgen/proc_gen.h>
+#include <Camgen/evtgen_fac.h>
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Facility testing the serialization of event generators. *
@@ -24,47 +26,44 @@ int main()
     std::cout<<"testing saving/loading MC generators..................................."<<std::endl;
     std::cout<<"-----------------------------------------------------------------------"<<std::endl;
 
-//    typedef SM model_type;
-//    typedef SM::value_type value_type;
-//    typedef std::size_t size_type;
-//    typedef std::random rng_type;
-    
-    //////////////////////////////////////////////////////////////////
-
-//    size_type N_events = 100000;
-//    size_type N_batch  = 100;
-//    size_type N_bins   = 100;
-//    grid_modes::type mode = grid_modes::maximum_weights;
+    typedef SM model_type;
+    typedef SM::value_type value_type;
+    typedef std::size_t size_type;
+    typedef std::random rng_type;
+    typedef random_number_stream<value_type,rng_type> rn_stream;
 
     //////////////////////////////////////////////////////////////////
 
+    size_type N_events = 100000;
+    size_type N_batch  = 100;
+    size_type N_bins   = 100;
+    grid_modes::type mode = grid_modes::maximum_weights;
 
-    std::cerr<<"...serialization not implemented yet..."<<std::endl;
+    //////////////////////////////////////////////////////////////////
 
-	
-/*    size_type offset=N_events/N_bins;
-    value_type pi=std::acos(-(value_type)1);
     std::string filename="test_output.dat";
 
     {
 	value_type x=1,xmin=0,xmax=10,m=5,w=0.75;
 	std::cerr<<"Checking 1D parni save/load on Cauchy distribution..........";
         std::cerr.flush();
-	parni<value_type,1,rng_type>* gen=new parni<value_type,1,rng_type>(&x,xmin,xmax,N_bins,mode);
+	parni_generator<value_type,1,rng_type>* gen=new parni_generator<value_type,1,rng_type>(&x,xmin,xmax,N_bins,mode);
 	for(size_type n=0;n<N_events;++n)
 	{
 	    gen->generate();
 	    gen->integrand()=(value_type)1/(std::pow(x-m,(int)2)+w*w);
 	    gen->update();
-	    gen->refresh_cross_section();
 	    if(n%N_batch==0 and n!=0)
 	    {
 		gen->adapt();
 	    }
 	}
-	std::ofstream output_file(filename.c_str());
-	gen->save(output_file);
-	random_number_stream<value_type,rng_type>::reset_engine();
+	if(!gen->save(filename))
+	{
+	    std::cerr<<"Failed to write state file "<<filename<<'.'<<std::endl;
+	    return 1;
+	}
+	rn_stream::reset_engine();
 	std::vector<value_type>xvals(100);
 	std::vector<value_type>wvals(100);
 	for(int n=0;n<100;++n)
@@ -74,10 +73,23 @@ int main()
 	    wvals[n]=gen->weight();
 	}
 	delete gen;
-	gen=new parni<value_type,1,rng_type>(&x,xmin,xmax,N_bins,mode);
-	std::ifstream input_file(filename.c_str());
-	gen->load(input_file);
-	random_number_stream<value_type,rng_type>::reset_engine();
+	gen=new parni_generator<value_type,1,rng_type>(&x,xmin,xmax,2*N_bins,mode);
+	Camgen::log.enable_level=log_level::error;
+	bool mismatch_loaded=gen->load(filename);
+	Camgen::log.enable_level=log_level::warning;
+	if(mismatch_loaded)
+	{
+	    std::cerr<<"State loaded into grid with different number of bins."<<std::endl;
+	    return 1;
+	}
+	delete gen;
+	gen=new parni_generator<value_type,1,rng_type>(&x,xmin,xmax,N_bins,mode);
+	if(!gen->load(filename))
+	{
+	    std::cerr<<"Failed to read state file "<<filename<<'.'<<std::endl;
+	    return 1;
+	}
+	rn_stream::reset_engine();
 	for(int n=0;n<100;++n)
 	{
 	    gen->generate();
@@ -103,44 +115,49 @@ int main()
 	value_type m=5,w=0.75;
 	std::cerr<<"Checking 2D parni save/load on Cauchy distribution..........";
         std::cerr.flush();
-	parni<value_type,2,rng_type>* gen=new parni<value_type,2,rng_type>(&x,xmin,xmax,N_bins,mode);
+	parni_generator<value_type,2,rng_type>* gen=new parni_generator<value_type,2,rng_type>(&x,xmin,xmax,N_bins,mode);
 	for(size_type n=0;n<N_events;++n)
 	{
 	    gen->generate();
 	    gen->integrand()=(value_type)1/(std::pow(std::sqrt(x[0]*x[0]+x[1]*x[1])-m,(int)2)+w*w);
 	    gen->update();
-	    gen->refresh_cross_section();
 	    if(n%N_batch==0 and n!=0)
 	    {
 		gen->adapt();
 	    }
 	}
-	std::ofstream output_file(filename.c_str());
-	gen->save(output_file);
-	random_number_stream<value_type,rng_type>::reset_engine();
+	if(!gen->save(filename))
+	{
+	    std::cerr<<"Failed to write state file "<<filename<<'.'<<std::endl;
+	    return 1;
+	}
+	rn_stream::reset_engine();
 	std::vector<vector<value_type,2> >xvals(100);
 	std::vector<value_type>wvals(100);
 	for(int n=0;n<100;++n)
 	{
 	    gen->generate();
-	    xvals[n][0]=x[0];
-	    xvals[n][1]=x[1];
+	    xvals[n]=x;
 	    wvals[n]=gen->weight();
 	}
+	size_type bins=gen->count_bins();
 	delete gen;
-	gen=new parni<value_type,2,rng_type>(&x,xmin,xmax,N_bins,mode);
-	std::ifstream input_file(filename.c_str());
-	gen->load(input_file);
-	random_number_stream<value_type,rng_type>::reset_engine();
+	gen=new parni_generator<value_type,2,rng_type>(&x,xmin,xmax,N_bins,mode);
+	if(!gen->load(filename))
+	{
+	    std::cerr<<"Failed to read state file "<<filename<<'.'<<std::endl;
+	    return 1;
+	}
+	if(gen->count_bins()!=bins)
+	{
+	    std::cerr<<"Loaded grid has "<<gen->count_bins()<<" bins instead of "<<bins<<'.'<<std::endl;
+	    return 1;
+	}
+	rn_stream::reset_engine();
 	for(int n=0;n<100;++n)
 	{
 	    gen->generate();
-	    if(!equals(x[0],xvals[n][0]))
-	    {
-		std::cerr<<"Different value detected after save/load for "<<n<<" throws: "<<x<<" not equal to original value "<<xvals[n]<<'.'<<std::endl;
-		return 1;
-	    }
-	    if(!equals(x[1],xvals[n][1]))
+	    if(!equals(x[0],xvals[n][0]) or !equals(x[1],xvals[n][1]))
 	    {
 		std::cerr<<"Different value detected after save/load for "<<n<<" throws: "<<x<<" not equal to original value "<<xvals[n]<<'.'<<std::endl;
 		return 1;
@@ -157,39 +174,71 @@ int main()
     }
 
     set_initial_state_type(initial_states::partonic);
-    set_phase_space_generator_type(phase_space_generators::uniform);
-    
+    set_phase_space_generator_type(phase_space_generators::recursive);
     {
-	std::string process("h0 > mu-,nu_mubar,mu+,nu_mu");
-	std::cout<<"Checking recursive MC generator save/load for "<<process<<"............";
-	std::cout.flush();
-	CM_algorithm<model_type,1,4>algo(process);
-	algo.load();
-	algo.construct();
-	process_generator<model_type,1,4,rng_type>* gen=new process_generator<model_type,1,4,rng_type>(algo.get_tree_iterator());
-	gen->initialise(true);
-	std::ofstream output_file(filename.c_str());
-	gen->save(output_file);
-	random_number_stream<value_type,rng_type>::reset_engine();
-	std::vector<value_type>mvals(100);
+	Camgen::log.enable_level=log_level::error;
+	std::string process("e+,e- > l+,l-,nu,nubar");
+	std::cerr<<"Checking event generator save/load for "<<process<<"..........";
+	std::cerr.flush();
+	typedef random_number_stream<value_type,philox> philox_stream;
+	size_type n_init=1000;
+	double E1_default=first_beam_energy();
+	double E2_default=second_beam_energy();
+	set_beam_energy(-1,250);
+	set_beam_energy(-2,250);
+	CM_algorithm<model_type,2,4>algo1(process);
+	algo1.load();
+	algo1.construct_trees();
+	event_generator_factory<model_type,2,4,philox> factory;
+	event_generator<model_type,2,4,philox>* gen=factory.create_generator(algo1);
+	gen->pre_initialise(n_init);
+	gen->initialise(2,n_init,2,n_init,n_init);
+	if(!gen->save(filename))
+	{
+	    std::cerr<<"Failed to write state file "<<filename<<'.'<<std::endl;
+	    return 1;
+	}
+	std::vector<int>ids(100);
 	std::vector<value_type>wvals(100);
+	philox e1(2013,1);
+	philox_stream::set_engine(&e1);
 	for(int n=0;n<100;++n)
 	{
 	    gen->generate();
-	    mvals[n]=gen->integrand();
+	    ids[n]=gen->process_id();
 	    wvals[n]=gen->weight();
 	}
+	size_type procs=gen->processes();
+	value_type xsec=gen->cross_section().value;
 	delete gen;
-	gen=new process_generator<model_type,1,4,rng_type>(algo.get_tree_iterator());
-	std::ifstream input_file(filename.c_str());
-	gen->load(input_file);
-	random_number_stream<value_type,rng_type>::reset_engine();
+
+	CM_algorithm<model_type,2,4>algo2(process);
+	algo2.load();
+	algo2.construct_trees();
+	gen=factory.create_generator(algo2);
+	if(!gen->load(filename))
+	{
+	    std::cerr<<"Failed to read state file "<<filename<<'.'<<std::endl;
+	    return 1;
+	}
+	if(gen->processes()!=procs)
+	{
+	    std::cerr<<"Loaded generator has "<<gen->processes()<<" subprocesses instead of "<<procs<<'.'<<std::endl;
+	    return 1;
+	}
+	if(!equals(gen->cross_section().value,xsec))
+	{
+	    std::cerr<<"Loaded cross section "<<gen->cross_section().value<<" not equal to original "<<xsec<<'.'<<std::endl;
+	    return 1;
+	}
+	philox e2(2013,1);
+	philox_stream::set_engine(&e2);
 	for(int n=0;n<100;++n)
 	{
 	    gen->generate();
-	    if(!equals(gen->integrand(),mvals[n]))
+	    if(gen->process_id()!=ids[n])
 	    {
-		std::cerr<<"Different integrand detected after save/load for "<<n<<" throws: "<<gen->integrand()<<" not equal to original weight "<<mvals[n]<<'.'<<std::endl;
+		std::cerr<<"Different subprocess detected after save/load for "<<n<<" throws: "<<gen->process_id()<<" not equal to original subprocess "<<ids[n]<<'.'<<std::endl;
 		return 1;
 	    }
 	    if(!equals(gen->weight(),wvals[n]))
@@ -198,8 +247,13 @@ int main()
 		return 1;
 	    }
 	}
+	philox_stream::set_engine(NULL);
 	delete gen;
 	std::remove(filename.c_str());
-	std::cerr<<"...........done."<<std::endl;
-    }*/
+	set_beam_energy(-1,E1_default);
+	set_beam_energy(-2,E2_default);
+	std::cerr<<"..........done."<<std::endl;
+	Camgen::log.enable_level=log_level::warning;
+    }
 }
+
@@ -0,0 +1,146 @@
+//
+// This file is part of the CAMGEN library.
+// Copyright (C) 2013 Gijs van den Oord.
+// CAMGEN is licensed under the GNU GPL, version 2,
+// see COPYING for details.
+//
+
+#include <ctime>
+#include <vector>
+#include <Camgen/license_print.h>
+#include <Camgen/stdrand.h>
+#include <Camgen/rn_strm.h>
+#include <Camgen/c_utils.h>
+#include <Camgen/simd_spinor.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Testing facility for the Weyl-basis spinor kernels. The kernels, vectorised   *
+ * if the library is configured with --enable-simd, are compared to the scalar   *
+ * reference on random operands and timed against it.                           *
+ *                                                                               *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+namespace
+{
+    typedef std::complex<double> value_type;
+    typedef Camgen::random_number_stream<double,std::random> rn_stream;
+
+    value_type random_complex()
+    {
+	return value_type(rn_stream::throw_number(-1,1),rn_stream::throw_number(-1,1));
+    }
+
+    bool close(const value_type& a,const value_type& b)
+    {
+	return std::abs(a-b)<=1.0e-12*(1+std::abs(a)+std::abs(b));
+    }
+
+    /* Runs the k-th kernel of the Weyl-basis relations: */
+
+    template<class kernel_t>void run_kernel(int k,const value_type& L,const value_type& R,const value_type* a,const value_type* b,value_type* A)
+    {
+	switch(k)
+	{
+	    case 0:
+		kernel_t::VA_first(L,R,a,b,A);
+		break;
+	    case 1:
+		kernel_t::L_first(L,a,b,A);
+		break;
+	    case 2:
+		kernel_t::R_first(R,a,b,A);
+		break;
+	    case 3:
+		kernel_t::VA_second(L,R,a,b,A);
+		break;
+	    default:
+		kernel_t::VA_third(L,R,a,b,A);
+	}
+    }
+}
+
+/* Testing program: */
+
+int main()
+{
+    Camgen::license_print::disable();
+    std::cout<<"----------------------------------------------------------"<<std::endl;
+    std::cout<<"testing Weyl-basis spinor kernels........................."<<std::endl;
+    std::cout<<"----------------------------------------------------------"<<std::endl;
+
+    const std::size_t N=10000;
+    const value_type I(0,1);
+
+    std::cerr<<"Checking multiplication by the imaginary unit...........";
+    std::cerr.flush();
+    for(std::size_t n=0;n<N;++n)
+    {
+	value_type z=random_complex();
+	if(!close(Camgen::times_i(z),I*z) or !close(-Camgen::times_i(z),-I*z))
+	{
+	    std::cerr<<"times_i("<<z<<") = "<<Camgen::times_i(z)<<" differs from "<<I*z<<std::endl;
+	    return 1;
+	}
+    }
+    std::cerr<<"..........done."<<std::endl;
+
+    typedef Camgen::spinor_simd<value_type> kernels;
+    typedef Camgen::spinor_simd<value_type,false> scalar_kernels;
+    const std::size_t N_spinors=256;
+    std::vector<value_type>a(4*N_spinors),b(4*N_spinors),A(4*N_spinors),B(4*N_spinors);
+    for(std::size_t n=0;n<4*N_spinors;++n)
+    {
+	a[n]=random_complex();
+	b[n]=random_complex();
+	A[n]=random_complex();
+	B[n]=A[n];
+    }
+    value_type L=random_complex();
+    value_type R=random_complex();
+
+    std::cerr<<"Checking "<<(kernels::vectorised?"vectorised":"scalar")<<" kernels...........";
+    std::cerr.flush();
+    for(int k=0;k<5;++k)
+    {
+	for(std::size_t n=0;n<N_spinors;++n)
+	{
+	    run_kernel<kernels>(k,L,R,&a[4*n],&b[4*n],&A[4*n]);
+	    run_kernel<scalar_kernels>(k,L,R,&a[4*n],&b[4*n],&B[4*n]);
+	}
+	for(std::size_t n=0;n<4*N_spinors;++n)
+	{
+	    if(!close(A[n],B[n]))
+	    {
+		std::cerr<<"kernel "<<k<<", component "<<n<<": "<<A[n]<<" differs from "<<B[n]<<std::endl;
+		return 1;
+	    }
+	}
+    }
+    std::cerr<<"..........done."<<std::endl;
+
+    const std::size_t N_rep=2000;
+    for(int k=0;k<5;++k)
+    {
+	std::cerr<<"Timing kernel "<<k<<"............";
+	std::clock_t t0=std::clock();
+	for(std::size_t r=0;r<N_rep;++r)
+	{
+	    for(std::size_t n=0;n<N_spinors;++n)
+	    {
+		run_kernel<kernels>(k,L,R,&a[4*n],&b[4*n],&A[4*n]);
+	    }
+	}
+	std::clock_t t1=std::clock();
+	for(std::size_t r=0;r<N_rep;++r)
+	{
+	    for(std::size_t n=0;n<N_spinors;++n)
+	    {
+		run_kernel<scalar_kernels>(k,L,R,&a[4*n],&b[4*n],&B[4*n]);
+	    }
+	}
+	std::clock_t t2=std::clock();
+	std::cerr<<(double)(t1-t0)/CLOCKS_PER_SEC<<" s vs. "<<(double)(t2-t1)/CLOCKS_PER_SEC<<" s scalar"<<std::endl;
+    }
+
+    return 0;
+}
@@ -59,12 +59,12 @@ namespace Camgen
 		typedef typename CM_algorithm<model_type,2,N_out>::tree_iterator tree_iterator;
 		typedef typename model_type::value_type value_type;
 
-		static process_generator<model_type,2,N_out,std::random>* create_generator(tree_iterator it,const value_type& E)
+		static process_generator<model_type,2,N_out,std::random>* create_generator(tree_iterator it,const value_type& E,colour_generators::type col_gen=colour_generators::flow_sampling)
 		{
 		    set_initial_state_type(initial_states::partonic);
 		    set_phase_space_generator_type(phase_space_generators::uniform);
 		    set_helicity_generator_type(helicity_generators::uniform);
-		    set_colour_generator_type(colour_generators::flow_sampling);
+		    set_colour_generator_type(col_gen);
 		    set_beam_energy(1,0.5*E);
 		    set_beam_energy(2,0.5*E);
 		    uniform_process_generator_factory<model_type,2,N_out,std::random> factory;